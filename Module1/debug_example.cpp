@@ -3,20 +3,23 @@
 #include <iostream>
 #include <string>
 
+#include "perf/binlog.h"
+
 using std::cout;
 using std::endl;
 using std::string;
 
 int main() {
-  // Debug output to trace program execution
-  cout << "[DEBUG] Program started" << endl;
+  // Debug traces go to an in-memory binary log and are formatted to stderr at
+  // exit; CSC450_LOG_LEVEL=info silences them, -DCSC450_LOG_MIN_LEVEL=2 compiles them out
+  CSC450_LOG_DEBUG("Program started");
 
   string message = "Hello World..";
-  cout << "[DEBUG] Message variable created: " << message << endl;
+  CSC450_LOG_DEBUG("Message variable created: {}", message);
 
   cout << message << endl;
 
-  cout << "[DEBUG] Program ending" << endl;
+  CSC450_LOG_DEBUG("Program ending");
 
   return 0;
 }
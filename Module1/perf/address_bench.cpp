@@ -0,0 +1,299 @@
+/**
+ * Address ingestion throughput: getline + stringstream vs mmap + SIMD scan
+ *
+ * Writes --records synthetic addresses (the fictionalchar.cpp fields) as
+ * CSV or TSV, or reads --input, then loads the file
+ *   getline     std::ifstream, std::getline per line, std::getline on an
+ *               istringstream per field, std::set lookups for validation
+ *               (no quote support: quoted fields are split at inner commas)
+ *   ingest      csc450::address::ingestFile with 1, 2, 4, ... threads
+ * and reports records/sec and MB/s for each, plus the accepted/rejected
+ * counts. The generator plants quoted fields with delimiters, "" escapes
+ * and newlines, and a few bad states, zips and field counts, so the SIMD
+ * path is checked against the known answers at every thread count.
+ *
+ * Usage: address_bench [--records N] [--format csv|tsv] [--input FILE]
+ *                      [--threads N] [--repeat N] [--keep]
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "address_ingest.h"
+#include "bench_util.h"
+#include "record_gen.h"
+
+namespace {
+
+using csc450::address::IngestStats;
+
+struct Generated {
+  std::string text;
+  IngestStats expected;
+};
+
+void appendField(std::string& out, const std::string& text, char delimiter) {
+  if (text.find_first_of(std::string{delimiter, '"', '\n'}) == std::string::npos) {
+    out.append(text);
+    return;
+  }
+  out.push_back('"');
+  for (const char c : text) {
+    if (c == '"') {
+      out.push_back('"');
+    }
+    out.push_back(c);
+  }
+  out.push_back('"');
+}
+
+Generated generate(size_t records, char delimiter) {
+  static const char* const kFirst[] = {"John", "Maria", "Wei", "Aisha", "Carlos", "Olga", "Kenji", "Fatima", "Liam", "Priya", "Noah", "Sofia", "Bartholomew"};
+  static const char* const kLast[] = {"Doe", "Garcia", "Chen", "Okafor", "Silva", "Ivanova", "Tanaka", "Haddad", "Murphy", "Patel", "Kim", "O'Brien"};
+  static const char* const kStreets[] = {"Dead Elm St", "Maple Ave", "Lincoln Blvd", "Cedar Ln", "Route 66", "Old Mill Rd", "Lakeshore Dr"};
+  static const char* const kCities[] = {"Springfield", "Shelbyville", "Capital City", "Ogdenville", "North Haverbrook", "Brockway", "Cypress Creek"};
+  static const char* const kStates[] = {"IL", "CA", "NY", "TX", "WA", "FL", "OR", "MA", "DC", "PR"};
+
+  Generated g;
+  g.text.reserve(records * 64);
+  g.text.append(delimiter == '\t' ? "first_name\tlast_name\tstreet\tcity\tstate\tzip\n" : "first_name,last_name,street,city,state,zip\n");
+  const std::string sep(1, delimiter);
+  for (size_t i = 0; i < records; ++i) {
+    const uint64_t r = csc450::records::mix64(i + 7);
+    std::string street = std::to_string(1 + r % 9999) + ' ' + kStreets[(r >> 16) % std::size(kStreets)];
+    if ((r >> 24) % 8 == 0) {
+      street += std::string{delimiter} + " Apt " + std::to_string(1 + (r >> 28) % 40);  // needs quoting
+    } else if ((r >> 24) % 97 == 1) {
+      street += "\n(rear entrance)";
+    } else if ((r >> 24) % 89 == 2) {
+      street = "\"The Old Mill\" " + street;
+    }
+    char zip[8];
+    std::snprintf(zip, sizeof(zip), "%05u", static_cast<unsigned>((r >> 32) % 100000));
+    std::string state = kStates[(r >> 40) % std::size(kStates)];
+    std::string zip_text = zip;
+
+    const uint64_t fault = (r >> 48) % 200;
+    ++g.expected.records;
+    appendField(g.text, kFirst[r % std::size(kFirst)], delimiter);
+    g.text += sep;
+    appendField(g.text, kLast[(r >> 8) % std::size(kLast)], delimiter);
+    g.text += sep;
+    appendField(g.text, street, delimiter);
+    g.text += sep;
+    appendField(g.text, kCities[(r >> 20) % std::size(kCities)], delimiter);
+    if (fault == 0) {
+      ++g.expected.bad_field_count;  // city and state run together
+      g.text += sep + zip_text + '\n';
+      continue;
+    }
+    if (fault == 1) {
+      state = (r >> 56) % 2 == 0 ? "Il" : "ZZ";
+      ++g.expected.bad_state;
+    } else if (fault == 2) {
+      zip_text = (r >> 56) % 2 == 0 ? "6270" : "62A04";
+      ++g.expected.bad_zip;
+    } else {
+      ++g.expected.accepted;
+    }
+    g.text += sep + state + sep + zip_text + ((r >> 60) == 0 ? "\r\n" : "\n");
+  }
+  return g;
+}
+
+void writeFile(const std::filesystem::path& path, const std::string& text) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(text.data(), static_cast<std::streamsize>(text.size()));
+  if (!out) {
+    throw std::runtime_error("cannot write " + path.string());
+  }
+}
+
+// The straightforward version: one std::string per line and per field
+IngestStats getlineIngest(const std::filesystem::path& path, char delimiter, size_t& stored) {
+  static const std::set<std::string> kStateCodes = {"AL", "AK", "AZ", "AR", "CA", "CO", "CT", "DE", "FL", "GA", "HI", "ID", "IL", "IN", "IA", "KS", "KY", "LA", "ME",
+                                                    "MD", "MA", "MI", "MN", "MS", "MO", "MT", "NE", "NV", "NH", "NJ", "NM", "NY", "NC", "ND", "OH", "OK", "OR", "PA",
+                                                    "RI", "SC", "SD", "TN", "TX", "UT", "VT", "VA", "WA", "WV", "WI", "WY", "DC", "PR", "GU", "VI", "AS", "MP", "AA",
+                                                    "AE", "AP"};
+  struct Address {
+    std::string first, last, street, city, state, zip;
+  };
+  std::vector<Address> table;
+  IngestStats stats;
+  std::ifstream in(path);
+  std::string line;
+  std::getline(in, line);  // header
+  while (std::getline(in, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty()) {
+      continue;
+    }
+    ++stats.records;
+    std::istringstream fields(line);
+    std::vector<std::string> parts;
+    std::string part;
+    while (std::getline(fields, part, delimiter)) {
+      parts.push_back(part);
+    }
+    if (parts.size() != 6) {
+      ++stats.bad_field_count;
+    } else if (kStateCodes.count(parts[4]) == 0) {
+      ++stats.bad_state;
+    } else if (parts[5].size() != 5 || !std::all_of(parts[5].begin(), parts[5].end(), [](char c) { return c >= '0' && c <= '9'; })) {
+      ++stats.bad_zip;
+    } else {
+      table.push_back(Address{parts[0], parts[1], parts[2], parts[3], parts[4], parts[5]});
+      ++stats.accepted;
+    }
+  }
+  stored = table.size();
+  return stats;
+}
+
+void writeStats(csc450::bench::JsonWriter& json, const IngestStats& s) {
+  json.field("records", s.records);
+  json.field("accepted", s.accepted);
+  json.field("bad_field_count", s.bad_field_count);
+  json.field("bad_state", s.bad_state);
+  json.field("bad_zip", s.bad_zip);
+}
+
+bool sameStats(const IngestStats& a, const IngestStats& b) {
+  return a.records == b.records && a.accepted == b.accepted && a.bad_field_count == b.bad_field_count && a.bad_state == b.bad_state && a.bad_zip == b.bad_zip;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    size_t records = 2000000;
+    std::string format = "csv";
+    std::string input;
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    int repeat = 3;
+    bool keep = false;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--records" && i + 1 < argc) {
+        records = std::strtoull(argv[++i], nullptr, 10);
+      } else if (arg == "--format" && i + 1 < argc && (std::string(argv[i + 1]) == "csv" || std::string(argv[i + 1]) == "tsv")) {
+        format = argv[++i];
+      } else if (arg == "--input" && i + 1 < argc) {
+        input = argv[++i];
+      } else if (arg == "--threads" && i + 1 < argc) {
+        max_threads = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+      } else if (arg == "--repeat" && i + 1 < argc) {
+        repeat = std::max(1, std::atoi(argv[++i]));
+      } else if (arg == "--keep") {
+        keep = true;
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--records N] [--format csv|tsv] [--input FILE] [--threads N] [--repeat N] [--keep]\n";
+        return EXIT_FAILURE;
+      }
+    }
+    const char delimiter = format == "tsv" ? '\t' : ',';
+
+    std::filesystem::path path = input;
+    bool known = false;
+    IngestStats expected;
+    if (input.empty()) {
+      const Generated g = generate(records, delimiter);
+      expected = g.expected;
+      known = true;
+      path = std::filesystem::temp_directory_path() / ("address_bench." + format);
+      writeFile(path, g.text);
+    }
+    const double megabytes = static_cast<double>(std::filesystem::file_size(path)) / 1e6;
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "address_ingest");
+    json.field("file", path.string());
+    json.field("format", format);
+    json.field("megabytes", megabytes);
+    if (known) {
+      json.key("expected").beginObject();
+      writeStats(json, expected);
+      json.endObject();
+    }
+
+    bool all_match = true;
+    const auto best = [&](auto&& run) {
+      double seconds = 1e300;
+      for (int r = 0; r < repeat; ++r) {
+        const auto start = csc450::bench::Clock::now();
+        run();
+        seconds = std::min(seconds, csc450::bench::secondsSince(start));
+      }
+      return seconds;
+    };
+    const auto writeRun = [&](const char* method, size_t threads, double seconds, const IngestStats& stats, size_t stored, bool checked) {
+      json.beginObject();
+      json.field("method", method);
+      json.field("threads", threads);
+      json.field("ms", seconds * 1e3);
+      json.field("records_per_sec", static_cast<double>(stats.records) / seconds);
+      json.field("mb_per_sec", megabytes / seconds);
+      writeStats(json, stats);
+      json.field("stored", stored);
+      if (checked) {
+        const bool match = sameStats(stats, expected) && stored == expected.accepted;
+        all_match = all_match && match;
+        json.field("matches_expected", match);
+      } else {
+        json.key("matches_expected").null();
+      }
+      json.endObject();
+    };
+
+    json.key("runs").beginArray();
+    {
+      IngestStats stats;
+      size_t stored = 0;
+      const double seconds = best([&] { stats = getlineIngest(path, delimiter, stored); });
+      writeRun("getline", 1, seconds, stats, stored, false);  // splits quoted fields, so it cannot match
+    }
+    IngestStats first_stats;
+    for (size_t threads = 1;; threads = std::min(threads * 2, max_threads)) {
+      csc450::address::IngestResult result;
+      const double seconds = best([&] { result = csc450::address::ingestFile(path.string(), delimiter, threads); });
+      csc450::bench::doNotOptimize(result.table.zips().data());
+      if (threads == 1) {
+        first_stats = result.stats;
+      }
+      if (!known) {
+        expected = first_stats;  // every thread count must agree with the serial pass
+      }
+      writeRun("ingest", threads, seconds, result.stats, result.table.size(), true);
+      if (threads == max_threads) {
+        break;
+      }
+    }
+    json.endArray();
+    json.field("all_match", all_match);
+    json.endObject();
+    std::cout << '\n';
+
+    if (known && !keep) {
+      std::filesystem::remove(path);
+    }
+    return all_match ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "address_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
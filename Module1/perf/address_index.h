@@ -0,0 +1,280 @@
+/**
+ * Lookup indexes over an AddressTable: by state, zip and city
+ *
+ * HashIndex is an open-addressing (linear probing) multi-map from a compact
+ * key to the rows that carry it. Keys are stored as the table stores them:
+ * the packed uint16_t state, the uint32_t zip, or a string_view of the city
+ * in the table's arena. Each distinct key owns one contiguous run of row
+ * numbers (CSR layout: offsets + rows), so a lookup is one probe sequence
+ * and returns a span, with no per-key allocation.
+ *
+ * SortedZipIndex sorts (zip, row) pairs with an LSD radix sort (8-bit
+ * digits, passes above the largest key skipped) and keeps the rows in zip
+ * order plus the distinct zips with their run offsets. It answers exact
+ * lookups by binary search over the distinct zips and, unlike a hash, zip
+ * ranges.
+ *
+ * Row numbers are uint32_t; building an index over more than 4G rows is
+ * rejected (INT30-C). City keys view the table's strings, so the table must
+ * outlive a city index and not be appended to meanwhile.
+ */
+
+#ifndef CSC450_MODULE1_PERF_ADDRESS_INDEX_H_
+#define CSC450_MODULE1_PERF_ADDRESS_INDEX_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "address_ingest.h"
+
+namespace csc450::address {
+
+struct IntegerHash {
+  uint64_t operator()(uint64_t key) const noexcept {
+    return key;  // scrambled by the Fibonacci step in the table
+  }
+};
+
+// FNV-1a
+struct StringHash {
+  uint64_t operator()(std::string_view key) const noexcept {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (const char c : key) {
+      h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+    return h;
+  }
+};
+
+namespace detail {
+
+inline void checkRowCount(size_t rows) {
+  if (rows > std::numeric_limits<uint32_t>::max()) {
+    throw std::length_error("index limited to 2^32 - 1 rows");
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Open-addressing multi-map: key -> rows
+ */
+template <typename Key, typename Hash = IntegerHash>
+class HashIndex {
+ public:
+  /**
+   * Indexes rows [0, rows) by key_of(row)
+   */
+  template <typename KeyOf>
+  HashIndex(size_t rows, KeyOf&& key_of) {
+    detail::checkRowCount(rows);
+    rehash(16);
+    std::vector<uint32_t> group_of_row(rows);
+    std::vector<uint32_t> counts;
+    for (size_t row = 0; row < rows; ++row) {
+      const uint32_t group = findOrInsert(key_of(row), counts);
+      group_of_row[row] = group;
+      ++counts[group];
+    }
+
+    offsets_.assign(counts.size() + 1, 0);
+    for (size_t g = 0; g < counts.size(); ++g) {
+      offsets_[g + 1] = offsets_[g] + counts[g];
+    }
+    std::vector<uint32_t> cursor(offsets_.begin(), offsets_.end() - 1);
+    rows_.resize(rows);
+    for (size_t row = 0; row < rows; ++row) {
+      rows_[cursor[group_of_row[row]]++] = static_cast<uint32_t>(row);
+    }
+  }
+
+  /**
+   * Rows with this key, ascending; empty if none
+   */
+  [[nodiscard]] std::span<const uint32_t> find(const Key& key) const noexcept {
+    for (size_t i = slotFor(key);; i = (i + 1) & mask_) {
+      const Slot& slot = slots_[i];
+      if (slot.group == kEmpty) {
+        return {};
+      }
+      if (slot.key == key) {
+        return std::span<const uint32_t>(rows_.data() + offsets_[slot.group], offsets_[slot.group + 1] - offsets_[slot.group]);
+      }
+    }
+  }
+
+  [[nodiscard]] size_t keys() const noexcept {
+    return offsets_.size() - 1;
+  }
+
+  [[nodiscard]] size_t bytes() const noexcept {
+    return slots_.capacity() * sizeof(Slot) + (offsets_.capacity() + rows_.capacity()) * sizeof(uint32_t);
+  }
+
+ private:
+  struct Slot {
+    Key key{};
+    uint32_t group = kEmpty;
+  };
+  static constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+
+  // Fibonacci hashing: the top bits of hash * 2^64/phi
+  [[nodiscard]] size_t slotFor(const Key& key) const noexcept {
+    return static_cast<size_t>((Hash{}(key) * 0x9E3779B97F4A7C15ull) >> shift_);
+  }
+
+  uint32_t findOrInsert(const Key& key, std::vector<uint32_t>& counts) {
+    for (size_t i = slotFor(key);; i = (i + 1) & mask_) {
+      Slot& slot = slots_[i];
+      if (slot.group == kEmpty) {
+        slot = Slot{key, static_cast<uint32_t>(counts.size())};
+        counts.push_back(0);
+        if (counts.size() * 2 > slots_.size()) {
+          rehash(slots_.size() * 2);  // keep the load factor at or below 1/2
+        }
+        return static_cast<uint32_t>(counts.size() - 1);
+      }
+      if (slot.key == key) {
+        return slot.group;
+      }
+    }
+  }
+
+  void rehash(size_t capacity) {
+    std::vector<Slot> old(capacity);
+    old.swap(slots_);
+    mask_ = capacity - 1;
+    shift_ = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) {
+      --shift_;
+    }
+    for (const Slot& slot : old) {
+      if (slot.group != kEmpty) {
+        size_t i = slotFor(slot.key);
+        while (slots_[i].group != kEmpty) {
+          i = (i + 1) & mask_;
+        }
+        slots_[i] = slot;
+      }
+    }
+  }
+
+  std::vector<Slot> slots_;
+  size_t mask_ = 0;
+  int shift_ = 64;
+  std::vector<uint32_t> offsets_;  // group g owns rows_[offsets_[g], offsets_[g + 1])
+  std::vector<uint32_t> rows_;
+};
+
+using StateIndex = HashIndex<uint16_t>;
+using ZipHashIndex = HashIndex<uint32_t>;
+using CityIndex = HashIndex<std::string_view, StringHash>;
+
+inline StateIndex buildStateIndex(const AddressTable& table) {
+  const auto& states = table.stateCodes();
+  return StateIndex(table.size(), [&](size_t row) { return states[row]; });
+}
+
+inline ZipHashIndex buildZipHashIndex(const AddressTable& table) {
+  const auto& zips = table.zips();
+  return ZipHashIndex(table.size(), [&](size_t row) { return zips[row]; });
+}
+
+inline CityIndex buildCityIndex(const AddressTable& table) {
+  return CityIndex(table.size(), [&](size_t row) { return table.city(row); });
+}
+
+/**
+ * Stable LSD radix sort of keys, carrying rows along (8-bit digits)
+ */
+inline void radixSortByKey(std::vector<uint32_t>& keys, std::vector<uint32_t>& rows) {
+  const size_t n = keys.size();
+  std::vector<uint32_t> key_scratch(n);
+  std::vector<uint32_t> row_scratch(n);
+  const uint32_t max_key = n == 0 ? 0 : *std::max_element(keys.begin(), keys.end());
+  for (int shift = 0; shift < 32 && (max_key >> shift) != 0; shift += 8) {
+    size_t counts[256] = {};
+    for (const uint32_t key : keys) {
+      ++counts[(key >> shift) & 0xFF];
+    }
+    if (std::find(std::begin(counts), std::end(counts), n) != std::end(counts)) {
+      continue;  // every key has the same digit here
+    }
+    size_t sum = 0;
+    for (size_t& count : counts) {
+      const size_t c = count;
+      count = sum;
+      sum += c;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      const size_t at = counts[(keys[i] >> shift) & 0xFF]++;
+      key_scratch[at] = keys[i];
+      row_scratch[at] = rows[i];
+    }
+    keys.swap(key_scratch);
+    rows.swap(row_scratch);
+  }
+}
+
+/**
+ * Zip codes in sorted order with their rows
+ */
+class SortedZipIndex {
+ public:
+  explicit SortedZipIndex(const AddressTable& table) : rows_(table.size()) {
+    detail::checkRowCount(rows_.size());
+    std::vector<uint32_t> zips(table.zips());
+    for (size_t row = 0; row < rows_.size(); ++row) {
+      rows_[row] = static_cast<uint32_t>(row);
+    }
+    radixSortByKey(zips, rows_);
+
+    // Distinct zips with the start of their run, so searches stay small
+    for (size_t i = 0; i < zips.size(); ++i) {
+      if (i == 0 || zips[i] != zips[i - 1]) {
+        keys_.push_back(zips[i]);
+        offsets_.push_back(static_cast<uint32_t>(i));
+      }
+    }
+    offsets_.push_back(static_cast<uint32_t>(zips.size()));
+  }
+
+  /**
+   * Rows with this zip, ascending
+   */
+  [[nodiscard]] std::span<const uint32_t> find(uint32_t zip) const noexcept {
+    return range(zip, zip);
+  }
+
+  /**
+   * Rows with first <= zip <= last, in zip order
+   */
+  [[nodiscard]] std::span<const uint32_t> range(uint32_t first, uint32_t last) const noexcept {
+    const size_t begin = static_cast<size_t>(std::lower_bound(keys_.begin(), keys_.end(), first) - keys_.begin());
+    const size_t end = static_cast<size_t>(std::upper_bound(keys_.begin() + static_cast<std::ptrdiff_t>(begin), keys_.end(), last) - keys_.begin());
+    return std::span<const uint32_t>(rows_.data() + offsets_[begin], offsets_[end] - offsets_[begin]);
+  }
+
+  [[nodiscard]] size_t keys() const noexcept {
+    return keys_.size();
+  }
+
+  [[nodiscard]] size_t bytes() const noexcept {
+    return (keys_.capacity() + offsets_.capacity() + rows_.capacity()) * sizeof(uint32_t);
+  }
+
+ private:
+  std::vector<uint32_t> keys_;     // distinct zips, ascending
+  std::vector<uint32_t> offsets_;  // keys_[k] owns rows_[offsets_[k], offsets_[k + 1])
+  std::vector<uint32_t> rows_;
+};
+
+}  // namespace csc450::address
+
+#endif  // CSC450_MODULE1_PERF_ADDRESS_INDEX_H_
@@ -0,0 +1,221 @@
+/**
+ * Address lookup indexes vs std::unordered_map<std::string, std::vector>
+ *
+ * Builds an AddressTable of --records synthetic addresses (59 USPS codes,
+ * random zips, a few thousand cities), then for each key (state, zip, city):
+ *   unordered_map   std::unordered_map<std::string, std::vector<uint32_t>>,
+ *                   queried with std::string keys (zips as "62704")
+ *   hash_index      csc450::address::HashIndex on the compact key
+ *   sorted_index    SortedZipIndex (zip only; radix-sort build)
+ * reporting build time, index bytes and ns per lookup over a fixed mix of
+ * present and absent keys. Every lookup method must find the same rows.
+ *
+ * Usage: address_index_bench [--records N] [--queries N] [--min-time SECONDS]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "address_index.h"
+#include "bench_util.h"
+#include "record_gen.h"
+
+namespace {
+
+using csc450::address::AddressTable;
+using StringMap = std::unordered_map<std::string, std::vector<uint32_t>>;
+
+constexpr const char* kStateCodes[] = {"AL", "AK", "AZ", "AR", "CA", "CO", "CT", "DE", "FL", "GA", "HI", "ID", "IL", "IN", "IA", "KS", "KY", "LA", "ME", "MD",
+                                       "MA", "MI", "MN", "MS", "MO", "MT", "NE", "NV", "NH", "NJ", "NM", "NY", "NC", "ND", "OH", "OK", "OR", "PA", "RI", "SC",
+                                       "SD", "TN", "TX", "UT", "VT", "VA", "WA", "WV", "WI", "WY", "DC", "PR", "GU", "VI", "AS", "MP", "AA", "AE", "AP"};
+
+std::string cityName(uint64_t n) {
+  static const char* const kStems[] = {"Springfield", "Shelbyville", "Capital City", "Ogdenville", "North Haverbrook", "Brockway", "Cypress Creek", "Riverton"};
+  return std::string(kStems[n % std::size(kStems)]) + ' ' + std::to_string(n / std::size(kStems));
+}
+
+AddressTable makeTable(size_t records, size_t cities) {
+  AddressTable table;
+  table.reserve(records, records * 40);
+  for (size_t i = 0; i < records; ++i) {
+    const uint64_t r = csc450::records::mix64(i + 11);
+    const char* state = kStateCodes[r % std::size(kStateCodes)];
+    const std::string street = std::to_string(1 + (r >> 8) % 9999) + " Dead Elm St";
+    table.append("John", "Doe", street, cityName((r >> 24) % cities), csc450::address::packState(state[0], state[1]),
+                 static_cast<uint32_t>((r >> 40) % 100000));
+  }
+  return table;
+}
+
+std::string zipText(uint32_t zip) {
+  char text[8];
+  std::snprintf(text, sizeof(text), "%05u", static_cast<unsigned>(zip));
+  return text;
+}
+
+size_t mapBytes(const StringMap& map) {
+  const size_t inline_capacity = std::string().capacity();
+  size_t bytes = map.bucket_count() * sizeof(void*);
+  for (const auto& [key, rows] : map) {
+    bytes += sizeof(void*) + sizeof(size_t) + sizeof(StringMap::value_type);  // node: next, cached hash, value
+    bytes += key.capacity() > inline_capacity ? key.capacity() + 1 : 0;
+    bytes += rows.capacity() * sizeof(uint32_t);
+  }
+  return bytes;
+}
+
+struct Result {
+  const char* key;
+  const char* method;
+  double build_ms;
+  size_t bytes;
+  double lookup_ns;
+  uint64_t rows_found;
+};
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    size_t records = 2000000;
+    size_t query_count = 1 << 16;
+    double min_time = 0.1;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--records" && i + 1 < argc) {
+        records = std::strtoull(argv[++i], nullptr, 10);
+      } else if (arg == "--queries" && i + 1 < argc) {
+        query_count = std::strtoull(argv[++i], nullptr, 10);
+      } else if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--records N] [--queries N] [--min-time SECONDS]\n";
+        return EXIT_FAILURE;
+      }
+    }
+    records = std::max<size_t>(records, 1);
+    query_count = std::max<size_t>(query_count, 1);
+    const size_t cities = std::max<size_t>(8, records / 500);
+    const AddressTable table = makeTable(records, cities);
+
+    // One in eight queries misses: unknown zip, unused state code, unknown city
+    std::vector<uint16_t> state_queries(query_count);
+    std::vector<uint32_t> zip_queries(query_count);
+    std::vector<std::string> city_queries(query_count);
+    for (size_t q = 0; q < query_count; ++q) {
+      const uint64_t r = csc450::records::mix64(q ^ 0xfeed);
+      const size_t row = r % records;
+      const bool miss = (r >> 40) % 8 == 0;
+      state_queries[q] = miss ? csc450::address::packState('Z', 'Z') : table.stateCodes()[row];
+      zip_queries[q] = miss ? 100000 + static_cast<uint32_t>(q) : table.zips()[row];
+      city_queries[q] = miss ? "Atlantis" : std::string(table.city(row));
+    }
+    std::vector<std::string> state_text(query_count);
+    std::vector<std::string> zip_text(query_count);
+    for (size_t q = 0; q < query_count; ++q) {
+      state_text[q] = {static_cast<char>(state_queries[q] & 0xFF), static_cast<char>(state_queries[q] >> 8)};
+      zip_text[q] = zipText(zip_queries[q]);
+    }
+
+    std::vector<Result> results;
+    const auto timeLookups = [&](auto&& lookup) {
+      uint64_t found = 0;
+      for (size_t q = 0; q < query_count; ++q) {
+        found += lookup(q);
+      }
+      size_t q = 0;
+      const double ns = csc450::bench::nsPerOp(
+          [&] {
+            csc450::bench::doNotOptimize(lookup(q));
+            q = q + 1 == query_count ? 0 : q + 1;
+          },
+          min_time);
+      return std::make_pair(ns, found);
+    };
+    const auto timeBuild = [](auto&& build) {
+      const auto start = csc450::bench::Clock::now();
+      auto index = build();
+      return std::make_pair(std::move(index), csc450::bench::secondsSince(start) * 1e3);
+    };
+    const auto addMap = [&](const char* key, auto&& key_text, const std::vector<std::string>& queries) {
+      auto [map, build_ms] = timeBuild([&] {
+        StringMap m;
+        for (size_t row = 0; row < table.size(); ++row) {
+          m[key_text(row)].push_back(static_cast<uint32_t>(row));
+        }
+        return m;
+      });
+      const auto [ns, found] = timeLookups([&, &m = map](size_t q) {
+        const auto it = m.find(queries[q]);
+        return it == m.end() ? size_t{0} : it->second.size();
+      });
+      results.push_back(Result{key, "unordered_map", build_ms, mapBytes(map), ns, found});
+    };
+    const auto addIndex = [&](const char* key, const char* method, auto&& build, const auto& queries) {
+      auto [index, build_ms] = timeBuild(build);
+      const auto [ns, found] = timeLookups([&, &idx = index](size_t q) { return idx.find(queries[q]).size(); });
+      results.push_back(Result{key, method, build_ms, index.bytes(), ns, found});
+    };
+
+    addMap("state", [&](size_t row) { return table.state(row); }, state_text);
+    addIndex("state", "hash_index", [&] { return csc450::address::buildStateIndex(table); }, state_queries);
+    addMap("zip", [&](size_t row) { return zipText(table.zips()[row]); }, zip_text);
+    addIndex("zip", "hash_index", [&] { return csc450::address::buildZipHashIndex(table); }, zip_queries);
+    addIndex("zip", "sorted_index", [&] { return csc450::address::SortedZipIndex(table); }, zip_queries);
+    addMap("city", [&](size_t row) { return std::string(table.city(row)); }, city_queries);
+    std::vector<std::string_view> city_views(city_queries.begin(), city_queries.end());
+    addIndex("city", "hash_index", [&] { return csc450::address::buildCityIndex(table); }, city_views);
+
+    // Zip range query, which only the sorted index answers directly
+    const csc450::address::SortedZipIndex sorted(table);
+    size_t in_range = 0;
+    for (const uint32_t zip : table.zips()) {
+      in_range += zip >= 60000 && zip <= 62999 ? 1 : 0;
+    }
+    const double range_ns = csc450::bench::nsPerOp([&] { csc450::bench::doNotOptimize(sorted.range(60000, 62999).size()); }, min_time);
+
+    bool match = sorted.range(60000, 62999).size() == in_range;
+    for (const Result& r : results) {
+      for (const Result& other : results) {
+        match = match && (std::string(r.key) != other.key || r.rows_found == other.rows_found);
+      }
+    }
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "address_index");
+    json.field("records", records);
+    json.field("cities", cities);
+    json.field("queries", query_count);
+    json.field("results_match", match);
+    json.key("lookups").beginArray();
+    for (const Result& r : results) {
+      json.beginObject();
+      json.field("key", r.key);
+      json.field("method", r.method);
+      json.field("build_ms", r.build_ms);
+      json.field("bytes", r.bytes);
+      json.field("lookup_ns", r.lookup_ns);
+      json.field("rows_found", r.rows_found);
+      json.endObject();
+    }
+    json.endArray();
+    json.key("zip_range_60000_62999").beginObject();
+    json.field("rows", in_range);
+    json.field("sorted_index_ns", range_ns);
+    json.endObject();
+    json.endObject();
+    std::cout << '\n';
+    return match ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "address_index_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,623 @@
+/**
+ * Bulk CSV/TSV ingestion of address records
+ *
+ * fictionalchar.cpp prints one hard-coded address (first name, last name,
+ * street, city, state, zip). This engine loads millions of them from a
+ * delimited file into a columnar AddressTable: four strings in a shared
+ * StringArena, the state packed into a uint16_t and the zip into a
+ * uint32_t.
+ *
+ * Parsing works on 64-byte blocks. One pass builds bitmasks of quotes,
+ * delimiters and newlines (AVX2 or SSE2 compares and movemask, chosen at
+ * run time; a scalar loop elsewhere), a prefix XOR over the quote mask marks
+ * the bytes inside quoted fields, and only delimiters and newlines outside
+ * quotes are visited, one set bit at a time. Quoted fields may contain
+ * delimiters, newlines and "" escapes (RFC 4180).
+ *
+ * Validation is branch-light SWAR, eight bytes per register: a zip must be
+ * exactly five ASCII digits and a state two upper-case letters that name a
+ * USPS state, district, territory or military code (a 26x26 bitmap).
+ * Records that fail are counted by reason and skipped, never stored
+ * half-validated (STR50-CPP / INT31-C spirit).
+ *
+ * Parallel ingestion splits the file into equal byte ranges. A record
+ * boundary is a newline outside quotes, so each range first learns whether
+ * it starts inside a quoted field from a prefix of per-range quote counts,
+ * then re-synchronizes at its first real boundary. Every record is parsed
+ * by exactly one thread, and the tables are concatenated in file order.
+ */
+
+#ifndef CSC450_MODULE1_PERF_ADDRESS_INGEST_H_
+#define CSC450_MODULE1_PERF_ADDRESS_INGEST_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "record_store.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CSC450_ADDRESS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace csc450::address {
+
+using records::StringArena;
+using records::StringRef;
+
+/**
+ * Two upper-case ASCII letters packed little-endian ("IL" -> 'I' | 'L' << 8)
+ */
+constexpr uint16_t packState(char first, char second) noexcept {
+  return static_cast<uint16_t>(static_cast<unsigned char>(first) | static_cast<unsigned char>(second) << 8);
+}
+
+/**
+ * Columnar address storage
+ */
+class AddressTable {
+ public:
+  void reserve(size_t records, size_t string_bytes = 0) {
+    first_.reserve(records);
+    last_.reserve(records);
+    street_.reserve(records);
+    city_.reserve(records);
+    state_.reserve(records);
+    zip_.reserve(records);
+    strings_.reserve(string_bytes);
+  }
+
+  void append(std::string_view first, std::string_view last, std::string_view street, std::string_view city, uint16_t state, uint32_t zip) {
+    first_.push_back(strings_.add(first));
+    last_.push_back(strings_.add(last));
+    street_.push_back(strings_.add(street));
+    city_.push_back(strings_.add(city));
+    state_.push_back(state);
+    zip_.push_back(zip);
+  }
+
+  /**
+   * Appends every record of another table, in order: one copy of its string
+   * bytes, then its references shifted past ours
+   */
+  void appendTable(const AddressTable& other) {
+    const uint32_t base = strings_.add(std::string_view(other.strings_.data(), other.strings_.size())).offset;
+    const auto rebase = [base](std::vector<StringRef>& to, const std::vector<StringRef>& from) {
+      to.reserve(to.size() + from.size());
+      for (const StringRef ref : from) {
+        to.push_back(StringRef{ref.offset + base, ref.length});
+      }
+    };
+    rebase(first_, other.first_);
+    rebase(last_, other.last_);
+    rebase(street_, other.street_);
+    rebase(city_, other.city_);
+    state_.insert(state_.end(), other.state_.begin(), other.state_.end());
+    zip_.insert(zip_.end(), other.zip_.begin(), other.zip_.end());
+  }
+
+  [[nodiscard]] size_t size() const noexcept {
+    return zip_.size();
+  }
+
+  [[nodiscard]] std::string_view firstName(size_t i) const noexcept {
+    return strings_.view(first_[i]);
+  }
+  [[nodiscard]] std::string_view lastName(size_t i) const noexcept {
+    return strings_.view(last_[i]);
+  }
+  [[nodiscard]] std::string_view street(size_t i) const noexcept {
+    return strings_.view(street_[i]);
+  }
+  [[nodiscard]] std::string_view city(size_t i) const noexcept {
+    return strings_.view(city_[i]);
+  }
+  [[nodiscard]] std::string state(size_t i) const {
+    return std::string{static_cast<char>(state_[i] & 0xFF), static_cast<char>(state_[i] >> 8)};
+  }
+
+  [[nodiscard]] const std::vector<uint16_t>& stateCodes() const noexcept {
+    return state_;
+  }
+  [[nodiscard]] const std::vector<uint32_t>& zips() const noexcept {
+    return zip_;
+  }
+  [[nodiscard]] const std::vector<StringRef>& cityRefs() const noexcept {
+    return city_;
+  }
+  [[nodiscard]] const StringArena& strings() const noexcept {
+    return strings_;
+  }
+
+ private:
+  std::vector<StringRef> first_;
+  std::vector<StringRef> last_;
+  std::vector<StringRef> street_;
+  std::vector<StringRef> city_;
+  std::vector<uint16_t> state_;
+  std::vector<uint32_t> zip_;
+  StringArena strings_;
+};
+
+struct IngestStats {
+  size_t records = 0;  // data lines seen (header excluded)
+  size_t accepted = 0;
+  size_t bad_field_count = 0;
+  size_t bad_state = 0;
+  size_t bad_zip = 0;
+
+  IngestStats& operator+=(const IngestStats& other) noexcept {
+    records += other.records;
+    accepted += other.accepted;
+    bad_field_count += other.bad_field_count;
+    bad_state += other.bad_state;
+    bad_zip += other.bad_zip;
+    return *this;
+  }
+};
+
+struct IngestResult {
+  AddressTable table;
+  IngestStats stats;
+};
+
+namespace detail {
+
+// ---- validation -----------------------------------------------------------
+
+/**
+ * 26x26 bitmap of valid USPS codes, indexed (first - 'A') * 26 + (second - 'A')
+ */
+struct StateSet {
+  uint64_t bits[11] = {};
+
+  constexpr StateSet() {
+    constexpr const char* kCodes =
+        "AL AK AZ AR CA CO CT DE FL GA HI ID IL IN IA KS KY LA ME MD MA MI MN MS MO MT NE NV NH NJ NM NY NC ND OH OK OR PA RI SC SD TN TX UT VT VA WA WV WI WY "
+        "DC PR GU VI AS MP AA AE AP";
+    for (const char* p = kCodes; *p != '\0'; p += 3) {
+      const int index = (p[0] - 'A') * 26 + (p[1] - 'A');
+      bits[index / 64] |= uint64_t{1} << (index % 64);
+      if (p[2] == '\0') {
+        break;
+      }
+    }
+  }
+
+  [[nodiscard]] constexpr bool contains(int index) const noexcept {
+    return ((bits[index / 64] >> (index % 64)) & 1) != 0;
+  }
+};
+
+inline constexpr StateSet kStates{};
+
+inline uint64_t loadPadded(std::string_view field, char pad) noexcept {
+  char bytes[8];
+  std::memset(bytes, pad, sizeof(bytes));
+  std::memcpy(bytes, field.data(), std::min<size_t>(field.size(), 8));
+  uint64_t word;
+  std::memcpy(&word, bytes, sizeof(word));
+  return word;
+}
+
+// All eight bytes are ASCII digits (high nibble 3, and adding 6 keeps it 3)
+inline bool allDigits(uint64_t word) noexcept {
+  constexpr uint64_t kHigh = 0xF0F0F0F0F0F0F0F0ull;
+  constexpr uint64_t kThree = 0x3030303030303030ull;
+  return (word & kHigh) == kThree && ((word + 0x0606060606060606ull) & kHigh) == kThree;
+}
+
+// All eight bytes in 'A'..'Z' (no byte is >= 0x80, so per-byte adds never carry)
+inline bool allUpper(uint64_t word) noexcept {
+  constexpr uint64_t kHighBits = 0x8080808080808080ull;
+  const uint64_t at_least_a = word + 0x3F3F3F3F3F3F3F3Full;  // high bit set iff byte >= 'A'
+  const uint64_t above_z = word + 0x2525252525252525ull;     // high bit set iff byte > 'Z'
+  return ((word | ~at_least_a | above_z) & kHighBits) == 0;
+}
+
+inline bool parseZip(std::string_view field, uint32_t& zip) noexcept {
+  if (field.size() != 5 || !allDigits(loadPadded(field, '0'))) {
+    return false;
+  }
+  zip = static_cast<uint32_t>((field[0] - '0') * 10000 + (field[1] - '0') * 1000 + (field[2] - '0') * 100 + (field[3] - '0') * 10 + (field[4] - '0'));
+  return true;
+}
+
+inline bool parseState(std::string_view field, uint16_t& state) noexcept {
+  if (field.size() != 2 || !allUpper(loadPadded(field, 'A'))) {
+    return false;
+  }
+  if (!kStates.contains((field[0] - 'A') * 26 + (field[1] - 'A'))) {
+    return false;
+  }
+  state = packState(field[0], field[1]);
+  return true;
+}
+
+// ---- structural scan ------------------------------------------------------
+
+struct BlockMasks {
+  uint64_t quote;
+  uint64_t delimiter;
+  uint64_t newline;
+};
+
+inline BlockMasks classifyScalar(const char* block, char delimiter) noexcept {
+  BlockMasks m{0, 0, 0};
+  for (int i = 0; i < 64; ++i) {
+    const uint64_t bit = uint64_t{1} << i;
+    m.quote |= block[i] == '"' ? bit : 0;
+    m.delimiter |= block[i] == delimiter ? bit : 0;
+    m.newline |= block[i] == '\n' ? bit : 0;
+  }
+  return m;
+}
+
+inline uint64_t countQuotesScalar(const char* data, size_t n) noexcept {
+  uint64_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+    count += data[i] == '"' ? 1 : 0;
+  }
+  return count;
+}
+
+#if defined(CSC450_ADDRESS_X86)
+
+inline BlockMasks classifySse2(const char* block, char delimiter) noexcept {
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i delim = _mm_set1_epi8(delimiter);
+  const __m128i newline = _mm_set1_epi8('\n');
+  BlockMasks m{0, 0, 0};
+  for (int i = 0; i < 4; ++i) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+    const int shift = 16 * i;
+    m.quote |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)))) << shift;
+    m.delimiter |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, delim)))) << shift;
+    m.newline |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)))) << shift;
+  }
+  return m;
+}
+
+inline uint64_t countQuotesSse2(const char* data, size_t n) noexcept {
+  const __m128i quote = _mm_set1_epi8('"');
+  uint64_t count = 0;
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    count += static_cast<uint64_t>(__builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)))));
+  }
+  return count + countQuotesScalar(data + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline BlockMasks classifyAvx2(const char* block, char delimiter) noexcept {
+  const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+  const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+  uint64_t masks[3];
+  const char targets[3] = {'"', delimiter, '\n'};
+  for (int i = 0; i < 3; ++i) {
+    const __m256i c = _mm256_set1_epi8(targets[i]);
+    masks[i] = static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, c)))) |
+               static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, c)))) << 32;
+  }
+  return BlockMasks{masks[0], masks[1], masks[2]};
+}
+
+__attribute__((target("avx2,popcnt"))) inline uint64_t countQuotesAvx2(const char* data, size_t n) noexcept {
+  const __m256i quote = _mm256_set1_epi8('"');
+  uint64_t count = 0;
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    count += static_cast<uint64_t>(__builtin_popcount(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, quote)))));
+  }
+  return count + countQuotesSse2(data + i, n - i);
+}
+
+#endif  // CSC450_ADDRESS_X86
+
+struct Kernels {
+  BlockMasks (*classify)(const char*, char) noexcept;
+  uint64_t (*count_quotes)(const char*, size_t) noexcept;
+};
+
+inline Kernels selectKernels() {
+#if defined(CSC450_ADDRESS_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Kernels{classifyAvx2, countQuotesAvx2};
+  }
+  return Kernels{classifySse2, countQuotesSse2};
+#else
+  return Kernels{classifyScalar, countQuotesScalar};
+#endif
+}
+
+inline const Kernels& kernels() {
+  static const Kernels kSelected = selectKernels();
+  return kSelected;
+}
+
+// Bit i set iff an odd number of bits at positions <= i are set
+inline uint64_t prefixXor(uint64_t x) noexcept {
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+// Strips surrounding quotes and undoes "" escapes (into scratch if needed)
+inline std::string_view unquote(std::string_view field, std::string& scratch) {
+  if (field.size() < 2 || field.front() != '"' || field.back() != '"') {
+    return field;
+  }
+  field = field.substr(1, field.size() - 2);
+  if (field.find('"') == std::string_view::npos) {
+    return field;
+  }
+  scratch.clear();
+  for (size_t i = 0; i < field.size(); ++i) {
+    scratch.push_back(field[i]);
+    if (field[i] == '"' && i + 1 < field.size() && field[i + 1] == '"') {
+      ++i;
+    }
+  }
+  return scratch;
+}
+
+inline constexpr size_t kFields = 6;
+
+/**
+ * Parses the records that start in [begin, stop) of data[0, size); the last
+ * one may run past stop. begin must be a record start.
+ */
+inline void parseRange(const char* data, size_t size, size_t begin, size_t stop, char delimiter, AddressTable& table, IngestStats& stats) {
+  const Kernels& k = kernels();
+  std::string_view fields[kFields];
+  std::string scratch[4];
+  size_t field_count = 0;
+  size_t field_start = begin;
+  size_t record_start = begin;
+  uint64_t in_quote = 0;  // all ones while inside a quoted field
+
+  const auto finishRecord = [&](size_t end) {
+    if (end > field_start && data[end - 1] == '\r') {
+      --end;
+    }
+    if (field_count < kFields) {
+      fields[field_count] = std::string_view(data + field_start, end - field_start);
+    }
+    ++field_count;
+    if (field_count == 1 && fields[0].empty()) {
+      field_count = 0;  // blank line
+      return;
+    }
+    ++stats.records;
+    uint16_t state = 0;
+    uint32_t zip = 0;
+    if (field_count != kFields) {
+      ++stats.bad_field_count;
+    } else if (!parseState(fields[4], state)) {
+      ++stats.bad_state;
+    } else if (!parseZip(fields[5], zip)) {
+      ++stats.bad_zip;
+    } else {
+      table.append(unquote(fields[0], scratch[0]), unquote(fields[1], scratch[1]), unquote(fields[2], scratch[2]), unquote(fields[3], scratch[3]), state, zip);
+      ++stats.accepted;
+    }
+    field_count = 0;
+  };
+
+  char tail[64];
+  for (size_t block = begin; block < size; block += 64) {
+    const char* p = data + block;
+    if (size - block < 64) {
+      std::memset(tail, ' ', sizeof(tail));
+      std::memcpy(tail, p, size - block);
+      p = tail;
+    }
+    const BlockMasks m = k.classify(p, delimiter);
+    const uint64_t quoted = prefixXor(m.quote) ^ in_quote;
+    in_quote = static_cast<uint64_t>(static_cast<int64_t>(quoted) >> 63);
+    uint64_t structural = (m.delimiter | m.newline) & ~quoted;
+    if (size - block < 64) {
+      structural &= (uint64_t{1} << (size - block)) - 1;
+    }
+    while (structural != 0) {
+      const int bit = __builtin_ctzll(structural);
+      structural &= structural - 1;
+      const size_t pos = block + static_cast<size_t>(bit);
+      if ((m.newline >> bit) & 1) {
+        finishRecord(pos);
+        field_start = record_start = pos + 1;
+        if (record_start >= stop) {
+          return;
+        }
+      } else {
+        if (field_count < kFields) {
+          fields[field_count] = std::string_view(data + field_start, pos - field_start);
+        }
+        ++field_count;
+        field_start = pos + 1;
+      }
+    }
+  }
+  if (record_start < size) {
+    finishRecord(size);  // last line without a newline
+  }
+}
+
+/**
+ * First record start at or after `from`, given whether `from` is inside a
+ * quoted field. Returns size if there is none.
+ */
+inline size_t resync(const char* data, size_t size, size_t from, bool inside_quotes) {
+  if (from == 0) {
+    return 0;
+  }
+  // `from` starts a record iff the byte before it is a newline outside quotes
+  size_t pos = from - 1;
+  bool quoted = inside_quotes != (data[pos] == '"');  // state before data[pos]
+  for (; pos < size; ++pos) {
+    if (data[pos] == '"') {
+      quoted = !quoted;
+    } else if (data[pos] == '\n' && !quoted) {
+      return pos + 1;
+    }
+  }
+  return size;
+}
+
+}  // namespace detail
+
+/**
+ * Ingests delimited text with columns first_name, last_name, street, city,
+ * state, zip. A first line starting with "first_name" is taken as a header.
+ * threads == 0 uses the hardware concurrency.
+ */
+inline IngestResult ingest(std::string_view text, char delimiter = ',', size_t threads = 0) {
+  const char* data = text.data();
+  const size_t size = text.size();
+  size_t start = 0;
+  if (text.substr(0, 10) == "first_name") {
+    const size_t newline = text.find('\n');
+    start = newline == std::string_view::npos ? size : newline + 1;
+  }
+
+  threads = std::max<size_t>(1, threads != 0 ? threads : std::thread::hardware_concurrency());
+  threads = std::min(threads, std::max<size_t>(1, (size - start) / (1 << 20)));  // at least 1 MiB each
+  std::vector<size_t> bounds(threads + 1);
+  for (size_t t = 0; t <= threads; ++t) {
+    bounds[t] = start + (size - start) * t / threads;
+  }
+
+  // Quote parity at each range start, then each range's first real record
+  std::vector<uint64_t> quotes(threads, 0);
+  const auto countRange = [&](size_t t) { quotes[t] = detail::kernels().count_quotes(data + bounds[t], bounds[t + 1] - bounds[t]); };
+  std::vector<AddressTable> tables(threads);
+  std::vector<IngestStats> stats(threads);
+  const auto parseChunk = [&](size_t t, bool inside_quotes) {
+    const size_t begin = detail::resync(data, size, bounds[t], inside_quotes);
+    if (begin < bounds[t + 1]) {
+      detail::parseRange(data, size, begin, bounds[t + 1], delimiter, tables[t], stats[t]);
+    }
+  };
+
+  if (threads == 1) {
+    detail::parseRange(data, size, start, size, delimiter, tables[0], stats[0]);
+    return IngestResult{std::move(tables[0]), stats[0]};
+  }
+  {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+      workers.emplace_back(countRange, t);
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+  {
+    std::vector<std::thread> workers;
+    uint64_t prefix = 0;
+    for (size_t t = 0; t < threads; ++t) {
+      workers.emplace_back(parseChunk, t, (prefix & 1) != 0);
+      prefix += quotes[t];
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  IngestResult result;
+  size_t total = 0;
+  for (const auto& table : tables) {
+    total += table.size();
+  }
+  size_t string_bytes = 0;
+  for (const auto& table : tables) {
+    string_bytes += table.strings().size();
+  }
+  result.table = std::move(tables[0]);
+  result.table.reserve(total, string_bytes);
+  result.stats = stats[0];
+  for (size_t t = 1; t < threads; ++t) {
+    result.table.appendTable(tables[t]);
+    result.stats += stats[t];
+  }
+  return result;
+}
+
+/**
+ * Read-only mapping of an input file (RAII)
+ */
+class MappedInput {
+ public:
+  explicit MappedInput(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+    struct stat info{};
+    if (::fstat(fd, &info) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "fstat " + path);
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ > 0) {
+      void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      const int error = errno;
+      if (mapping == MAP_FAILED) {
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "mmap " + path);
+      }
+      ::madvise(mapping, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(mapping);
+    }
+    ::close(fd);
+  }
+
+  ~MappedInput() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+  }
+
+  MappedInput(const MappedInput&) = delete;
+  MappedInput& operator=(const MappedInput&) = delete;
+
+  [[nodiscard]] std::string_view text() const noexcept {
+    return std::string_view(data_, size_);
+  }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/**
+ * Maps path and ingests it
+ */
+inline IngestResult ingestFile(const std::string& path, char delimiter = ',', size_t threads = 0) {
+  const MappedInput input(path);
+  return ingest(input.text(), delimiter, threads);
+}
+
+}  // namespace csc450::address
+
+#endif  // CSC450_MODULE1_PERF_ADDRESS_INGEST_H_
@@ -0,0 +1,608 @@
+/**
+ * Leveled binary logging: compile-time floor, atomic runtime level, per-thread rings
+ *
+ * debug_example.cpp used to trace with std::cout << "[DEBUG] ..." << endl:
+ * always on, formatted on the spot, one flushed write(2) per line. Here a
+ * log call costs, in order of how often it happens:
+ *
+ *   below CSC450_LOG_MIN_LEVEL   nothing; `if constexpr` removes the call
+ *                                and its arguments are never evaluated
+ *   below the runtime level      one relaxed atomic load and a branch
+ *   enabled                      a timestamp and a memcpy of a small binary
+ *                                record (format pointer + tagged argument
+ *                                values) into this thread's ring buffer
+ *
+ * Formatting happens later: drainText() renders pending records of every
+ * thread in timestamp order ("[DEBUG] Message variable created: Hello"),
+ * and whatever is left at exit is drained to stderr (setExitSink changes
+ * or disables that). drainBinary() writes the records pointer-free, format
+ * strings inline, for formatBinary() / binlog_cat to render offline.
+ *
+ *     CSC450_LOG_DEBUG("Message variable created: {}", message);
+ *     csc450::log::setLevel(csc450::log::Level::kInfo);  // any thread, any time
+ *
+ * Each thread owns a single-producer ring (kRingBytes); the drainer is the
+ * only consumer. The ring never blocks or allocates after the thread's first
+ * record: when it is full the record is dropped and counted (dropped()),
+ * since a logger must not stall the code it observes. Strings are copied
+ * (truncated to fit kMaxRecordBytes), so arguments may die right after the
+ * call. The format must be a string literal; the macros enforce that.
+ * When a thread exits its ring is marked retired, and the next drain
+ * frees it once it is empty, so code that spawns threads per pass does not
+ * keep a ring per thread it ever ran.
+ * Records still in memory are lost if the process crashes; use drainText
+ * at points that matter. The runtime level starts at trace, or at
+ * CSC450_LOG_LEVEL (trace, debug, info, warn, error, off) when set.
+ */
+
+#ifndef CSC450_MODULE1_PERF_BINLOG_H_
+#define CSC450_MODULE1_PERF_BINLOG_H_
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "posix_io.h"
+
+#ifndef CSC450_LOG_MIN_LEVEL
+#define CSC450_LOG_MIN_LEVEL 0
+#endif
+
+namespace csc450::log {
+
+enum class Level : int { kTrace = 0, kDebug, kInfo, kWarn, kError, kOff };
+
+inline constexpr Level kCompiledLevel = static_cast<Level>(CSC450_LOG_MIN_LEVEL);
+inline constexpr size_t kRingBytes = size_t{1} << 16;
+inline constexpr size_t kMaxRecordBytes = 1024;
+
+inline constexpr const char* levelName(Level level) noexcept {
+  switch (level) {
+    case Level::kTrace:
+      return "TRACE";
+    case Level::kDebug:
+      return "DEBUG";
+    case Level::kInfo:
+      return "INFO";
+    case Level::kWarn:
+      return "WARN";
+    case Level::kError:
+      return "ERROR";
+    default:
+      return "OFF";
+  }
+}
+
+namespace detail {
+
+enum Tag : uint8_t { kInt = 1, kUint, kDouble, kBool, kChar, kString };
+
+// In the ring: header, then the tagged arguments
+struct RecordHeader {
+  uint32_t size;  // whole record, header included
+  uint8_t level;
+  uint8_t argc;
+  uint16_t reserved;
+  uint64_t timestamp_ns;
+  const char* format;
+};
+
+inline Level parseLevel(const char* text, Level fallback) noexcept {
+  if (text == nullptr) {
+    return fallback;
+  }
+  for (int l = 0; l <= static_cast<int>(Level::kOff); ++l) {
+    const char* name = levelName(static_cast<Level>(l));
+    size_t i = 0;
+    while (name[i] != '\0' && text[i] != '\0' && (text[i] == name[i] || text[i] == name[i] - 'A' + 'a')) {
+      ++i;
+    }
+    if (name[i] == '\0' && text[i] == '\0') {
+      return static_cast<Level>(l);
+    }
+  }
+  return fallback;
+}
+
+inline std::atomic<int> g_level{static_cast<int>(parseLevel(std::getenv("CSC450_LOG_LEVEL"), Level::kTrace))};
+inline std::atomic<int> g_exit_fd{STDERR_FILENO};
+
+/**
+ * Single-producer, single-consumer byte ring holding whole records
+ */
+class Ring {
+ public:
+  explicit Ring(uint32_t thread) : thread_(thread) {}
+
+  bool push(const char* record, size_t size) noexcept {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    const uint64_t tail = tail_.load(std::memory_order_acquire);
+    if (kRingBytes - (head - tail) < size) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    copyIn(head, record, size);
+    head_.store(head + size, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Calls each(record, size) for every pending record, then frees them
+   */
+  template <typename Each>
+  void consume(Each&& each) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    char record[kMaxRecordBytes];
+    while (tail < head) {
+      uint32_t size = 0;
+      copyOut(tail, reinterpret_cast<char*>(&size), sizeof(size));
+      copyOut(tail, record, size);
+      each(record, static_cast<size_t>(size));
+      tail += size;
+    }
+    tail_.store(tail, std::memory_order_release);
+  }
+
+  // Called by the owning thread as it exits; no push follows
+  void retire() noexcept {
+    retired_.store(true, std::memory_order_release);
+  }
+
+  [[nodiscard]] uint32_t thread() const noexcept {
+    return thread_;
+  }
+  [[nodiscard]] bool retired() const noexcept {
+    return retired_.load(std::memory_order_acquire);
+  }
+  [[nodiscard]] uint64_t dropped() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void copyIn(uint64_t at, const char* data, size_t size) noexcept {
+    const size_t offset = static_cast<size_t>(at & (kRingBytes - 1));
+    const size_t first = std::min(size, kRingBytes - offset);
+    std::memcpy(bytes_ + offset, data, first);
+    std::memcpy(bytes_, data + first, size - first);
+  }
+  void copyOut(uint64_t at, char* data, size_t size) const noexcept {
+    const size_t offset = static_cast<size_t>(at & (kRingBytes - 1));
+    const size_t first = std::min(size, kRingBytes - offset);
+    std::memcpy(data, bytes_ + offset, first);
+    std::memcpy(data + first, bytes_, size - first);
+  }
+
+  alignas(64) std::atomic<uint64_t> head_{0};  // written by the owning thread
+  alignas(64) std::atomic<uint64_t> tail_{0};  // written by the drainer
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<bool> retired_{false};
+  uint32_t thread_;
+  char bytes_[kRingBytes];
+};
+
+// One text line (or binary record) per drained entry, sortable by time
+struct Drained {
+  uint64_t timestamp_ns;
+  uint32_t thread;
+  std::string bytes;
+};
+
+void appendText(std::string& out, Level level, std::string_view format, const char* args, const char* end, unsigned argc);
+
+/**
+ * Every thread's ring; drains whatever is left at exit
+ */
+class Registry {
+ public:
+  Registry() = default;
+  Registry(const Registry&) = delete;
+  Registry& operator=(const Registry&) = delete;
+
+  ~Registry() {
+    const int fd = g_exit_fd.load(std::memory_order_relaxed);
+    if (fd >= 0) {
+      try {
+        drainTo(fd, false);
+      } catch (...) {  // nothing sensible to report from a destructor
+      }
+    }
+  }
+
+  std::shared_ptr<Ring> add() {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    rings_.push_back(std::make_shared<Ring>(next_thread_++));
+    return rings_.back();
+  }
+
+  /**
+   * Pending records of all threads in timestamp order, as text lines or as
+   * offline binary records
+   */
+  std::vector<Drained> drain(bool binary) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Drained> entries;
+    for (auto it = rings_.begin(); it != rings_.end();) {
+      Ring* ring = it->get();
+      // Read before consuming: once retired, everything the thread pushed
+      // is visible, so this pass empties the ring for good
+      const bool retired = ring->retired();
+      ring->consume([&](const char* record, size_t size) {
+        RecordHeader h;
+        std::memcpy(&h, record, sizeof(h));
+        Drained entry{h.timestamp_ns, ring->thread(), {}};
+        const char* args = record + sizeof(h);
+        if (binary) {
+          encodeOffline(entry.bytes, h, ring->thread(), args, record + size);
+        } else {
+          appendText(entry.bytes, static_cast<Level>(h.level), h.format, args, record + size, h.argc);
+        }
+        entries.push_back(std::move(entry));
+      });
+      if (retired) {
+        retired_dropped_ += ring->dropped();
+        it = rings_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const Drained& a, const Drained& b) { return a.timestamp_ns < b.timestamp_ns; });
+    return entries;
+  }
+
+  size_t drainTo(int fd, bool binary) {
+    const std::vector<Drained> entries = drain(binary);
+    std::string out;
+    for (const Drained& e : entries) {
+      out += e.bytes;
+    }
+    if (!io::writeAll(fd, out)) {
+      throw std::runtime_error("log drain: write failed");
+    }
+    return entries.size();
+  }
+
+  size_t rings() {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    return rings_.size();
+  }
+
+  uint64_t dropped() {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t total = retired_dropped_;
+    for (const auto& ring : rings_) {
+      total += ring->dropped();
+    }
+    return total;
+  }
+
+ private:
+  // Offline record: u32 size, u8 level, u8 argc, u16 format length, u32 thread, u64 time, format, arguments
+  static void encodeOffline(std::string& out, const RecordHeader& h, uint32_t thread, const char* args, const char* end) {
+    const size_t format_length = std::min<size_t>(std::strlen(h.format), UINT16_MAX);
+    const auto args_size = static_cast<size_t>(end - args);
+    const auto size = static_cast<uint32_t>(20 + format_length + args_size);
+    const auto length = static_cast<uint16_t>(format_length);
+    const auto put = [&out](const void* p, size_t n) { out.append(static_cast<const char*>(p), n); };
+    put(&size, 4);
+    put(&h.level, 1);
+    put(&h.argc, 1);
+    put(&length, 2);
+    put(&thread, 4);
+    put(&h.timestamp_ns, 8);
+    put(h.format, format_length);
+    put(args, args_size);
+  }
+
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<Ring>> rings_;  // live threads, and exited ones not yet drained
+  uint32_t next_thread_ = 0;
+  uint64_t retired_dropped_ = 0;  // dropped() of rings already freed
+};
+
+inline Registry& registry() {
+  static Registry instance;
+  return instance;
+}
+
+// Owning thread's reference; retires the ring when the thread exits (the
+// registry may already be gone at that point, hence the shared ownership)
+class RingHandle {
+ public:
+  RingHandle() : ring_(registry().add()) {}
+  ~RingHandle() {
+    ring_->retire();
+  }
+  RingHandle(const RingHandle&) = delete;
+  RingHandle& operator=(const RingHandle&) = delete;
+
+  [[nodiscard]] Ring* get() const noexcept {
+    return ring_.get();
+  }
+
+ private:
+  std::shared_ptr<Ring> ring_;
+};
+
+// This thread's ring, registered on first use; null if that allocation failed
+inline Ring* threadRing() noexcept {
+  try {
+    thread_local const RingHandle handle;
+    return handle.get();
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+/**
+ * Bounded encoder for one record's arguments
+ */
+class ArgWriter {
+ public:
+  ArgWriter(char* begin, char* end) : at_(begin), end_(end) {}
+
+  template <typename T>
+  void put(const T& value) noexcept {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same_v<U, bool>) {
+      scalar(kBool, static_cast<uint8_t>(value ? 1 : 0));
+    } else if constexpr (std::is_same_v<U, char>) {
+      scalar(kChar, value);
+    } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+      scalar(kInt, static_cast<int64_t>(value));
+    } else if constexpr (std::is_integral_v<U>) {
+      scalar(kUint, static_cast<uint64_t>(value));
+    } else if constexpr (std::is_floating_point_v<U>) {
+      scalar(kDouble, static_cast<double>(value));
+    } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+      text(std::string_view(value));
+    } else {
+      static_assert(std::is_convertible_v<const U&, std::string_view>, "log arguments: integers, floating point, bool, char or strings");
+    }
+  }
+
+  [[nodiscard]] char* end() const noexcept {
+    return at_;
+  }
+  [[nodiscard]] unsigned count() const noexcept {
+    return count_;
+  }
+
+ private:
+  template <typename V>
+  void scalar(Tag tag, V value) noexcept {
+    if (static_cast<size_t>(end_ - at_) < 1 + sizeof(V)) {
+      return;  // no room: the argument is dropped, the record kept
+    }
+    *at_++ = static_cast<char>(tag);
+    std::memcpy(at_, &value, sizeof(V));
+    at_ += sizeof(V);
+    ++count_;
+  }
+
+  void text(std::string_view s) noexcept {
+    if (end_ - at_ < 3) {
+      return;
+    }
+    const auto length = static_cast<uint16_t>(std::min(s.size(), static_cast<size_t>(end_ - at_ - 3)));
+    *at_++ = static_cast<char>(kString);
+    std::memcpy(at_, &length, sizeof(length));
+    std::memcpy(at_ + 2, s.data(), length);
+    at_ += 2 + length;
+    ++count_;
+  }
+
+  char* at_;
+  char* end_;
+  unsigned count_ = 0;
+};
+
+inline uint64_t nowNs() noexcept {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+template <typename... Args>
+void record(Level level, const char* format, const Args&... args) noexcept {
+  Ring* ring = threadRing();
+  if (ring == nullptr) {
+    return;
+  }
+  char buffer[kMaxRecordBytes];
+  ArgWriter writer(buffer + sizeof(RecordHeader), buffer + sizeof(buffer));
+  (writer.put(args), ...);
+  const RecordHeader header{static_cast<uint32_t>(writer.end() - buffer), static_cast<uint8_t>(level), static_cast<uint8_t>(writer.count()), 0, nowNs(), format};
+  std::memcpy(buffer, &header, sizeof(header));
+  ring->push(buffer, header.size);
+}
+
+/**
+ * "[LEVEL] " + format with each "{}" replaced by the next argument + '\n'
+ */
+inline void appendText(std::string& out, Level level, std::string_view format, const char* args, const char* end, unsigned argc) {
+  out += '[';
+  out += levelName(level);
+  out += "] ";
+  const auto take = [&](void* value, size_t n) {
+    if (static_cast<size_t>(end - args) < n) {
+      throw std::runtime_error("log record truncated");
+    }
+    std::memcpy(value, args, n);
+    args += n;
+  };
+  for (size_t i = 0; i < format.size(); ++i) {
+    if (format[i] != '{' || i + 1 >= format.size() || format[i + 1] != '}' || argc == 0) {
+      out += format[i];
+      continue;
+    }
+    ++i;
+    --argc;
+    uint8_t tag = 0;
+    take(&tag, 1);
+    char number[32];
+    switch (tag) {
+      case kInt: {
+        int64_t v;
+        take(&v, sizeof(v));
+        out.append(number, static_cast<size_t>(std::snprintf(number, sizeof(number), "%lld", static_cast<long long>(v))));
+        break;
+      }
+      case kUint: {
+        uint64_t v;
+        take(&v, sizeof(v));
+        out.append(number, static_cast<size_t>(std::snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(v))));
+        break;
+      }
+      case kDouble: {
+        double v;
+        take(&v, sizeof(v));
+        out.append(number, static_cast<size_t>(std::snprintf(number, sizeof(number), "%g", v)));
+        break;
+      }
+      case kBool: {
+        uint8_t v;
+        take(&v, sizeof(v));
+        out += v != 0 ? "true" : "false";
+        break;
+      }
+      case kChar: {
+        char v;
+        take(&v, sizeof(v));
+        out += v;
+        break;
+      }
+      case kString: {
+        uint16_t length;
+        take(&length, sizeof(length));
+        if (static_cast<size_t>(end - args) < length) {
+          throw std::runtime_error("log record truncated");
+        }
+        out.append(args, length);
+        args += length;
+        break;
+      }
+      default:
+        throw std::runtime_error("log record has an unknown argument tag");
+    }
+  }
+  out += '\n';
+}
+
+}  // namespace detail
+
+inline void setLevel(Level level) noexcept {
+  detail::g_level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+[[nodiscard]] inline Level level() noexcept {
+  return static_cast<Level>(detail::g_level.load(std::memory_order_relaxed));
+}
+
+[[nodiscard]] inline bool enabled(Level level) noexcept {
+  return static_cast<int>(level) >= detail::g_level.load(std::memory_order_relaxed);
+}
+
+/**
+ * Where records left at exit are formatted to; -1 discards them
+ */
+inline void setExitSink(int fd) noexcept {
+  detail::g_exit_fd.store(fd, std::memory_order_relaxed);
+}
+
+/**
+ * Formats every pending record to fd now; returns how many
+ */
+inline size_t drainText(int fd) {
+  return detail::registry().drainTo(fd, false);
+}
+
+/**
+ * Pending records as text, without writing them anywhere
+ */
+inline std::string drainToString() {
+  std::string out;
+  for (const auto& e : detail::registry().drain(false)) {
+    out += e.bytes;
+  }
+  return out;
+}
+
+/**
+ * Writes every pending record to fd in the offline binary form
+ */
+inline size_t drainBinary(int fd) {
+  return detail::registry().drainTo(fd, true);
+}
+
+/**
+ * Rings held: one per thread that has logged and is still running, plus
+ * exited threads' rings until the next drain
+ */
+[[nodiscard]] inline size_t rings() {
+  return detail::registry().rings();
+}
+
+/**
+ * Records dropped because a ring was full
+ */
+[[nodiscard]] inline uint64_t dropped() {
+  return detail::registry().dropped();
+}
+
+/**
+ * Renders drainBinary() output as text; throws std::runtime_error if it is
+ * truncated or malformed
+ */
+inline std::string formatBinary(std::string_view data) {
+  std::string out;
+  while (!data.empty()) {
+    uint32_t size = 0;
+    uint16_t format_length = 0;
+    if (data.size() < 20) {
+      throw std::runtime_error("binary log truncated");
+    }
+    std::memcpy(&size, data.data(), 4);
+    std::memcpy(&format_length, data.data() + 6, 2);
+    if (size < 20u + format_length || size > data.size() || static_cast<uint8_t>(data[4]) > static_cast<uint8_t>(Level::kError)) {
+      throw std::runtime_error("binary log record is malformed");
+    }
+    const std::string_view format = data.substr(20, format_length);
+    detail::appendText(out, static_cast<Level>(data[4]), format, data.data() + 20 + format_length, data.data() + size, static_cast<uint8_t>(data[5]));
+    data.remove_prefix(size);
+  }
+  return out;
+}
+
+}  // namespace csc450::log
+
+// The format must be a string literal (the "" concatenation rejects anything else)
+#define CSC450_LOG(level, format, ...)                                                  \
+  do {                                                                                  \
+    if constexpr (static_cast<int>(level) >= CSC450_LOG_MIN_LEVEL) {                    \
+      if (::csc450::log::enabled(level)) {                                              \
+        ::csc450::log::detail::record(level, "" format "" __VA_OPT__(, ) __VA_ARGS__); \
+      }                                                                                 \
+    }                                                                                   \
+  } while (0)
+
+#define CSC450_LOG_TRACE(format, ...) CSC450_LOG(::csc450::log::Level::kTrace, format __VA_OPT__(, ) __VA_ARGS__)
+#define CSC450_LOG_DEBUG(format, ...) CSC450_LOG(::csc450::log::Level::kDebug, format __VA_OPT__(, ) __VA_ARGS__)
+#define CSC450_LOG_INFO(format, ...) CSC450_LOG(::csc450::log::Level::kInfo, format __VA_OPT__(, ) __VA_ARGS__)
+#define CSC450_LOG_WARN(format, ...) CSC450_LOG(::csc450::log::Level::kWarn, format __VA_OPT__(, ) __VA_ARGS__)
+#define CSC450_LOG_ERROR(format, ...) CSC450_LOG(::csc450::log::Level::kError, format __VA_OPT__(, ) __VA_ARGS__)
+
+#endif  // CSC450_MODULE1_PERF_BINLOG_H_
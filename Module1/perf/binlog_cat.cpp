@@ -0,0 +1,57 @@
+/**
+ * Formats binlog.h binary logs (csc450::log::drainBinary output) as text
+ *
+ * Reads each FILE, or stdin when none is given, and writes the "[LEVEL]
+ * message" lines to stdout; the records carry their format strings, so
+ * the program that wrote them is not needed.
+ *
+ * Usage: binlog_cat [FILE...]
+ */
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "binlog.h"
+
+namespace {
+
+std::string readAll(std::istream& in, const std::string& name) {
+  std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  if (in.bad()) {
+    throw std::runtime_error("cannot read " + name);
+  }
+  return data;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    csc450::log::setExitSink(-1);
+    if (argc < 2) {
+      std::cout << csc450::log::formatBinary(readAll(std::cin, "stdin"));
+    }
+    for (int i = 1; i < argc; ++i) {
+      const std::string path = argv[i];
+      if (!path.empty() && path[0] == '-') {
+        std::cerr << "Usage: " << argv[0] << " [FILE...]\n";
+        return EXIT_FAILURE;
+      }
+      std::ifstream in(path, std::ios::binary);
+      if (!in) {
+        throw std::runtime_error("cannot open " + path);
+      }
+      std::cout << csc450::log::formatBinary(readAll(in, path));
+    }
+    std::cout.flush();
+    return std::cout ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "binlog_cat failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,25 @@
+// Debug Example, lean output: same streams and text as ../debug_example.cpp, no iostream
+// The traces go to stderr like binlog.h's exit drain, but each is written
+// immediately, so they survive a crash (and so appear before the message)
+
+#include <unistd.h>
+
+#include <string_view>
+
+#include "lean_output.h"
+
+int main() {
+  using csc450::lean::print;
+  using csc450::lean::writeAll;
+
+  bool ok = writeAll(STDERR_FILENO, "[DEBUG] Program started\n");
+
+  const std::string_view message = "Hello World..";
+  ok = writeAll(STDERR_FILENO, {"[DEBUG] Message variable created: ", message, "\n"}) && ok;
+
+  ok = print({message, "\n"}) && ok;
+
+  ok = writeAll(STDERR_FILENO, "[DEBUG] Program ending\n") && ok;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,7 @@
+// Hello World, lean output: same text as "../hello world.cpp", no iostream
+
+#include "lean_output.h"
+
+int main() {
+  return csc450::lean::print("Hello World..\n") ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+/**
+ * Scan throughput of record structs in declaration order vs the suggested order
+ *
+ * Fills std::vectors of PersonFields / PersonFieldsPacked and PersonRecord /
+ * PersonRecordPacked (record_layouts.h) with the same --records synthetic
+ * people and times two scans over each:
+ *   student_credit   sum of gpa * credit_hours over students (three fields)
+ *   all_scalars      a checksum over every scalar field
+ * Both layouts hold the same values, so the results must agree exactly;
+ * the report gives ns and bytes per record, GB/s of records streamed, and
+ * the packed layout's speedup (best of --rounds alternating measurements).
+ * Records far exceed the caches by default, so the scans are memory-bound
+ * and the gain tracks the size reduction.
+ *
+ * Usage: layout_bench [--records N] [--min-time SECONDS] [--rounds N]
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "bench_util.h"
+#include "record_gen.h"
+#include "record_layouts.h"
+
+namespace {
+
+namespace layout = csc450::layout;
+using csc450::records::PersonRecord;
+
+struct ScanResult {
+  double gpa_hours = 0;
+  uint64_t students = 0;
+  uint64_t checksum = 0;
+
+  bool operator==(const ScanResult& other) const noexcept {
+    return gpa_hours == other.gpa_hours && students == other.students && checksum == other.checksum;
+  }
+};
+
+template <typename To, typename From>
+void copyScalars(To& to, const From& from) {
+  to.age = from.age;
+  to.height = from.height;
+  to.grade = from.grade;
+  to.is_student = from.is_student;
+  to.student_id = from.student_id;
+  to.ssn = from.ssn;
+  to.gpa = from.gpa;
+  to.credit_hours = from.credit_hours;
+}
+
+template <typename Record>
+std::vector<Record> fill(const std::vector<PersonRecord>& people) {
+  std::vector<Record> rows(people.size());
+  for (size_t i = 0; i < people.size(); ++i) {
+    if constexpr (!std::is_same_v<Record, layout::PersonFields> && !std::is_same_v<Record, layout::PersonFieldsPacked>) {
+      rows[i].name = people[i].name;
+      rows[i].birthdate = people[i].birthdate;
+    }
+    copyScalars(rows[i], people[i]);
+  }
+  return rows;
+}
+
+template <typename Record>
+ScanResult studentCredit(const std::vector<Record>& rows) {
+  ScanResult r;
+  for (const Record& row : rows) {
+    // Branch-free: is_student is random, and mispredictions would hide the memory traffic
+    const auto weight = static_cast<double>(row.is_student);
+    r.gpa_hours += weight * static_cast<double>(row.gpa) * row.credit_hours;
+    r.students += row.is_student ? 1 : 0;
+  }
+  return r;
+}
+
+template <typename Record>
+ScanResult allScalars(const std::vector<Record>& rows) {
+  ScanResult r;
+  for (const Record& row : rows) {
+    r.gpa_hours += row.height + static_cast<double>(row.gpa);
+    r.students += row.is_student ? 1 : 0;
+    r.checksum += static_cast<uint64_t>(row.age) + row.student_id + static_cast<uint64_t>(row.ssn) + static_cast<uint64_t>(row.credit_hours) +
+                  static_cast<uint64_t>(static_cast<unsigned char>(row.grade));
+  }
+  return r;
+}
+
+enum Scan { kStudentCredit, kAllScalars, kScans };
+const char* const kScanNames[kScans] = {"student_credit", "all_scalars"};
+
+template <typename Record>
+ScanResult runScan(Scan scan, const std::vector<Record>& rows) {
+  return scan == kStudentCredit ? studentCredit(rows) : allScalars(rows);
+}
+
+template <typename Record>
+double nsPerRecord(Scan scan, const std::vector<Record>& rows, double min_time) {
+  const double ns = csc450::bench::nsPerOp(
+      [&] {
+        const ScanResult r = runScan(scan, rows);
+        csc450::bench::doNotOptimize(r);
+      },
+      min_time);
+  return ns / static_cast<double>(rows.size());
+}
+
+/**
+ * Times both scans over one original/packed pair and writes their entries
+ */
+template <typename Original, typename Packed, size_t N, size_t M>
+bool comparePair(csc450::bench::JsonWriter& json, const layout::Layout<N>& original_layout, const layout::Layout<M>& packed_layout,
+                 const std::vector<PersonRecord>& people, double min_time, int rounds) {
+  bool all_match = true;
+  std::vector<Original> original = fill<Original>(people);
+  std::vector<Packed> packed = fill<Packed>(people);
+  for (int s = 0; s < kScans; ++s) {
+    const auto scan = static_cast<Scan>(s);
+    const bool match = runScan(scan, original) == runScan(scan, packed);
+    all_match = all_match && match;
+    double original_ns = 0;
+    double packed_ns = 0;
+    for (int round = 0; round < rounds; ++round) {  // alternate so drift hits both layouts alike
+      const double o = nsPerRecord(scan, original, min_time);
+      const double p = nsPerRecord(scan, packed, min_time);
+      original_ns = round == 0 ? o : std::min(original_ns, o);
+      packed_ns = round == 0 ? p : std::min(packed_ns, p);
+    }
+    json.beginObject();
+    json.field("scan", kScanNames[s]);
+    json.field("original", std::string(original_layout.name));
+    json.field("packed", std::string(packed_layout.name));
+    json.field("original_bytes_per_record", sizeof(Original));
+    json.field("packed_bytes_per_record", sizeof(Packed));
+    json.field("original_ns_per_record", original_ns);
+    json.field("packed_ns_per_record", packed_ns);
+    json.field("original_gb_per_s", static_cast<double>(sizeof(Original)) / original_ns);
+    json.field("packed_gb_per_s", static_cast<double>(sizeof(Packed)) / packed_ns);
+    json.field("speedup", original_ns / packed_ns);
+    json.field("results_match", match);
+    json.endObject();
+  }
+  return all_match;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    size_t records = 2000000;
+    double min_time = 0.1;
+    int rounds = 5;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--records" && i + 1 < argc) {
+        records = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+      } else if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else if (arg == "--rounds" && i + 1 < argc) {
+        rounds = std::max(1, std::atoi(argv[++i]));
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--records N] [--min-time SECONDS] [--rounds N]\n";
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::vector<PersonRecord> people;
+    people.reserve(records);
+    for (size_t i = 0; i < records; ++i) {
+      people.push_back(csc450::records::syntheticPerson(i));
+    }
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "record_layout_scan");
+    json.field("records", records);
+    json.field("rounds", rounds);
+    json.key("scans").beginArray();
+    bool all_match = comparePair<layout::PersonFields, layout::PersonFieldsPacked>(json, layout::kPersonFieldsLayout, layout::kPersonFieldsPackedLayout, people, min_time, rounds);
+    all_match =
+        comparePair<PersonRecord, layout::PersonRecordPacked>(json, layout::kPersonRecordLayout, layout::kPersonRecordPackedLayout, people, min_time, rounds) && all_match;
+    json.endArray();
+    json.field("all_match", all_match);
+    json.endObject();
+    std::cout << '\n';
+    return all_match ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "layout_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,106 @@
+/**
+ * Prints the layout report of the Module 1 record structs
+ *
+ * For each struct in record_layouts.h: every field's offset, size,
+ * alignment and cache line, the padding between fields, how records of
+ * that size sit in an array of cache lines, and the reordering that
+ * minimises padding. --json emits the same facts for tooling.
+ *
+ * Usage: layout_report [--json]
+ */
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "bench_util.h"
+#include "record_layouts.h"
+
+namespace {
+
+namespace layout = csc450::layout;
+
+template <size_t N>
+void writeJson(csc450::bench::JsonWriter& json, const layout::Layout<N>& l) {
+  const layout::ArrayFootprint array = layout::arrayFootprint(l.size);
+  const layout::Reordering<N> r = layout::suggestReordering(l);
+  json.beginObject();
+  json.field("name", std::string(l.name));
+  json.field("size", l.size);
+  json.field("align", l.align);
+  json.field("padding", layout::paddingBytes(l));
+  json.field("lines_per_record", array.lines_per_record);
+  json.field("split_fraction", array.straddling);
+  json.key("fields").beginArray();
+  for (size_t i = 0; i < N; ++i) {
+    const layout::Field& f = l.fields[i];
+    json.beginObject();
+    json.field("name", std::string(f.name));
+    json.field("type", std::string(f.type));
+    json.field("offset", f.offset);
+    json.field("size", f.size);
+    json.field("align", f.align);
+    json.field("padding_after", layout::paddingAfter(l, i));
+    json.field("first_line", layout::firstLine(f.offset));
+    json.field("last_line", layout::lastLine(f.offset, f.size));
+    json.endObject();
+  }
+  json.endArray();
+  json.field("suggested_size", r.size);
+  json.key("suggested_order").beginArray();
+  for (size_t i = 0; i < N; ++i) {
+    json.beginObject();
+    json.field("name", std::string(l.fields[r.order[i]].name));
+    json.field("offset", r.offsets[i]);
+    json.endObject();
+  }
+  json.endArray();
+  json.endObject();
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    bool as_json = false;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--json") {
+        as_json = true;
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--json]\n";
+        return EXIT_FAILURE;
+      }
+    }
+
+    if (as_json) {
+      csc450::bench::JsonWriter json(std::cout);
+      json.beginObject();
+      json.field("cache_line", layout::kCacheLine);
+      json.key("layouts").beginArray();
+      writeJson(json, layout::kPersonFieldsLayout);
+      writeJson(json, layout::kPersonFieldsPackedLayout);
+      writeJson(json, layout::kPersonRecordLayout);
+      writeJson(json, layout::kPersonRecordPackedLayout);
+      writeJson(json, layout::kGradeGroupLayout);
+      writeJson(json, layout::kStringRefLayout);
+      json.endArray();
+      json.endObject();
+      std::cout << '\n';
+    } else {
+      std::cout << layout::formatReport(layout::kPersonFieldsLayout) << '\n'
+                << layout::formatReport(layout::kPersonFieldsPackedLayout) << '\n'
+                << layout::formatReport(layout::kPersonRecordLayout) << '\n'
+                << layout::formatReport(layout::kPersonRecordPackedLayout) << '\n'
+                << layout::formatReport(layout::kGradeGroupLayout) << '\n'
+                << layout::formatReport(layout::kStringRefLayout);
+    }
+    std::cout.flush();
+    return std::cout ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "layout_report failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,90 @@
+/**
+ * iostream-free console output for tiny programs
+ *
+ * hello_world and debug_example do almost no work, so their run time is
+ * process start-up: loading libstdc++, relocating it, and constructing the
+ * eight standard streams (std::ios_base::Init) before main() runs. Output
+ * through write(2)/writev(2) needs none of that. These helpers are
+ * header-only, allocation-free and exception-free, so a program that uses
+ * only them does not need libstdc++ at run time (the lean targets link with
+ * --as-needed and drop it).
+ *
+ * Results are reported, not thrown: every function returns false when the
+ * write fails, and callers turn that into a non-zero exit status (ERR33-C:
+ * detect and handle standard library errors). Interrupted writes are
+ * retried and short writes resumed.
+ *
+ *     csc450::lean::print("Hello World..\n");
+ *     csc450::lean::print({"[DEBUG] Message variable created: ", message, "\n"});  // one writev
+ */
+
+#ifndef CSC450_MODULE1_PERF_LEAN_OUTPUT_H_
+#define CSC450_MODULE1_PERF_LEAN_OUTPUT_H_
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <initializer_list>
+#include <string_view>
+
+#include "posix_io.h"
+
+namespace csc450::lean {
+
+inline constexpr size_t kMaxParts = 16;
+
+// Writes every byte of text to fd (perf_common/posix_io.h)
+using io::writeAll;
+
+/**
+ * Writes the parts back to back with one writev(2) (more if it comes up
+ * short); at most kMaxParts parts
+ */
+inline bool writeAll(int fd, std::initializer_list<std::string_view> parts) noexcept {
+  if (parts.size() > kMaxParts) {
+    return false;
+  }
+  iovec iov[kMaxParts];
+  int count = 0;
+  for (const std::string_view part : parts) {
+    if (!part.empty()) {
+      iov[count].iov_base = const_cast<char*>(part.data());
+      iov[count].iov_len = part.size();
+      ++count;
+    }
+  }
+  int first = 0;
+  while (first < count) {
+    const ssize_t n = ::writev(fd, iov + first, count - first);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    auto written = static_cast<size_t>(n);
+    while (first < count && written >= iov[first].iov_len) {
+      written -= iov[first].iov_len;
+      ++first;
+    }
+    if (first < count) {
+      iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + written;
+      iov[first].iov_len -= written;
+    }
+  }
+  return true;
+}
+
+inline bool print(std::string_view text) noexcept {
+  return writeAll(STDOUT_FILENO, text);
+}
+
+inline bool print(std::initializer_list<std::string_view> parts) noexcept {
+  return writeAll(STDOUT_FILENO, parts);
+}
+
+}  // namespace csc450::lean
+
+#endif  // CSC450_MODULE1_PERF_LEAN_OUTPUT_H_
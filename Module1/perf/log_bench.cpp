@@ -0,0 +1,264 @@
+/**
+ * Cost of a debug trace: std::cout << ... << endl vs binlog.h
+ *
+ * Built with CSC450_LOG_MIN_LEVEL=1, so trace calls are compiled out and
+ * debug calls are compiled in. Reports ns per call for:
+ *   iostream_endl     debug_example's old trace line (stdout on /dev/null)
+ *   compiled_out      CSC450_LOG_TRACE below the compile-time floor
+ *   runtime_disabled  CSC450_LOG_DEBUG with the runtime level at info
+ *   enabled_*         CSC450_LOG_DEBUG into the thread's ring, with no
+ *                     arguments, one string, or four scalars; calls are
+ *                     timed in batches that fit the ring and the ring is
+ *                     drained to /dev/null between batches (untimed; the
+ *                     drain's own ns per record is reported separately)
+ * then enabled_string with --threads threads logging at once (each has its
+ * own ring, so the per-call cost should not grow). Before timing, the text
+ * drain and the binary drain -> formatBinary round trip are checked against
+ * the expected lines, and no record may be dropped. Afterwards short-lived
+ * threads each log once, and a drain must free every one of their rings.
+ *
+ * Usage: log_bench [--min-time SECONDS] [--threads N]
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "binlog.h"
+#include "posix_io.h"
+
+namespace {
+
+namespace binlog = csc450::log;
+using binlog::Level;
+
+constexpr int kBatch = 1000;  // calls per timed batch; fits the ring for every record shape here
+
+enum Case { kIostreamEndl, kCompiledOut, kRuntimeDisabled, kEnabledNoArgs, kEnabledString, kEnabledScalars, kCases };
+const char* const kCaseNames[kCases] = {"iostream_endl", "compiled_out", "runtime_disabled", "enabled_no_args", "enabled_string", "enabled_scalars"};
+
+struct Timing {
+  double ns_per_call = 0;
+  double drain_ns_per_record = 0;
+};
+
+void call(Case c, const std::string& message, int i) {
+  switch (c) {
+    case kIostreamEndl:
+      std::cout << "[DEBUG] Message variable created: " << message << std::endl;
+      break;
+    case kCompiledOut:
+      CSC450_LOG_TRACE("Message variable created: {}", message);
+      break;
+    case kEnabledNoArgs:
+      CSC450_LOG_DEBUG("Program started");
+      break;
+    case kEnabledScalars:
+      CSC450_LOG_DEBUG("record {} gpa {} grade {} student {}", i, 3.5, 'A', true);
+      break;
+    default:  // kRuntimeDisabled, kEnabledString
+      CSC450_LOG_DEBUG("Message variable created: {}", message);
+      break;
+  }
+}
+
+/**
+ * Times batches of kBatch calls, draining the ring after each batch
+ */
+Timing timeCalls(Case c, const std::string& message, double min_time, int null_fd) {
+  Timing t;
+  double call_seconds = 0;
+  double drain_seconds = 0;
+  uint64_t calls = 0;
+  uint64_t drained = 0;
+  do {
+    const auto start = csc450::bench::Clock::now();
+    for (int i = 0; i < kBatch; ++i) {
+      call(c, message, i);
+    }
+    csc450::bench::clobberMemory();
+    call_seconds += csc450::bench::secondsSince(start);
+    calls += kBatch;
+
+    const auto drain_start = csc450::bench::Clock::now();
+    drained += binlog::drainText(null_fd);
+    drain_seconds += csc450::bench::secondsSince(drain_start);
+  } while (call_seconds < min_time);
+  t.ns_per_call = call_seconds * 1e9 / static_cast<double>(calls);
+  t.drain_ns_per_record = drained == 0 ? 0 : drain_seconds * 1e9 / static_cast<double>(drained);
+  return t;
+}
+
+/**
+ * enabled_string on `threads` threads at once; mean ns per call per thread.
+ * Each thread stops after a batch once the ring would need draining, so
+ * nothing is dropped and no drainer competes with the timed calls.
+ */
+double timeThreads(int threads, const std::string& message) {
+  const int batches = std::max(1, static_cast<int>(binlog::kRingBytes / 64 / kBatch));
+  std::vector<double> seconds(static_cast<size_t>(threads));
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; ++t) {
+    pool.emplace_back([&, t] {
+      const auto start = csc450::bench::Clock::now();
+      for (int b = 0; b < batches; ++b) {
+        for (int i = 0; i < kBatch; ++i) {
+          CSC450_LOG_DEBUG("Message variable created: {}", message);
+        }
+      }
+      seconds[static_cast<size_t>(t)] = csc450::bench::secondsSince(start);
+    });
+  }
+  for (std::thread& worker : pool) {
+    worker.join();
+  }
+  double total = 0;
+  for (double s : seconds) {
+    total += s;
+  }
+  return total * 1e9 / (static_cast<double>(threads) * batches * kBatch);
+}
+
+constexpr int kShortLivedThreads = 64;
+
+/**
+ * Threads that log once and exit; their rings must be gone after one drain
+ */
+bool ringsReclaimed(int null_fd) {
+  binlog::drainText(null_fd);
+  const size_t before = binlog::rings();
+  for (int t = 0; t < kShortLivedThreads; ++t) {
+    std::thread([t] { CSC450_LOG_DEBUG("pass {}", t); }).join();
+  }
+  const bool all_kept = binlog::rings() == before + kShortLivedThreads;
+  const size_t drained = binlog::drainText(null_fd);
+  return all_kept && drained == kShortLivedThreads && binlog::rings() == before;
+}
+
+/**
+ * The text drain and the offline round trip both reproduce the expected lines
+ */
+bool checkFormatting(const std::string& message) {
+  const std::string expected =
+      "[DEBUG] Program started\n"
+      "[DEBUG] Message variable created: Hello World..\n"
+      "[DEBUG] record 42 gpa 3.5 grade A student true\n"
+      "[WARN] unsigned 18446744073709551615 negative -7 {} left alone\n";
+  const auto emit = [&] {
+    CSC450_LOG_DEBUG("Program started");
+    CSC450_LOG_TRACE("compiled out");
+    CSC450_LOG_DEBUG("Message variable created: {}", message);
+    CSC450_LOG_DEBUG("record {} gpa {} grade {} student {}", 42, 3.5, 'A', true);
+    CSC450_LOG_WARN("unsigned {} negative {} {} left alone", UINT64_MAX, -7);
+  };
+  emit();
+  const bool text_ok = binlog::drainToString() == expected;
+
+  char path[] = "/tmp/log_bench_XXXXXX";
+  const int fd = ::mkstemp(path);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), "mkstemp");
+  }
+  ::unlink(path);
+  emit();
+  binlog::drainBinary(fd);
+  ::lseek(fd, 0, SEEK_SET);
+  const std::string binary = csc450::io::readFile(fd);
+  ::close(fd);
+  return text_ok && binlog::formatBinary(binary) == expected;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    double min_time = 0.2;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else if (arg == "--threads" && i + 1 < argc) {
+        threads = std::max(1, std::atoi(argv[++i]));
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--min-time SECONDS] [--threads N]\n";
+        return EXIT_FAILURE;
+      }
+    }
+    binlog::setExitSink(-1);
+    binlog::setLevel(Level::kTrace);
+    const std::string message = "Hello World..";
+    const bool formatting_ok = checkFormatting(message);
+
+    const int null_fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (null_fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "open /dev/null");
+    }
+    Timing timing[kCases];
+    {
+      // std::cout goes to /dev/null for the iostream case only
+      std::cout.flush();
+      const int saved = ::dup(STDOUT_FILENO);
+      if (saved < 0 || ::dup2(null_fd, STDOUT_FILENO) < 0) {
+        throw std::system_error(errno, std::generic_category(), "redirect stdout");
+      }
+      timing[kIostreamEndl] = timeCalls(kIostreamEndl, message, min_time, null_fd);
+      std::cout.flush();
+      ::dup2(saved, STDOUT_FILENO);
+      ::close(saved);
+    }
+    for (int c = kCompiledOut; c < kCases; ++c) {
+      binlog::setLevel(c == kRuntimeDisabled ? Level::kInfo : Level::kTrace);
+      timing[c] = timeCalls(static_cast<Case>(c), message, min_time, null_fd);
+    }
+    const double threaded_ns = timeThreads(threads, message);
+    binlog::drainText(null_fd);
+    const bool reclaimed = ringsReclaimed(null_fd);
+    ::close(null_fd);
+    const uint64_t dropped = binlog::dropped();
+    const bool all_match = formatting_ok && reclaimed && dropped == 0;
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "binlog");
+    json.field("compiled_level", binlog::levelName(binlog::kCompiledLevel));
+    json.field("formatting_matches", formatting_ok);
+    json.field("dropped_records", static_cast<size_t>(dropped));
+    json.field("exited_thread_rings_reclaimed", reclaimed);
+    json.key("cases").beginArray();
+    for (int c = 0; c < kCases; ++c) {
+      json.beginObject();
+      json.field("case", kCaseNames[c]);
+      json.field("ns_per_call", timing[c].ns_per_call);
+      json.field("speedup_vs_iostream_endl", timing[kIostreamEndl].ns_per_call / timing[c].ns_per_call);
+      if (c >= kEnabledNoArgs) {
+        json.field("drain_ns_per_record", timing[c].drain_ns_per_record);
+      }
+      json.endObject();
+    }
+    json.endArray();
+    json.key("threaded").beginObject();
+    json.field("threads", threads);
+    json.field("enabled_string_ns_per_call", threaded_ns);
+    json.endObject();
+    json.field("all_match", all_match);
+    json.endObject();
+    std::cout << '\n';
+    return all_match ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "log_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,205 @@
+/**
+ * Column scans: array-of-structs vs the columnar RecordStore
+ *
+ * Builds --records synthetic personal-information records twice, as a
+ * std::vector<PersonRecord> (AoS) and as a csc450::records::RecordStore
+ * (SoA), then times four queries:
+ *   average_gpa            mean of gpa over all records
+ *   count_students         records with is_student set
+ *   average_student_gpa    mean gpa where is_student
+ *   count_age_18_25        records with 18 <= age <= 25
+ * each as a plain loop over the AoS vector, with the scalar kernels over
+ * the columns (layout alone), and with the dispatched SIMD kernels. Results
+ * are cross-checked, and the memory footprint of both layouts is reported.
+ *
+ * Usage: record_bench [--records N] [--min-time SECONDS]
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "record_gen.h"
+#include "record_store.h"
+
+namespace {
+
+using csc450::records::PersonRecord;
+using csc450::records::RecordStore;
+
+struct Answers {
+  double average_gpa = 0;
+  size_t students = 0;
+  double average_student_gpa = 0;
+  size_t age_18_25 = 0;
+};
+
+Answers aosAnswers(const std::vector<PersonRecord>& people) {
+  Answers a;
+  double gpa_sum = 0;
+  double student_gpa_sum = 0;
+  for (const PersonRecord& p : people) {
+    gpa_sum += p.gpa;
+    if (p.is_student) {
+      ++a.students;
+      student_gpa_sum += p.gpa;
+    }
+    a.age_18_25 += p.age >= 18 && p.age <= 25 ? 1 : 0;
+  }
+  a.average_gpa = gpa_sum / static_cast<double>(people.size());
+  a.average_student_gpa = student_gpa_sum / static_cast<double>(a.students);
+  return a;
+}
+
+bool close(double a, double b) {
+  return std::fabs(a - b) <= 1e-9 * std::fmax(1.0, std::fabs(a));
+}
+
+// Heap bytes owned by a string beyond its inline (SSO) buffer
+size_t heapBytes(const std::string& s) {
+  const size_t inline_capacity = std::string().capacity();
+  return s.capacity() > inline_capacity ? s.capacity() + 1 : 0;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    size_t records = 2000000;
+    double min_time = 0.1;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--records" && i + 1 < argc) {
+        records = std::strtoull(argv[++i], nullptr, 10);
+      } else if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--records N] [--min-time SECONDS]\n";
+        return EXIT_FAILURE;
+      }
+    }
+    records = std::max<size_t>(records, 1);
+
+    std::vector<PersonRecord> source;
+    source.reserve(records);
+    for (size_t i = 0; i < records; ++i) {
+      source.push_back(csc450::records::syntheticPerson(i));
+    }
+
+    auto start = csc450::bench::Clock::now();
+    std::vector<PersonRecord> aos(source);
+    const double aos_build_s = csc450::bench::secondsSince(start);
+    start = csc450::bench::Clock::now();
+    RecordStore store;
+    store.reserve(records);
+    for (const PersonRecord& p : source) {
+      store.append(p);
+    }
+    const double soa_build_s = csc450::bench::secondsSince(start);
+    source = {};
+
+    size_t aos_bytes = aos.size() * sizeof(PersonRecord);
+    for (const PersonRecord& p : aos) {
+      aos_bytes += heapBytes(p.name) + heapBytes(p.birthdate);
+    }
+
+    const Answers expected = aosAnswers(aos);
+    const auto& scalar = csc450::records::scan::detail::kScalarKernels;
+    const size_t n = store.size();
+    const bool match = close(store.averageGpa(), expected.average_gpa) && store.countStudents() == expected.students &&
+                       close(store.averageStudentGpa(), expected.average_student_gpa) && store.countAgeBetween(18, 25) == expected.age_18_25;
+
+    double sink = 0;
+    const auto measure = [&](auto&& query) {
+      return csc450::bench::nsPerOp([&] { sink += static_cast<double>(query()); }, min_time) / 1e6;
+    };
+    struct Query {
+      const char* name;
+      double aos_ms;
+      double soa_scalar_ms;
+      double soa_simd_ms;
+    };
+    const Query queries[] = {
+        {"average_gpa", measure([&] {
+           double sum = 0;
+           for (const PersonRecord& p : aos) {
+             sum += p.gpa;
+           }
+           return sum / static_cast<double>(aos.size());
+         }),
+         measure([&] { return scalar.sum(store.gpas().data(), n) / static_cast<double>(n); }), measure([&] { return store.averageGpa(); })},
+        {"count_students", measure([&] {
+           size_t count = 0;
+           for (const PersonRecord& p : aos) {
+             count += p.is_student ? 1 : 0;
+           }
+           return count;
+         }),
+         measure([&] { return scalar.count_non_zero(store.students().data(), n); }), measure([&] { return store.countStudents(); })},
+        {"average_student_gpa", measure([&] {
+           double sum = 0;
+           size_t count = 0;
+           for (const PersonRecord& p : aos) {
+             if (p.is_student) {
+               sum += p.gpa;
+               ++count;
+             }
+           }
+           return sum / static_cast<double>(count);
+         }),
+         measure([&] {
+           const auto r = scalar.sum_where(store.gpas().data(), store.students().data(), n);
+           return r.sum / static_cast<double>(r.count);
+         }),
+         measure([&] { return store.averageStudentGpa(); })},
+        {"count_age_18_25", measure([&] {
+           size_t count = 0;
+           for (const PersonRecord& p : aos) {
+             count += p.age >= 18 && p.age <= 25 ? 1 : 0;
+           }
+           return count;
+         }),
+         measure([&] { return scalar.count_in_range(store.ages().data(), n, 18, 25); }), measure([&] { return store.countAgeBetween(18, 25); })},
+    };
+    csc450::bench::doNotOptimize(sink);
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "record_store_scans");
+    json.field("records", records);
+    json.field("results_match", match);
+    json.field("aos_bytes", aos_bytes);
+    json.field("soa_bytes", store.bytes());
+    json.field("aos_build_ms", aos_build_s * 1e3);
+    json.field("soa_build_ms", soa_build_s * 1e3);
+    json.key("answers").beginObject();
+    json.field("average_gpa", expected.average_gpa);
+    json.field("students", expected.students);
+    json.field("average_student_gpa", expected.average_student_gpa);
+    json.field("age_18_25", expected.age_18_25);
+    json.endObject();
+    json.key("queries").beginArray();
+    for (const Query& q : queries) {
+      json.beginObject();
+      json.field("query", q.name);
+      json.field("aos_ms", q.aos_ms);
+      json.field("soa_scalar_ms", q.soa_scalar_ms);
+      json.field("soa_simd_ms", q.soa_simd_ms);
+      json.field("speedup_vs_aos", q.aos_ms / q.soa_simd_ms);
+      json.field("records_per_sec", static_cast<double>(records) / (q.soa_simd_ms / 1e3));
+      json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    std::cout << '\n';
+    return match ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "record_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
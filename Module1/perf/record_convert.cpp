@@ -0,0 +1,104 @@
+/**
+ * Converts personal-information records between CSV and the binary record
+ * file format (see record_file.h), and generates synthetic CSV input
+ *
+ * Usage:
+ *   record_convert generate N OUT.csv
+ *   record_convert to-binary IN.csv OUT.rec
+ *   record_convert to-csv IN.rec OUT.csv
+ */
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "posix_io.h"
+#include "record_csv.h"
+#include "record_file.h"
+#include "record_gen.h"
+#include "record_store.h"
+
+namespace {
+
+/**
+ * Writes CSV text in large blocks
+ */
+class CsvWriter {
+ public:
+  explicit CsvWriter(const std::string& path) : out_(path, std::ios::binary | std::ios::trunc), path_(path) {
+    if (!out_) {
+      throw std::runtime_error("cannot write " + path);
+    }
+    buffer_.append(csc450::records::csv::kHeader);
+    buffer_.push_back('\n');
+  }
+
+  void add(const csc450::records::PersonRecord& record) {
+    csc450::records::csv::appendLine(buffer_, record);
+    if (buffer_.size() >= kFlushBytes) {
+      flush();
+    }
+  }
+
+  void close() {
+    flush();
+    out_.close();
+    if (!out_) {
+      throw std::runtime_error("cannot write " + path_);
+    }
+  }
+
+ private:
+  static constexpr size_t kFlushBytes = 1 << 20;
+
+  void flush() {
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+  }
+
+  std::ofstream out_;
+  std::string path_;
+  std::string buffer_;
+};
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    const std::string command = argc > 1 ? argv[1] : "";
+    if (command == "generate" && argc == 4) {
+      const unsigned long long count = std::strtoull(argv[2], nullptr, 10);
+      CsvWriter writer(argv[3]);
+      for (unsigned long long i = 0; i < count; ++i) {
+        writer.add(csc450::records::syntheticPerson(i));
+      }
+      writer.close();
+    } else if (command == "to-binary" && argc == 4) {
+      csc450::records::RecordStore store;
+      csc450::records::csv::parse(csc450::io::readFile(argv[2]), store);
+      csc450::records::writeRecordFile(store, argv[3]);
+      std::cout << store.size() << " records written to " << argv[3] << '\n';
+    } else if (command == "to-csv" && argc == 4) {
+      const csc450::records::RecordFile file(argv[2]);
+      CsvWriter writer(argv[3]);
+      for (size_t i = 0; i < file.size(); ++i) {
+        writer.add(file.get(i));
+      }
+      writer.close();
+      std::cout << file.size() << " records written to " << argv[3] << '\n';
+    } else {
+      std::cerr << "Usage: " << argv[0] << " generate N OUT.csv\n"
+                << "       " << argv[0] << " to-binary IN.csv OUT.rec\n"
+                << "       " << argv[0] << " to-csv IN.rec OUT.csv\n";
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+
+  } catch (const std::exception& e) {
+    std::cerr << "record_convert failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
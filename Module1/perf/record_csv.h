@@ -0,0 +1,234 @@
+/**
+ * CSV text form of the personal-information records
+ *
+ * One header line, then one record per line:
+ *
+ *     name,birthdate,age,height,grade,is_student,student_id,ssn,gpa,credit_hours
+ *     John Doe,1990-05-15,33,5.9,A,true,12345,123456789,3.85,15
+ *
+ * Fields may be double-quoted (RFC 4180: "" inside quotes is a quote), so
+ * names containing commas, quotes or line breaks survive a round trip; a
+ * record ends at the first newline outside quotes. Numbers are written with
+ * std::to_chars in shortest round-trip form and read back with
+ * std::from_chars, so a store written and re-read compares equal. Parsing
+ * rejects malformed lines with the line number instead of skipping them
+ * (ERR62-CPP: detect errors when converting a string to a number).
+ */
+
+#ifndef CSC450_MODULE1_PERF_RECORD_CSV_H_
+#define CSC450_MODULE1_PERF_RECORD_CSV_H_
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "record_store.h"
+
+namespace csc450::records::csv {
+
+inline constexpr std::string_view kHeader = "name,birthdate,age,height,grade,is_student,student_id,ssn,gpa,credit_hours";
+inline constexpr size_t kFields = 10;
+
+namespace detail {
+
+inline void appendText(std::string& out, std::string_view text) {
+  if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+    out.append(text);
+    return;
+  }
+  out.push_back('"');
+  for (const char c : text) {
+    if (c == '"') {
+      out.push_back('"');
+    }
+    out.push_back(c);
+  }
+  out.push_back('"');
+}
+
+template <typename T>
+void appendNumber(std::string& out, T value) {
+  char digits[32];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  out.append(digits, static_cast<size_t>(result.ptr - digits));
+}
+
+[[noreturn]] inline void parseError(size_t line, const char* what) {
+  throw std::runtime_error("CSV line " + std::to_string(line) + ": " + what);
+}
+
+template <typename T>
+T parseNumber(std::string_view field, size_t line, const char* name) {
+  T value{};
+  const auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+  if (ec != std::errc() || ptr != field.data() + field.size()) {
+    parseError(line, name);
+  }
+  return value;
+}
+
+inline bool parseBool(std::string_view field, size_t line) {
+  if (field == "true" || field == "1" || field == "yes" || field == "Yes") {
+    return true;
+  }
+  if (field == "false" || field == "0" || field == "no" || field == "No") {
+    return false;
+  }
+  parseError(line, "is_student is not a boolean");
+}
+
+/**
+ * Splits one record into fields. Unquoted fields are views into the line;
+ * quoted fields are unescaped into `scratch`, which must outlive them.
+ * Returns the number of fields found (at most kFields + 1).
+ */
+inline size_t splitLine(std::string_view line, std::string_view (&fields)[kFields + 1], std::string (&scratch)[kFields + 1], size_t line_number) {
+  size_t count = 0;
+  size_t pos = 0;
+  for (;;) {
+    if (count == kFields + 1) {
+      return count;
+    }
+    if (pos < line.size() && line[pos] == '"') {
+      std::string& text = scratch[count];
+      text.clear();
+      ++pos;
+      for (;;) {
+        if (pos >= line.size()) {
+          parseError(line_number, "unterminated quoted field");
+        }
+        if (line[pos] == '"') {
+          if (pos + 1 < line.size() && line[pos + 1] == '"') {
+            text.push_back('"');
+            pos += 2;
+            continue;
+          }
+          ++pos;
+          break;
+        }
+        text.push_back(line[pos++]);
+      }
+      fields[count++] = text;
+      if (pos < line.size() && line[pos] != ',') {
+        parseError(line_number, "text after closing quote");
+      }
+    } else {
+      const size_t comma = line.find(',', pos);
+      const size_t end = comma == std::string_view::npos ? line.size() : comma;
+      fields[count++] = line.substr(pos, end - pos);
+      pos = end;
+    }
+    if (pos >= line.size()) {
+      return count;
+    }
+    ++pos;  // skip the comma
+  }
+}
+
+/**
+ * End of the record starting at pos: the first '\n' outside double quotes,
+ * or text.size(). An escaped "" flips the quote state twice, so counting
+ * quotes per segment is enough.
+ */
+inline size_t recordEnd(std::string_view text, size_t pos) {
+  bool quoted = false;
+  for (;;) {
+    const void* hit = std::memchr(text.data() + pos, '\n', text.size() - pos);
+    const size_t newline = hit != nullptr ? static_cast<size_t>(static_cast<const char*>(hit) - text.data()) : text.size();
+    for (size_t i = pos; i < newline; ++i) {
+      quoted = quoted != (text[i] == '"');
+    }
+    if (!quoted || newline == text.size()) {
+      return newline;
+    }
+    pos = newline + 1;  // the newline belongs to a quoted field
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Appends one record as a CSV line (with '\n')
+ */
+inline void appendLine(std::string& out, const PersonRecord& p) {
+  detail::appendText(out, p.name);
+  out.push_back(',');
+  detail::appendText(out, p.birthdate);
+  out.push_back(',');
+  detail::appendNumber(out, p.age);
+  out.push_back(',');
+  detail::appendNumber(out, p.height);
+  out.push_back(',');
+  detail::appendText(out, std::string_view(&p.grade, 1));
+  out.append(p.is_student ? ",true," : ",false,");
+  detail::appendNumber(out, p.student_id);
+  out.push_back(',');
+  detail::appendNumber(out, p.ssn);
+  out.push_back(',');
+  detail::appendNumber(out, p.gpa);
+  out.push_back(',');
+  detail::appendNumber(out, p.credit_hours);
+  out.push_back('\n');
+}
+
+/**
+ * Parses a whole CSV document (header line first) and appends every record
+ * to the store; returns how many were added. Throws std::runtime_error with
+ * the line number on the first malformed line.
+ */
+inline size_t parse(std::string_view text, RecordStore& store) {
+  size_t line_number = 0;  // first physical line of the current record
+  size_t next_line = 1;
+  size_t added = 0;
+  std::string_view fields[kFields + 1];
+  std::string scratch[kFields + 1];
+  PersonRecord record;
+  size_t pos = 0;
+  while (pos < text.size()) {
+    const size_t end = detail::recordEnd(text, pos);
+    std::string_view line = text.substr(pos, end - pos);
+    pos = end + 1;
+    line_number = next_line;
+    next_line += 1 + static_cast<size_t>(std::count(line.begin(), line.end(), '\n'));
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    if (line_number == 1) {
+      if (line != kHeader) {
+        detail::parseError(line_number, "unexpected header");
+      }
+      continue;
+    }
+    if (line.empty()) {
+      continue;
+    }
+    if (detail::splitLine(line, fields, scratch, line_number) != kFields) {
+      detail::parseError(line_number, "expected 10 fields");
+    }
+    record.name.assign(fields[0]);
+    record.birthdate.assign(fields[1]);
+    record.age = detail::parseNumber<int>(fields[2], line_number, "bad age");
+    record.height = detail::parseNumber<double>(fields[3], line_number, "bad height");
+    if (fields[4].size() != 1) {
+      detail::parseError(line_number, "grade must be one character");
+    }
+    record.grade = fields[4][0];
+    record.is_student = detail::parseBool(fields[5], line_number);
+    record.student_id = detail::parseNumber<unsigned int>(fields[6], line_number, "bad student_id");
+    record.ssn = detail::parseNumber<long long>(fields[7], line_number, "bad ssn");
+    record.gpa = detail::parseNumber<float>(fields[8], line_number, "bad gpa");
+    record.credit_hours = detail::parseNumber<short>(fields[9], line_number, "bad credit_hours");
+    store.append(record);
+    ++added;
+  }
+  return added;
+}
+
+}  // namespace csc450::records::csv
+
+#endif  // CSC450_MODULE1_PERF_RECORD_CSV_H_
@@ -0,0 +1,371 @@
+/**
+ * Memory-mappable binary file of personal-information records
+ *
+ * Loading records from CSV means parsing every byte before the first query
+ * can run. This format stores the RecordStore columns exactly as they sit
+ * in memory, so opening a file is an mmap() plus a check of a few header
+ * fields, and queries run straight over the mapped pages.
+ *
+ * Layout (all integers little-endian, every block 64-byte aligned):
+ *
+ *     Header          64 bytes: magic "CSC450RF", version major/minor,
+ *                     record count, column count, string heap offset and
+ *                     size, total file size
+ *     Directory       one 24-byte ColumnEntry per column: column id,
+ *                     element size, offset, size in bytes
+ *     Column blocks   record_count elements each, in column id order
+ *     String heap     the StringArena bytes; name and birthdate columns
+ *                     hold {offset, length} references into it
+ *
+ * Versioning: a reader accepts any file with its major version. Minor
+ * versions may append columns with new ids, and readers skip ids they do
+ * not know. Every known column must be present with the expected element
+ * size and length.
+ *
+ * Nothing in a file is trusted. Header and directory are validated on open
+ * (sizes, alignment, every block inside the file), and string references
+ * are bounds-checked when they are read, so a corrupt or hostile file
+ * raises std::runtime_error instead of reading outside the mapping
+ * (ARR30-C: do not form or use out-of-bounds pointers or array subscripts).
+ */
+
+#ifndef CSC450_MODULE1_PERF_RECORD_FILE_H_
+#define CSC450_MODULE1_PERF_RECORD_FILE_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "posix_io.h"
+#include "record_store.h"
+
+namespace csc450::records {
+
+static_assert(std::endian::native == std::endian::little, "record files are little-endian and mapped without byte swapping");
+
+namespace file {
+
+inline constexpr char kMagic[8] = {'C', 'S', 'C', '4', '5', '0', 'R', 'F'};
+inline constexpr uint16_t kVersionMajor = 1;
+inline constexpr uint16_t kVersionMinor = 0;
+inline constexpr uint64_t kAlignment = 64;
+
+enum Column : uint32_t { kName, kBirthdate, kAge, kHeight, kGrade, kIsStudent, kStudentId, kSsn, kGpa, kCreditHours, kColumnCount };
+
+inline constexpr uint32_t kElementBytes[kColumnCount] = {sizeof(StringRef), sizeof(StringRef), sizeof(int32_t), sizeof(double), sizeof(char),
+                                                         sizeof(uint8_t),   sizeof(uint32_t),  sizeof(int64_t), sizeof(float),  sizeof(int16_t)};
+
+struct Header {
+  char magic[8];
+  uint16_t version_major;
+  uint16_t version_minor;
+  uint32_t header_bytes;
+  uint64_t record_count;
+  uint32_t column_count;
+  uint32_t reserved;
+  uint64_t heap_offset;
+  uint64_t heap_bytes;
+  uint64_t file_bytes;
+  uint64_t reserved2;
+};
+static_assert(sizeof(Header) == 64);
+
+struct ColumnEntry {
+  uint32_t column;
+  uint32_t element_bytes;
+  uint64_t offset;
+  uint64_t bytes;
+};
+static_assert(sizeof(ColumnEntry) == 24);
+
+inline constexpr uint64_t alignUp(uint64_t value) noexcept {
+  return (value + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+namespace detail {
+
+inline void writeZeros(int fd, size_t size) {
+  static const char kZeros[kAlignment] = {};
+  io::writeAllOrThrow(fd, kZeros, size);
+}
+
+}  // namespace detail
+
+}  // namespace file
+
+/**
+ * Writes the store to path in record-file format, replacing any file. The
+ * bytes go to path + ".tmp", are fsync()ed, and the temporary is rename()d
+ * over path, so a failed write never leaves a truncated file behind and a
+ * RecordFile still mapping the old file keeps its (now unlinked) inode
+ * instead of faulting with SIGBUS on a truncated one.
+ */
+inline void writeRecordFile(const RecordStore& store, const std::string& path) {
+  using namespace file;
+  const uint64_t count = store.size();
+  const void* columns[kColumnCount] = {store.names().data(),  store.birthdates().data(), store.ages().data(), store.heights().data(),
+                                       store.grades().data(), store.students().data(),   store.studentIds().data(),
+                                       store.ssns().data(),   store.gpas().data(),       store.creditHours().data()};
+
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version_major = kVersionMajor;
+  header.version_minor = kVersionMinor;
+  header.header_bytes = sizeof(Header);
+  header.record_count = count;
+  header.column_count = kColumnCount;
+  ColumnEntry directory[kColumnCount];
+  uint64_t offset = alignUp(sizeof(Header) + sizeof(directory));
+  for (uint32_t c = 0; c < kColumnCount; ++c) {
+    directory[c] = ColumnEntry{c, kElementBytes[c], offset, count * kElementBytes[c]};
+    offset = alignUp(offset + directory[c].bytes);
+  }
+  header.heap_offset = offset;
+  header.heap_bytes = store.strings().size();
+  header.file_bytes = offset + header.heap_bytes;
+
+  const std::string temporary = path + ".tmp";
+  const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), "open " + temporary);
+  }
+  try {
+    io::writeAllOrThrow(fd, &header, sizeof(header));
+    io::writeAllOrThrow(fd, directory, sizeof(directory));
+    uint64_t position = sizeof(header) + sizeof(directory);
+    for (uint32_t c = 0; c < kColumnCount; ++c) {
+      detail::writeZeros(fd, directory[c].offset - position);
+      io::writeAllOrThrow(fd, columns[c], directory[c].bytes);
+      position = directory[c].offset + directory[c].bytes;
+    }
+    detail::writeZeros(fd, header.heap_offset - position);
+    io::writeAllOrThrow(fd, store.strings().data(), header.heap_bytes);
+    if (::fsync(fd) != 0) {
+      throw std::system_error(errno, std::generic_category(), "fsync " + temporary);
+    }
+  } catch (...) {
+    ::close(fd);
+    ::unlink(temporary.c_str());
+    throw;
+  }
+  if (::close(fd) != 0) {
+    const int error = errno;
+    ::unlink(temporary.c_str());
+    throw std::system_error(error, std::generic_category(), "close " + temporary);
+  }
+  if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+    const int error = errno;
+    ::unlink(temporary.c_str());
+    throw std::system_error(error, std::generic_category(), "rename " + temporary + " to " + path);
+  }
+}
+
+/**
+ * A record file mapped read-only; columns are views into the mapping
+ */
+class RecordFile {
+ public:
+  explicit RecordFile(const std::string& path) : path_(path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+    struct stat info{};
+    if (::fstat(fd, &info) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "fstat " + path);
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ < sizeof(file::Header)) {
+      ::close(fd);
+      corrupt("shorter than the header");
+    }
+    void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+      throw std::system_error(error, std::generic_category(), "mmap " + path);
+    }
+    base_ = static_cast<const unsigned char*>(mapping);
+    try {
+      validate();
+    } catch (...) {
+      ::munmap(const_cast<unsigned char*>(base_), size_);
+      throw;
+    }
+  }
+
+  ~RecordFile() {
+    ::munmap(const_cast<unsigned char*>(base_), size_);
+  }
+
+  RecordFile(const RecordFile&) = delete;
+  RecordFile& operator=(const RecordFile&) = delete;
+
+  [[nodiscard]] size_t size() const noexcept {
+    return count_;
+  }
+  [[nodiscard]] uint16_t versionMinor() const noexcept {
+    return header().version_minor;
+  }
+
+  [[nodiscard]] std::string_view name(size_t i) const {
+    return text(names()[i]);
+  }
+  [[nodiscard]] std::string_view birthdate(size_t i) const {
+    return text(birthdates()[i]);
+  }
+
+  [[nodiscard]] PersonRecord get(size_t i) const {
+    PersonRecord record;
+    record.name = std::string(name(i));
+    record.birthdate = std::string(birthdate(i));
+    record.age = ages()[i];
+    record.height = heights()[i];
+    record.grade = grades()[i];
+    record.is_student = students()[i] != 0;
+    record.student_id = studentIds()[i];
+    record.ssn = ssns()[i];
+    record.gpa = gpas()[i];
+    record.credit_hours = creditHours()[i];
+    return record;
+  }
+
+  [[nodiscard]] std::span<const StringRef> names() const noexcept {
+    return column<StringRef>(file::kName);
+  }
+  [[nodiscard]] std::span<const StringRef> birthdates() const noexcept {
+    return column<StringRef>(file::kBirthdate);
+  }
+  [[nodiscard]] std::span<const int32_t> ages() const noexcept {
+    return column<int32_t>(file::kAge);
+  }
+  [[nodiscard]] std::span<const double> heights() const noexcept {
+    return column<double>(file::kHeight);
+  }
+  [[nodiscard]] std::span<const char> grades() const noexcept {
+    return column<char>(file::kGrade);
+  }
+  [[nodiscard]] std::span<const uint8_t> students() const noexcept {
+    return column<uint8_t>(file::kIsStudent);
+  }
+  [[nodiscard]] std::span<const uint32_t> studentIds() const noexcept {
+    return column<uint32_t>(file::kStudentId);
+  }
+  [[nodiscard]] std::span<const int64_t> ssns() const noexcept {
+    return column<int64_t>(file::kSsn);
+  }
+  [[nodiscard]] std::span<const float> gpas() const noexcept {
+    return column<float>(file::kGpa);
+  }
+  [[nodiscard]] std::span<const int16_t> creditHours() const noexcept {
+    return column<int16_t>(file::kCreditHours);
+  }
+
+  // Same scans as RecordStore, over the mapped columns
+  [[nodiscard]] double averageGpa() const noexcept {
+    return count_ == 0 ? 0.0 : scan::kernels().sum(gpas().data(), count_) / static_cast<double>(count_);
+  }
+  [[nodiscard]] size_t countStudents() const noexcept {
+    return scan::kernels().count_non_zero(students().data(), count_);
+  }
+  [[nodiscard]] double averageStudentGpa() const noexcept {
+    const scan::MaskedSum students_gpa = scan::kernels().sum_where(gpas().data(), students().data(), count_);
+    return students_gpa.count == 0 ? 0.0 : students_gpa.sum / static_cast<double>(students_gpa.count);
+  }
+  [[nodiscard]] size_t countAgeBetween(int lo, int hi) const noexcept {
+    return scan::kernels().count_in_range(ages().data(), count_, lo, hi);
+  }
+
+ private:
+  [[noreturn]] void corrupt(const char* what) const {
+    throw std::runtime_error(path_ + ": not a valid record file (" + what + ")");
+  }
+
+  [[nodiscard]] const file::Header& header() const noexcept {
+    return *reinterpret_cast<const file::Header*>(base_);
+  }
+
+  template <typename T>
+  [[nodiscard]] std::span<const T> column(file::Column c) const noexcept {
+    return std::span<const T>(reinterpret_cast<const T*>(base_ + offsets_[c]), count_);
+  }
+
+  [[nodiscard]] std::string_view text(StringRef ref) const {
+    if (ref.offset > heap_bytes_ || ref.length > heap_bytes_ - ref.offset) {
+      corrupt("string reference outside the heap");
+    }
+    return std::string_view(reinterpret_cast<const char*>(base_ + heap_offset_) + ref.offset, ref.length);
+  }
+
+  // Checks that every offset and size stays inside the mapping
+  void validate() {
+    const file::Header& h = header();
+    if (std::memcmp(h.magic, file::kMagic, sizeof(file::kMagic)) != 0) {
+      corrupt("bad magic");
+    }
+    if (h.version_major != file::kVersionMajor) {
+      corrupt("unsupported major version");
+    }
+    if (h.header_bytes < sizeof(file::Header) || h.header_bytes % alignof(file::ColumnEntry) != 0 || h.header_bytes > size_ || h.file_bytes != size_) {
+      corrupt("header sizes do not match the file");
+    }
+    if (h.column_count > (size_ - h.header_bytes) / sizeof(file::ColumnEntry)) {
+      corrupt("directory outside the file");
+    }
+    if (h.heap_offset > size_ || h.heap_bytes > size_ - h.heap_offset) {
+      corrupt("string heap outside the file");
+    }
+    count_ = h.record_count;
+    heap_offset_ = h.heap_offset;
+    heap_bytes_ = h.heap_bytes;
+
+    bool seen[file::kColumnCount] = {};
+    const auto* directory = reinterpret_cast<const file::ColumnEntry*>(base_ + h.header_bytes);
+    for (uint32_t i = 0; i < h.column_count; ++i) {
+      const file::ColumnEntry& entry = directory[i];
+      if (entry.column >= file::kColumnCount) {
+        continue;  // added by a newer minor version
+      }
+      if (entry.element_bytes != file::kElementBytes[entry.column] || entry.bytes / entry.element_bytes != count_ || entry.bytes % entry.element_bytes != 0) {
+        corrupt("column size does not match the record count");
+      }
+      if (entry.offset % file::kAlignment != 0 || entry.offset > size_ || entry.bytes > size_ - entry.offset) {
+        corrupt("column block misaligned or outside the file");
+      }
+      offsets_[entry.column] = entry.offset;
+      seen[entry.column] = true;
+    }
+    for (const bool present : seen) {
+      if (!present) {
+        corrupt("missing column");
+      }
+    }
+  }
+
+  std::string path_;
+  const unsigned char* base_ = nullptr;
+  size_t size_ = 0;
+  size_t count_ = 0;
+  uint64_t heap_offset_ = 0;
+  uint64_t heap_bytes_ = 0;
+  uint64_t offsets_[file::kColumnCount] = {};
+};
+
+}  // namespace csc450::records
+
+#endif  // CSC450_MODULE1_PERF_RECORD_FILE_H_
@@ -0,0 +1,126 @@
+/**
+ * Start-up cost: parsing CSV vs mapping a binary record file
+ *
+ * Writes --records synthetic records as CSV, then measures
+ *   csv_load      read the file and parse it into a RecordStore
+ *   convert       write that store as a record file (record_file.h)
+ *   binary_open   mmap the record file and validate header and directory
+ * and, for both sources, the time from nothing to the first answer
+ * (average GPA). The binary path reads only the pages the query touches.
+ * Answers from the two sources are compared. Files go to --dir and are
+ * removed afterwards. Both files are in the page cache when they are read,
+ * so these are warm-cache numbers.
+ *
+ * Usage: record_file_bench [--records N] [--dir PATH]
+ */
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "bench_util.h"
+#include "posix_io.h"
+#include "record_csv.h"
+#include "record_file.h"
+#include "record_gen.h"
+#include "record_store.h"
+
+namespace {
+
+void writeCsv(const std::string& path, size_t records) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  std::string buffer(csc450::records::csv::kHeader);
+  buffer.push_back('\n');
+  for (size_t i = 0; i < records; ++i) {
+    csc450::records::csv::appendLine(buffer, csc450::records::syntheticPerson(i));
+    if (buffer.size() >= (1 << 20)) {
+      out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      buffer.clear();
+    }
+  }
+  out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  out.close();
+  if (!out) {
+    throw std::runtime_error("cannot write " + path);
+  }
+}
+
+size_t fileBytes(const std::string& path) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  return static_cast<size_t>(in.tellg());
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    size_t records = 10000000;
+    std::string dir = "/tmp";
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--records" && i + 1 < argc) {
+        records = std::strtoull(argv[++i], nullptr, 10);
+      } else if (arg == "--dir" && i + 1 < argc) {
+        dir = argv[++i];
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--records N] [--dir PATH]\n";
+        return EXIT_FAILURE;
+      }
+    }
+    const std::string stem = dir + "/record_file_bench." + std::to_string(::getpid());
+    const std::string csv_path = stem + ".csv";
+    const std::string rec_path = stem + ".rec";
+    writeCsv(csv_path, records);
+
+    auto start = csc450::bench::Clock::now();
+    const std::string text = csc450::io::readFile(csv_path);
+    const double read_s = csc450::bench::secondsSince(start);
+    csc450::records::RecordStore store;
+    csc450::records::csv::parse(text, store);
+    const double csv_load_s = csc450::bench::secondsSince(start);
+    const double csv_gpa = store.averageGpa();
+    const double csv_first_answer_s = csc450::bench::secondsSince(start);
+
+    start = csc450::bench::Clock::now();
+    csc450::records::writeRecordFile(store, rec_path);
+    const double convert_s = csc450::bench::secondsSince(start);
+
+    start = csc450::bench::Clock::now();
+    const csc450::records::RecordFile file(rec_path);
+    const double open_s = csc450::bench::secondsSince(start);
+    const double file_gpa = file.averageGpa();
+    const double binary_first_answer_s = csc450::bench::secondsSince(start);
+
+    const bool match = file.size() == store.size() && file_gpa == csv_gpa && file.countStudents() == store.countStudents() &&
+                       file.countAgeBetween(18, 25) == store.countAgeBetween(18, 25) && (file.size() == 0 || file.get(file.size() - 1).name == store.get(store.size() - 1).name);
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "record_file_load");
+    json.field("records", records);
+    json.field("results_match", match);
+    json.field("csv_bytes", fileBytes(csv_path));
+    json.field("binary_bytes", fileBytes(rec_path));
+    json.field("csv_read_ms", read_s * 1e3);
+    json.field("csv_load_ms", csv_load_s * 1e3);
+    json.field("csv_first_answer_ms", csv_first_answer_s * 1e3);
+    json.field("convert_ms", convert_s * 1e3);
+    json.field("binary_open_ms", open_s * 1e3);
+    json.field("binary_first_answer_ms", binary_first_answer_s * 1e3);
+    json.field("first_answer_speedup", csv_first_answer_s / binary_first_answer_s);
+    json.endObject();
+    std::cout << '\n';
+    ::unlink(csv_path.c_str());
+    ::unlink(rec_path.c_str());
+    return match ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "record_file_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
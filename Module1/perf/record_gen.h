@@ -0,0 +1,55 @@
+/**
+ * Deterministic synthetic personal-information records
+ *
+ * The Module 1 benchmarks need millions of records shaped like the one in
+ * displayPersonalInfo(); syntheticPerson(i) always returns the same record
+ * for the same index, so every tool and every run sees identical data.
+ */
+
+#ifndef CSC450_MODULE1_PERF_RECORD_GEN_H_
+#define CSC450_MODULE1_PERF_RECORD_GEN_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
+
+#include "record_store.h"
+
+namespace csc450::records {
+
+inline uint64_t mix64(uint64_t x) noexcept {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ull;
+  x ^= x >> 33;
+  return x;
+}
+
+inline PersonRecord syntheticPerson(uint64_t index) {
+  static const char* const kFirst[] = {"John", "Maria", "Wei", "Aisha", "Carlos", "Olga", "Kenji", "Fatima", "Liam", "Priya", "Noah", "Sofia", "Bartholomew"};
+  static const char* const kLast[] = {"Doe", "Garcia", "Chen", "Okafor", "Silva", "Ivanova", "Tanaka", "Haddad", "Murphy", "Patel", "Kim", "Rossi",
+                                      "Vanderberg-Castellanos"};
+  static const char kGrades[] = {'A', 'A', 'B', 'B', 'B', 'C', 'C', 'D', 'F'};
+  const uint64_t r = mix64(index + 1);
+
+  PersonRecord p;
+  p.name = std::string(kFirst[r % std::size(kFirst)]) + ' ' + kLast[(r >> 8) % std::size(kLast)];
+  p.age = 17 + static_cast<int>((r >> 16) % 60);
+  char date[16];
+  std::snprintf(date, sizeof(date), "%04d-%02d-%02d", 2024 - p.age, 1 + static_cast<int>((r >> 24) % 12), 1 + static_cast<int>((r >> 28) % 28));
+  p.birthdate = date;
+  p.height = 4.8 + static_cast<double>((r >> 32) % 180) / 100.0;
+  p.grade = kGrades[(r >> 40) % std::size(kGrades)];
+  p.is_student = p.age < 30 || (r >> 44) % 5 == 0;
+  p.student_id = p.is_student ? static_cast<unsigned>(10000 + index) : 0u;
+  p.ssn = 100000000LL + static_cast<long long>(mix64(index ^ 0x5ca1ab1e) % 899999999);
+  p.gpa = static_cast<float>((r >> 48) % 401) / 100.0f;
+  p.credit_hours = static_cast<short>(p.is_student ? 3 + (r >> 56) % 16 : 0);
+  return p;
+}
+
+}  // namespace csc450::records
+
+#endif  // CSC450_MODULE1_PERF_RECORD_GEN_H_
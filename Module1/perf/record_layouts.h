@@ -0,0 +1,93 @@
+/**
+ * Layout descriptions of the Module 1 record structs, and their reordered twins
+ *
+ * PersonFields is displayPersonalInfo()'s eight scalar fields as a struct,
+ * in the order ../cert_compliant_datatypes.cpp declares them; PersonRecord
+ * (record_store.h) adds the two strings in front. Declaration order puts
+ * 4-byte fields before 8-byte ones and 1-byte fields before 4-byte ones,
+ * so both carry padding; the *Packed twins use type_layout.h's suggested
+ * order and are held to it by static_assert, so a new field that breaks
+ * the packing fails the build instead of quietly growing every record.
+ * GradeGroup (record_ops.h) and StringRef are listed for the report: one
+ * only has tail padding no order removes, the other has none.
+ *
+ * Members keep value semantics and default initializers (EXP53-CPP: do not
+ * read uninitialized memory, even from a default-constructed record).
+ */
+
+#ifndef CSC450_MODULE1_PERF_RECORD_LAYOUTS_H_
+#define CSC450_MODULE1_PERF_RECORD_LAYOUTS_H_
+
+#include <string>
+
+#include "record_ops.h"
+#include "record_store.h"
+#include "type_layout.h"
+
+namespace csc450::layout {
+
+struct PersonFields {
+  int age = 0;
+  double height = 0;
+  char grade = 'A';
+  bool is_student = false;
+  unsigned int student_id = 0;
+  long long ssn = 0;
+  float gpa = 0;
+  short credit_hours = 0;
+};
+
+struct PersonFieldsPacked {
+  double height = 0;
+  long long ssn = 0;
+  int age = 0;
+  unsigned int student_id = 0;
+  float gpa = 0;
+  short credit_hours = 0;
+  char grade = 'A';
+  bool is_student = false;
+};
+
+struct PersonRecordPacked {
+  std::string name;
+  std::string birthdate;
+  double height = 0;
+  long long ssn = 0;
+  int age = 0;
+  unsigned int student_id = 0;
+  float gpa = 0;
+  short credit_hours = 0;
+  char grade = 'A';
+  bool is_student = false;
+};
+
+#define CSC450_PERSON_SCALARS(Struct)                                                                                                          \
+  CSC450_LAYOUT_FIELD(Struct, age), CSC450_LAYOUT_FIELD(Struct, height), CSC450_LAYOUT_FIELD(Struct, grade),                                   \
+      CSC450_LAYOUT_FIELD(Struct, is_student), CSC450_LAYOUT_FIELD(Struct, student_id), CSC450_LAYOUT_FIELD(Struct, ssn), CSC450_LAYOUT_FIELD(Struct, gpa), \
+      CSC450_LAYOUT_FIELD(Struct, credit_hours)
+
+inline constexpr auto kPersonFieldsLayout = describe<PersonFields>("PersonFields", CSC450_PERSON_SCALARS(PersonFields));
+inline constexpr auto kPersonFieldsPackedLayout = describe<PersonFieldsPacked>("PersonFieldsPacked", CSC450_PERSON_SCALARS(PersonFieldsPacked));
+
+inline constexpr auto kPersonRecordLayout = describe<records::PersonRecord>("PersonRecord", CSC450_LAYOUT_FIELD(records::PersonRecord, name),
+                                                                            CSC450_LAYOUT_FIELD(records::PersonRecord, birthdate),
+                                                                            CSC450_PERSON_SCALARS(records::PersonRecord));
+inline constexpr auto kPersonRecordPackedLayout = describe<PersonRecordPacked>("PersonRecordPacked", CSC450_LAYOUT_FIELD(PersonRecordPacked, name),
+                                                                               CSC450_LAYOUT_FIELD(PersonRecordPacked, birthdate),
+                                                                               CSC450_PERSON_SCALARS(PersonRecordPacked));
+
+#undef CSC450_PERSON_SCALARS
+
+inline constexpr auto kGradeGroupLayout =
+    describe<records::ops::GradeGroup>("GradeGroup", CSC450_LAYOUT_FIELD(records::ops::GradeGroup, grade), CSC450_LAYOUT_FIELD(records::ops::GradeGroup, count),
+                                       CSC450_LAYOUT_FIELD(records::ops::GradeGroup, gpa_sum));
+inline constexpr auto kStringRefLayout =
+    describe<records::StringRef>("StringRef", CSC450_LAYOUT_FIELD(records::StringRef, offset), CSC450_LAYOUT_FIELD(records::StringRef, length));
+
+static_assert(sizeof(PersonFieldsPacked) == suggestReordering(kPersonFieldsLayout).size, "PersonFieldsPacked no longer matches the suggested order");
+static_assert(sizeof(PersonRecordPacked) == suggestReordering(kPersonRecordLayout).size, "PersonRecordPacked no longer matches the suggested order");
+static_assert(paddingBytes(kPersonFieldsPackedLayout) < paddingBytes(kPersonFieldsLayout));
+
+}  // namespace csc450::layout
+
+#endif  // CSC450_MODULE1_PERF_RECORD_LAYOUTS_H_
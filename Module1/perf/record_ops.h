@@ -0,0 +1,290 @@
+/**
+ * Parallel sort and group-by over the columnar record store
+ *
+ * Reporting over many student records needs three things the course code
+ * does one record at a time: order by student id, order by name, and
+ * per-grade totals. Each operation here works on raw columns (spans), so it
+ * runs equally over a RecordStore or a mapped RecordFile (the conveniences
+ * at the end take either), and splits the rows into one contiguous slice
+ * per thread:
+ *
+ *   sortedByKey      LSD radix sort of a uint32_t column (student ids),
+ *                    8-bit digits. Per pass every thread histograms its
+ *                    slice, a prefix over (digit, thread) gives each thread
+ *                    its own write positions, and the threads scatter in
+ *                    parallel. The result is stable; passes where every
+ *                    key has the same digit are skipped.
+ *   sortedByString   merge sort of a string column (arena references, or
+ *                    plain string_views for a RecordFile's heap): each
+ *                    thread stable-sorts its slice, then slices are merged
+ *                    pairwise, in parallel, until one run is left.
+ *   groupByGrade     count and GPA sum per grade; each thread fills a
+ *                    private 256-entry table (cache-line aligned, so no
+ *                    false sharing) and the partials are added at the end.
+ *
+ * Sorts return the row order (a permutation), not reordered columns, so one
+ * sort can drive any number of columns. threads == 0 uses the hardware
+ * concurrency; tiny inputs use fewer threads than asked.
+ */
+
+#ifndef CSC450_MODULE1_PERF_RECORD_OPS_H_
+#define CSC450_MODULE1_PERF_RECORD_OPS_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "record_file.h"
+#include "record_store.h"
+
+namespace csc450::records::ops {
+
+namespace detail {
+
+inline constexpr size_t kMinRowsPerThread = 1 << 14;
+
+inline size_t threadCount(size_t requested, size_t rows) {
+  const size_t wanted = requested != 0 ? requested : std::max(1u, std::thread::hardware_concurrency());
+  return std::clamp<size_t>(rows / kMinRowsPerThread, 1, wanted);
+}
+
+// Rows [begin(t), begin(t + 1)) belong to thread t
+struct Slices {
+  size_t rows;
+  size_t threads;
+  [[nodiscard]] size_t begin(size_t t) const noexcept {
+    return rows * t / threads;
+  }
+};
+
+/**
+ * Runs body(t) for t in [0, threads) on separate threads (t == 0 on the
+ * caller) and waits for all of them
+ */
+template <typename Body>
+void parallelFor(size_t threads, Body&& body) {
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (size_t t = 1; t < threads; ++t) {
+    workers.emplace_back(body, t);
+  }
+  body(size_t{0});
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+inline void checkRowCount(size_t rows) {
+  if (rows > std::numeric_limits<uint32_t>::max()) {
+    throw std::length_error("row order limited to 2^32 - 1 rows");
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Row order that sorts keys ascending (stable)
+ */
+inline std::vector<uint32_t> sortedByKey(std::span<const uint32_t> keys, size_t threads = 0) {
+  detail::checkRowCount(keys.size());
+  const size_t n = keys.size();
+  threads = detail::threadCount(threads, n);
+  const detail::Slices slices{n, threads};
+
+  std::vector<uint32_t> key(keys.begin(), keys.end());
+  std::vector<uint32_t> row(n);
+  std::iota(row.begin(), row.end(), 0u);
+  std::vector<uint32_t> key_out(n);
+  std::vector<uint32_t> row_out(n);
+  std::vector<std::array<size_t, 256>> counts(threads);
+
+  for (int shift = 0; shift < 32; shift += 8) {
+    detail::parallelFor(threads, [&](size_t t) {
+      std::array<size_t, 256>& count = counts[t];
+      count.fill(0);
+      for (size_t i = slices.begin(t); i < slices.begin(t + 1); ++i) {
+        ++count[(key[i] >> shift) & 0xFF];
+      }
+    });
+
+    // Exclusive prefix in (digit, thread) order: thread t's digit-d rows
+    // follow every thread's smaller digits and threads < t's digit d
+    size_t sum = 0;
+    bool one_digit = false;
+    for (size_t d = 0; d < 256; ++d) {
+      const size_t digit_start = sum;
+      for (size_t t = 0; t < threads; ++t) {
+        const size_t c = counts[t][d];
+        counts[t][d] = sum;
+        sum += c;
+      }
+      one_digit = one_digit || sum - digit_start == n;
+    }
+    if (one_digit) {
+      continue;
+    }
+
+    detail::parallelFor(threads, [&](size_t t) {
+      std::array<size_t, 256>& next = counts[t];
+      for (size_t i = slices.begin(t); i < slices.begin(t + 1); ++i) {
+        const size_t at = next[(key[i] >> shift) & 0xFF]++;
+        key_out[at] = key[i];
+        row_out[at] = row[i];
+      }
+    });
+    key.swap(key_out);
+    row.swap(row_out);
+  }
+  return row;
+}
+
+namespace detail {
+
+// Stable parallel merge sort of rows 0..n-1 by text(row); text must not throw
+template <typename Text>
+std::vector<uint32_t> sortByText(size_t n, const Text& text, size_t threads) {
+  checkRowCount(n);
+  threads = threadCount(threads, n);
+  const auto less = [&](uint32_t a, uint32_t b) { return text(a) < text(b); };
+
+  std::vector<uint32_t> order(n);
+  std::iota(order.begin(), order.end(), 0u);
+  std::vector<size_t> runs(threads + 1);
+  const Slices slices{n, threads};
+  for (size_t t = 0; t <= threads; ++t) {
+    runs[t] = slices.begin(t);
+  }
+  parallelFor(threads, [&](size_t t) { std::stable_sort(order.begin() + runs[t], order.begin() + runs[t + 1], less); });
+
+  // Merge neighbouring runs in parallel until one is left; ties keep the
+  // left run first, so the whole sort stays stable
+  std::vector<uint32_t> merged(n);
+  while (runs.size() > 2) {
+    const size_t pairs = (runs.size() - 1) / 2;
+    parallelFor(pairs, [&](size_t p) {
+      const auto at = [&](size_t r) { return static_cast<std::ptrdiff_t>(runs[r]); };
+      std::merge(order.begin() + at(2 * p), order.begin() + at(2 * p + 1), order.begin() + at(2 * p + 1), order.begin() + at(2 * p + 2),
+                 merged.begin() + at(2 * p), less);
+    });
+    if ((runs.size() - 1) % 2 == 1) {
+      std::copy(order.begin() + static_cast<std::ptrdiff_t>(runs[runs.size() - 2]), order.end(),
+                merged.begin() + static_cast<std::ptrdiff_t>(runs[runs.size() - 2]));
+    }
+    std::vector<size_t> next;
+    for (size_t r = 0; r < runs.size(); r += 2) {
+      next.push_back(runs[r]);
+    }
+    if (next.back() != n) {
+      next.push_back(n);
+    }
+    runs.swap(next);
+    order.swap(merged);
+  }
+  return order;
+}
+
+}  // namespace detail
+
+/**
+ * Row order that sorts the strings ascending (byte order, stable)
+ */
+inline std::vector<uint32_t> sortedByString(std::span<const StringRef> refs, const StringArena& arena, size_t threads = 0) {
+  return detail::sortByText(refs.size(), [&](uint32_t row) { return arena.view(refs[row]); }, threads);
+}
+
+inline std::vector<uint32_t> sortedByString(std::span<const std::string_view> texts, size_t threads = 0) {
+  return detail::sortByText(texts.size(), [&](uint32_t row) { return texts[row]; }, threads);
+}
+
+struct GradeGroup {
+  char grade = 0;
+  size_t count = 0;
+  double gpa_sum = 0;
+
+  [[nodiscard]] double averageGpa() const noexcept {
+    return count == 0 ? 0.0 : gpa_sum / static_cast<double>(count);
+  }
+};
+
+/**
+ * Count and GPA sum per grade, in grade order; grades with no rows are left out
+ */
+inline std::vector<GradeGroup> groupByGrade(std::span<const char> grades, std::span<const float> gpas, size_t threads = 0) {
+  if (grades.size() != gpas.size()) {
+    throw std::invalid_argument("grade and gpa columns differ in length");
+  }
+  const size_t n = grades.size();
+  threads = detail::threadCount(threads, n);
+  const detail::Slices slices{n, threads};
+
+  struct alignas(64) Partial {
+    size_t count[256];
+    double gpa_sum[256];
+  };
+  std::vector<Partial> partials(threads);
+  detail::parallelFor(threads, [&](size_t t) {
+    Partial local{};  // accumulate on this thread's stack, publish once
+    for (size_t i = slices.begin(t); i < slices.begin(t + 1); ++i) {
+      const auto g = static_cast<unsigned char>(grades[i]);
+      ++local.count[g];
+      local.gpa_sum[g] += gpas[i];
+    }
+    partials[t] = local;
+  });
+
+  std::vector<GradeGroup> groups;
+  for (size_t g = 0; g < 256; ++g) {
+    GradeGroup group{static_cast<char>(g), 0, 0};
+    for (const Partial& p : partials) {
+      group.count += p.count[g];
+      group.gpa_sum += p.gpa_sum[g];
+    }
+    if (group.count != 0) {
+      groups.push_back(group);
+    }
+  }
+  return groups;
+}
+
+// Store conveniences
+inline std::vector<uint32_t> sortedByStudentId(const RecordStore& store, size_t threads = 0) {
+  return sortedByKey(store.studentIds(), threads);
+}
+
+inline std::vector<uint32_t> sortedByName(const RecordStore& store, size_t threads = 0) {
+  return sortedByString(store.names(), store.strings(), threads);
+}
+
+inline std::vector<GradeGroup> groupByGrade(const RecordStore& store, size_t threads = 0) {
+  return groupByGrade(store.grades(), store.gpas(), threads);
+}
+
+// Mapped-file conveniences; the file's string heap is private, so names are
+// resolved (and bounds-checked) once on the calling thread before sorting
+inline std::vector<uint32_t> sortedByStudentId(const RecordFile& file, size_t threads = 0) {
+  return sortedByKey(file.studentIds(), threads);
+}
+
+inline std::vector<uint32_t> sortedByName(const RecordFile& file, size_t threads = 0) {
+  std::vector<std::string_view> names(file.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    names[i] = file.name(i);
+  }
+  return sortedByString(names, threads);
+}
+
+inline std::vector<GradeGroup> groupByGrade(const RecordFile& file, size_t threads = 0) {
+  return groupByGrade(file.grades(), file.gpas(), threads);
+}
+
+}  // namespace csc450::records::ops
+
+#endif  // CSC450_MODULE1_PERF_RECORD_OPS_H_
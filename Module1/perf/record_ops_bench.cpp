@@ -0,0 +1,187 @@
+/**
+ * Parallel sort and group-by scaling over the columnar record store
+ *
+ * Fills a RecordStore with --records synthetic records and times, at 1, 2,
+ * 4, ... up to --threads threads:
+ *   sort_student_id   ops::sortedByKey (parallel LSD radix sort)
+ *   sort_name         ops::sortedByString (parallel merge sort)
+ *   group_by_grade    ops::groupByGrade (per-thread partial aggregates)
+ * next to a single-threaded std::stable_sort / std::map baseline. Every
+ * result is checked against the baseline, and each run reports its speedup
+ * over one thread and over the baseline.
+ *
+ * Usage: record_ops_bench [--records N] [--threads N] [--repeat N]
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "record_gen.h"
+#include "record_ops.h"
+#include "record_store.h"
+
+namespace {
+
+namespace ops = csc450::records::ops;
+using csc450::records::RecordStore;
+
+bool sameGroups(const std::vector<ops::GradeGroup>& a, const std::vector<ops::GradeGroup>& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (a[i].grade != b[i].grade || a[i].count != b[i].count || std::fabs(a[i].gpa_sum - b[i].gpa_sum) > 1e-9 * std::fmax(1.0, b[i].gpa_sum)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    size_t records = 2000000;
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    int repeat = 3;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--records" && i + 1 < argc) {
+        records = std::strtoull(argv[++i], nullptr, 10);
+      } else if (arg == "--threads" && i + 1 < argc) {
+        max_threads = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+      } else if (arg == "--repeat" && i + 1 < argc) {
+        repeat = std::max(1, std::atoi(argv[++i]));
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--records N] [--threads N] [--repeat N]\n";
+        return EXIT_FAILURE;
+      }
+    }
+    records = std::max<size_t>(records, 1);
+
+    RecordStore store;
+    store.reserve(records, records * 24);
+    for (size_t i = 0; i < records; ++i) {
+      store.append(csc450::records::syntheticPerson(i));
+    }
+
+    const auto best = [&](auto&& run) {
+      double seconds = 1e300;
+      for (int r = 0; r < repeat; ++r) {
+        const auto start = csc450::bench::Clock::now();
+        run();
+        seconds = std::min(seconds, csc450::bench::secondsSince(start));
+      }
+      return seconds * 1e3;
+    };
+
+    // Baselines: one thread, standard library
+    std::vector<uint32_t> by_id;
+    const double id_baseline_ms = best([&] {
+      by_id.resize(records);
+      std::iota(by_id.begin(), by_id.end(), 0u);
+      const auto ids = store.studentIds();
+      std::stable_sort(by_id.begin(), by_id.end(), [&](uint32_t a, uint32_t b) { return ids[a] < ids[b]; });
+    });
+    std::vector<uint32_t> by_name;
+    const double name_baseline_ms = best([&] {
+      by_name.resize(records);
+      std::iota(by_name.begin(), by_name.end(), 0u);
+      std::stable_sort(by_name.begin(), by_name.end(), [&](uint32_t a, uint32_t b) { return store.name(a) < store.name(b); });
+    });
+    std::vector<ops::GradeGroup> groups;
+    const double group_baseline_ms = best([&] {
+      std::map<char, ops::GradeGroup> by_grade;
+      for (size_t i = 0; i < records; ++i) {
+        ops::GradeGroup& g = by_grade[store.grades()[i]];
+        g.grade = store.grades()[i];
+        ++g.count;
+        g.gpa_sum += store.gpas()[i];
+      }
+      groups.clear();
+      for (const auto& [grade, group] : by_grade) {
+        groups.push_back(group);
+      }
+    });
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "record_parallel_ops");
+    json.field("records", records);
+    json.field("hardware_threads", static_cast<size_t>(std::thread::hardware_concurrency()));
+    json.key("groups").beginArray();
+    for (const ops::GradeGroup& g : groups) {
+      json.beginObject();
+      json.field("grade", std::string(1, g.grade));
+      json.field("count", g.count);
+      json.field("average_gpa", g.averageGpa());
+      json.endObject();
+    }
+    json.endArray();
+
+    bool all_match = true;
+    struct Op {
+      const char* name;
+      const char* baseline;
+      double baseline_ms;
+      double one_thread_ms = 0;
+    };
+    Op op_list[] = {{"sort_student_id", "std::stable_sort", id_baseline_ms}, {"sort_name", "std::stable_sort", name_baseline_ms},
+                    {"group_by_grade", "std::map", group_baseline_ms}};
+    json.key("runs").beginArray();
+    for (size_t threads = 1;; threads = std::min(threads * 2, max_threads)) {
+      for (Op& op : op_list) {
+        bool match = false;
+        double ms = 0;
+        if (std::string(op.name) == "sort_student_id") {
+          std::vector<uint32_t> order;
+          ms = best([&] { order = ops::sortedByStudentId(store, threads); });
+          match = order == by_id;
+        } else if (std::string(op.name) == "sort_name") {
+          std::vector<uint32_t> order;
+          ms = best([&] { order = ops::sortedByName(store, threads); });
+          match = order == by_name;
+        } else {
+          std::vector<ops::GradeGroup> result;
+          ms = best([&] { result = ops::groupByGrade(store, threads); });
+          match = sameGroups(result, groups);
+        }
+        if (threads == 1) {
+          op.one_thread_ms = ms;
+        }
+        all_match = all_match && match;
+        json.beginObject();
+        json.field("op", op.name);
+        json.field("threads", threads);
+        json.field("ms", ms);
+        json.field("records_per_sec", static_cast<double>(records) / (ms / 1e3));
+        json.field("speedup_vs_1_thread", op.one_thread_ms / ms);
+        json.field("baseline", op.baseline);
+        json.field("baseline_ms", op.baseline_ms);
+        json.field("speedup_vs_baseline", op.baseline_ms / ms);
+        json.field("matches_baseline", match);
+        json.endObject();
+      }
+      if (threads == max_threads) {
+        break;
+      }
+    }
+    json.endArray();
+    json.field("all_match", all_match);
+    json.endObject();
+    std::cout << '\n';
+    return all_match ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "record_ops_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
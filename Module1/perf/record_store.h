@@ -0,0 +1,463 @@
+/**
+ * Columnar (structure-of-arrays) store for the personal-information record
+ *
+ * displayPersonalInfo() in ../cert_compliant_datatypes.cpp builds one
+ * record from ten typed fields. PersonRecord below is that record as a
+ * struct; a std::vector<PersonRecord> is the array-of-structs layout, where
+ * a scan of one field (average GPA) drags every other field through the
+ * cache with it and two std::string members per record may each own a heap
+ * block.
+ *
+ * RecordStore keeps one contiguous column per field. Strings are appended
+ * to a single StringArena and the columns hold 8-byte {offset, length}
+ * references, so a million names cost one allocation, not a million. The
+ * scans (averageGpa, countStudents, averageStudentGpa, countAgeBetween)
+ * read only the columns they need, with AVX2 kernels chosen at run time,
+ * SSE2 on any x86-64, and scalar loops elsewhere. Float sums accumulate in
+ * double so the result does not drift with the record count (FLP32-C
+ * spirit: keep the error bounded).
+ *
+ *     csc450::records::RecordStore store;
+ *     store.append(record);
+ *     double gpa = store.averageGpa();
+ *     std::string_view who = store.name(0);
+ *
+ * Strings over 4 GiB in total are rejected with std::length_error, since
+ * offsets are 32-bit.
+ */
+
+#ifndef CSC450_MODULE1_PERF_RECORD_STORE_H_
+#define CSC450_MODULE1_PERF_RECORD_STORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CSC450_RECORDS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace csc450::records {
+
+/**
+ * The fields of displayPersonalInfo(), one record per value
+ */
+struct PersonRecord {
+  std::string name;
+  std::string birthdate;  // "YYYY-MM-DD"
+  int age = 0;
+  double height = 0;  // feet
+  char grade = 'A';
+  bool is_student = false;
+  unsigned int student_id = 0;
+  long long ssn = 0;
+  float gpa = 0;
+  short credit_hours = 0;
+};
+
+struct StringRef {
+  uint32_t offset = 0;
+  uint32_t length = 0;
+};
+
+/**
+ * Append-only byte storage for every string of a store
+ */
+class StringArena {
+ public:
+  void reserve(size_t bytes) {
+    bytes_.reserve(bytes);
+  }
+
+  StringRef add(std::string_view text) {
+    if (text.size() > std::numeric_limits<uint32_t>::max() - bytes_.size()) {
+      throw std::length_error("string arena exceeds 4 GiB");
+    }
+    const StringRef ref{static_cast<uint32_t>(bytes_.size()), static_cast<uint32_t>(text.size())};
+    bytes_.insert(bytes_.end(), text.begin(), text.end());
+    return ref;
+  }
+
+  [[nodiscard]] std::string_view view(StringRef ref) const noexcept {
+    return std::string_view(bytes_.data() + ref.offset, ref.length);
+  }
+
+  [[nodiscard]] const char* data() const noexcept {
+    return bytes_.data();
+  }
+
+  [[nodiscard]] size_t size() const noexcept {
+    return bytes_.size();
+  }
+
+ private:
+  std::vector<char> bytes_;
+};
+
+/**
+ * Column scan kernels
+ */
+namespace scan {
+
+struct MaskedSum {
+  double sum = 0;
+  size_t count = 0;
+};
+
+namespace detail {
+
+inline double sumScalar(const float* values, size_t n) noexcept {
+  double sum = 0;
+  for (size_t i = 0; i < n; ++i) {
+    sum += values[i];
+  }
+  return sum;
+}
+
+inline size_t countNonZeroScalar(const uint8_t* flags, size_t n) noexcept {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+    count += flags[i] != 0 ? 1 : 0;
+  }
+  return count;
+}
+
+inline MaskedSum sumWhereScalar(const float* values, const uint8_t* flags, size_t n) noexcept {
+  MaskedSum result;
+  for (size_t i = 0; i < n; ++i) {
+    if (flags[i] != 0) {
+      result.sum += values[i];
+      ++result.count;
+    }
+  }
+  return result;
+}
+
+inline size_t countInRangeScalar(const int32_t* values, size_t n, int32_t lo, int32_t hi) noexcept {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+    count += values[i] >= lo && values[i] <= hi ? 1 : 0;
+  }
+  return count;
+}
+
+#if defined(CSC450_RECORDS_X86)
+
+inline double horizontalSum(__m128d a, __m128d b) noexcept {
+  const __m128d v = _mm_add_pd(a, b);
+  return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+inline double sumSse2(const float* values, size_t n) noexcept {
+  __m128d low = _mm_setzero_pd();
+  __m128d high = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128 v = _mm_loadu_ps(values + i);
+    low = _mm_add_pd(low, _mm_cvtps_pd(v));
+    high = _mm_add_pd(high, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+  }
+  return horizontalSum(low, high) + sumScalar(values + i, n - i);
+}
+
+inline size_t countNonZeroSse2(const uint8_t* flags, size_t n) noexcept {
+  const __m128i zero = _mm_setzero_si128();
+  size_t count = 0;
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(flags + i));
+    const unsigned zeros = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)));
+    count += 16 - static_cast<size_t>(__builtin_popcount(zeros));
+  }
+  return count + countNonZeroScalar(flags + i, n - i);
+}
+
+// Widens 4 flag bytes to 4 all-ones/all-zeros float lanes
+inline __m128 flagMask4(const uint8_t* flags) noexcept {
+  int32_t bytes;
+  std::memcpy(&bytes, flags, sizeof(bytes));
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i wide = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero);
+  return _mm_castsi128_ps(_mm_cmpgt_epi32(wide, zero));
+}
+
+inline MaskedSum sumWhereSse2(const float* values, const uint8_t* flags, size_t n) noexcept {
+  __m128d low = _mm_setzero_pd();
+  __m128d high = _mm_setzero_pd();
+  size_t count = 0;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128 mask = flagMask4(flags + i);
+    const __m128 v = _mm_and_ps(_mm_loadu_ps(values + i), mask);
+    low = _mm_add_pd(low, _mm_cvtps_pd(v));
+    high = _mm_add_pd(high, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    count += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(_mm_movemask_ps(mask))));
+  }
+  MaskedSum tail = sumWhereScalar(values + i, flags + i, n - i);
+  tail.sum += horizontalSum(low, high);
+  tail.count += count;
+  return tail;
+}
+
+inline size_t countInRangeSse2(const int32_t* values, size_t n, int32_t lo, int32_t hi) noexcept {
+  const __m128i low = _mm_set1_epi32(lo);
+  const __m128i high = _mm_set1_epi32(hi);
+  size_t outside = 0;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+    const __m128i out = _mm_or_si128(_mm_cmpgt_epi32(low, v), _mm_cmpgt_epi32(v, high));
+    outside += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(out)))));
+  }
+  return (i - outside) + countInRangeScalar(values + i, n - i, lo, hi);
+}
+
+__attribute__((target("avx2"))) inline double horizontalSum256(__m256d a, __m256d b) noexcept {
+  const __m256d v = _mm256_add_pd(a, b);
+  return horizontalSum(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+}
+
+__attribute__((target("avx2"))) inline double sumAvx2(const float* values, size_t n) noexcept {
+  __m256d low = _mm256_setzero_pd();
+  __m256d high = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 v = _mm256_loadu_ps(values + i);
+    low = _mm256_add_pd(low, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+    high = _mm256_add_pd(high, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+  }
+  return horizontalSum256(low, high) + sumScalar(values + i, n - i);
+}
+
+__attribute__((target("avx2,popcnt"))) inline size_t countNonZeroAvx2(const uint8_t* flags, size_t n) noexcept {
+  const __m256i zero = _mm256_setzero_si256();
+  size_t count = 0;
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(flags + i));
+    const auto zeros = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero)));
+    count += 32 - static_cast<size_t>(__builtin_popcount(zeros));
+  }
+  return count + countNonZeroSse2(flags + i, n - i);
+}
+
+__attribute__((target("avx2,popcnt"))) inline MaskedSum sumWhereAvx2(const float* values, const uint8_t* flags, size_t n) noexcept {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256d low = _mm256_setzero_pd();
+  __m256d high = _mm256_setzero_pd();
+  size_t count = 0;
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256i wide = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(flags + i)));
+    const __m256 mask = _mm256_castsi256_ps(_mm256_cmpgt_epi32(wide, zero));
+    const __m256 v = _mm256_and_ps(_mm256_loadu_ps(values + i), mask);
+    low = _mm256_add_pd(low, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+    high = _mm256_add_pd(high, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    count += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(_mm256_movemask_ps(mask))));
+  }
+  MaskedSum tail = sumWhereScalar(values + i, flags + i, n - i);
+  tail.sum += horizontalSum256(low, high);
+  tail.count += count;
+  return tail;
+}
+
+__attribute__((target("avx2,popcnt"))) inline size_t countInRangeAvx2(const int32_t* values, size_t n, int32_t lo, int32_t hi) noexcept {
+  const __m256i low = _mm256_set1_epi32(lo);
+  const __m256i high = _mm256_set1_epi32(hi);
+  size_t outside = 0;
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    const __m256i out = _mm256_or_si256(_mm256_cmpgt_epi32(low, v), _mm256_cmpgt_epi32(v, high));
+    outside += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(out)))));
+  }
+  return (i - outside) + countInRangeScalar(values + i, n - i, lo, hi);
+}
+
+#endif  // CSC450_RECORDS_X86
+
+struct Kernels {
+  double (*sum)(const float*, size_t) noexcept;
+  size_t (*count_non_zero)(const uint8_t*, size_t) noexcept;
+  MaskedSum (*sum_where)(const float*, const uint8_t*, size_t) noexcept;
+  size_t (*count_in_range)(const int32_t*, size_t, int32_t, int32_t) noexcept;
+};
+
+inline constexpr Kernels kScalarKernels = {sumScalar, countNonZeroScalar, sumWhereScalar, countInRangeScalar};
+
+inline Kernels selectKernels() {
+#if defined(CSC450_RECORDS_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Kernels{sumAvx2, countNonZeroAvx2, sumWhereAvx2, countInRangeAvx2};
+  }
+  return Kernels{sumSse2, countNonZeroSse2, sumWhereSse2, countInRangeSse2};
+#else
+  return kScalarKernels;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * Best kernels for this CPU, chosen once
+ */
+inline const detail::Kernels& kernels() {
+  static const detail::Kernels kSelected = detail::selectKernels();
+  return kSelected;
+}
+
+}  // namespace scan
+
+/**
+ * One column per PersonRecord field; strings in a shared arena
+ */
+class RecordStore {
+ public:
+  void reserve(size_t records, size_t string_bytes = 0) {
+    names_.reserve(records);
+    birthdates_.reserve(records);
+    ages_.reserve(records);
+    heights_.reserve(records);
+    grades_.reserve(records);
+    students_.reserve(records);
+    student_ids_.reserve(records);
+    ssns_.reserve(records);
+    gpas_.reserve(records);
+    credit_hours_.reserve(records);
+    strings_.reserve(string_bytes);
+  }
+
+  /**
+   * Appends a record; returns its index
+   */
+  size_t append(const PersonRecord& record) {
+    names_.push_back(strings_.add(record.name));
+    birthdates_.push_back(strings_.add(record.birthdate));
+    ages_.push_back(record.age);
+    heights_.push_back(record.height);
+    grades_.push_back(record.grade);
+    students_.push_back(record.is_student ? 1 : 0);
+    student_ids_.push_back(record.student_id);
+    ssns_.push_back(record.ssn);
+    gpas_.push_back(record.gpa);
+    credit_hours_.push_back(record.credit_hours);
+    return ages_.size() - 1;
+  }
+
+  [[nodiscard]] size_t size() const noexcept {
+    return ages_.size();
+  }
+
+  /**
+   * Materializes record i (copies its strings)
+   */
+  [[nodiscard]] PersonRecord get(size_t i) const {
+    PersonRecord record;
+    record.name = std::string(name(i));
+    record.birthdate = std::string(birthdate(i));
+    record.age = ages_[i];
+    record.height = heights_[i];
+    record.grade = grades_[i];
+    record.is_student = students_[i] != 0;
+    record.student_id = student_ids_[i];
+    record.ssn = ssns_[i];
+    record.gpa = gpas_[i];
+    record.credit_hours = credit_hours_[i];
+    return record;
+  }
+
+  [[nodiscard]] std::string_view name(size_t i) const noexcept {
+    return strings_.view(names_[i]);
+  }
+  [[nodiscard]] std::string_view birthdate(size_t i) const noexcept {
+    return strings_.view(birthdates_[i]);
+  }
+
+  // Raw columns, for scans and serialization
+  [[nodiscard]] std::span<const StringRef> names() const noexcept {
+    return names_;
+  }
+  [[nodiscard]] std::span<const StringRef> birthdates() const noexcept {
+    return birthdates_;
+  }
+  [[nodiscard]] std::span<const int32_t> ages() const noexcept {
+    return ages_;
+  }
+  [[nodiscard]] std::span<const double> heights() const noexcept {
+    return heights_;
+  }
+  [[nodiscard]] std::span<const char> grades() const noexcept {
+    return grades_;
+  }
+  [[nodiscard]] std::span<const uint8_t> students() const noexcept {
+    return students_;
+  }
+  [[nodiscard]] std::span<const uint32_t> studentIds() const noexcept {
+    return student_ids_;
+  }
+  [[nodiscard]] std::span<const int64_t> ssns() const noexcept {
+    return ssns_;
+  }
+  [[nodiscard]] std::span<const float> gpas() const noexcept {
+    return gpas_;
+  }
+  [[nodiscard]] std::span<const int16_t> creditHours() const noexcept {
+    return credit_hours_;
+  }
+  [[nodiscard]] const StringArena& strings() const noexcept {
+    return strings_;
+  }
+
+  /**
+   * Bytes held by the columns and the arena
+   */
+  [[nodiscard]] size_t bytes() const noexcept {
+    return size() * (2 * sizeof(StringRef) + sizeof(int32_t) + sizeof(double) + sizeof(char) + sizeof(uint8_t) + sizeof(uint32_t) + sizeof(int64_t) +
+                     sizeof(float) + sizeof(int16_t)) +
+           strings_.size();
+  }
+
+  // Column scans; averages of an empty selection are 0
+  [[nodiscard]] double averageGpa() const noexcept {
+    return size() == 0 ? 0.0 : scan::kernels().sum(gpas_.data(), size()) / static_cast<double>(size());
+  }
+
+  [[nodiscard]] size_t countStudents() const noexcept {
+    return scan::kernels().count_non_zero(students_.data(), size());
+  }
+
+  [[nodiscard]] double averageStudentGpa() const noexcept {
+    const scan::MaskedSum students = scan::kernels().sum_where(gpas_.data(), students_.data(), size());
+    return students.count == 0 ? 0.0 : students.sum / static_cast<double>(students.count);
+  }
+
+  // Records with lo <= age <= hi
+  [[nodiscard]] size_t countAgeBetween(int lo, int hi) const noexcept {
+    return scan::kernels().count_in_range(ages_.data(), size(), lo, hi);
+  }
+
+ private:
+  std::vector<StringRef> names_;
+  std::vector<StringRef> birthdates_;
+  std::vector<int32_t> ages_;
+  std::vector<double> heights_;
+  std::vector<char> grades_;
+  std::vector<uint8_t> students_;  // 0 or 1, so scans can count bytes
+  std::vector<uint32_t> student_ids_;
+  std::vector<int64_t> ssns_;
+  std::vector<float> gpas_;
+  std::vector<int16_t> credit_hours_;
+  StringArena strings_;
+};
+
+}  // namespace csc450::records
+
+#endif  // CSC450_MODULE1_PERF_RECORD_STORE_H_
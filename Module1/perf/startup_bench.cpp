@@ -0,0 +1,338 @@
+/**
+ * Start-up latency of the tiny Module 1 programs
+ *
+ * hello_world and debug_example print a few lines, so nearly all of their
+ * run time is process start-up and teardown. This benchmark runs each
+ * build variant --runs times with posix_spawn (stdout and stderr to
+ * /dev/null) and
+ * reports spawn-to-reap latency percentiles and runs/sec:
+ *   <program>              the course build (dynamic libstdc++, iostream)
+ *   <program>_lean         lean_output.h instead of iostream, --as-needed
+ *   <program>_static       -static (when the toolchain has static libs)
+ *   <program>_lean_static  both
+ * The startup_probe variants are hello_world plus a timestamp written at
+ * main() entry to an inherited pipe, which splits each run into
+ * exec_to_main (kernel exec, dynamic loader, relocations, static
+ * constructors such as std::ios_base::Init) and main_to_exit (the program
+ * body, exit handlers, stream flush, teardown, reaping).
+ *
+ * Every variant's stdout and stderr are captured once and compared with
+ * the course program's text (debug_example's [DEBUG] traces go to stderr);
+ * missing binaries (no static toolchain) are reported as null.
+ *
+ * Usage: startup_bench [--runs N] [--bin DIR]
+ */
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "bench_util.h"
+
+extern char** environ;
+
+namespace {
+
+constexpr const char* kHelloText = "Hello World..\n";
+constexpr const char* kDebugTrace =
+    "[DEBUG] Program started\n"
+    "[DEBUG] Message variable created: Hello World..\n"
+    "[DEBUG] Program ending\n";
+constexpr int kProbeFd = 3;
+
+struct Variant {
+  std::string name;
+  std::string family;  // the course program whose output it must match
+  const char* expected_out;
+  const char* expected_err;
+  bool probe;
+};
+
+std::vector<Variant> variants() {
+  std::vector<Variant> list;
+  const struct {
+    const char* program;
+    const char* expected_out;
+    const char* expected_err;
+    bool probe;
+  } families[] = {{"hello_world", kHelloText, "", false}, {"debug_example", kHelloText, kDebugTrace, false}, {"startup_probe", kHelloText, "", true}};
+  for (const auto& f : families) {
+    for (const char* suffix : {"", "_lean", "_static", "_lean_static"}) {
+      list.push_back(Variant{std::string(f.program) + suffix, f.program, f.expected_out, f.expected_err, f.probe});
+    }
+  }
+  return list;
+}
+
+int64_t monotonicNs() {
+  timespec now{};
+  ::clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+/**
+ * Owns a posix_spawn file-actions object
+ */
+class FileActions {
+ public:
+  FileActions() {
+    check(::posix_spawn_file_actions_init(&actions_), "posix_spawn_file_actions_init");
+  }
+  ~FileActions() {
+    ::posix_spawn_file_actions_destroy(&actions_);
+  }
+  FileActions(const FileActions&) = delete;
+  FileActions& operator=(const FileActions&) = delete;
+
+  void dup2(int from, int to) {
+    check(::posix_spawn_file_actions_adddup2(&actions_, from, to), "posix_spawn_file_actions_adddup2");
+  }
+  posix_spawn_file_actions_t* get() noexcept {
+    return &actions_;
+  }
+
+ private:
+  static void check(int error, const char* what) {
+    if (error != 0) {
+      throw std::system_error(error, std::generic_category(), what);
+    }
+  }
+  posix_spawn_file_actions_t actions_;
+};
+
+struct Pipe {
+  int read = -1;
+  int write = -1;
+  Pipe() {
+    int fds[2];
+    if (::pipe2(fds, O_CLOEXEC) != 0) {
+      throw std::system_error(errno, std::generic_category(), "pipe2");
+    }
+    read = fds[0];
+    write = fds[1];
+  }
+  ~Pipe() {
+    ::close(read);
+    ::close(write);
+  }
+  Pipe(const Pipe&) = delete;
+  Pipe& operator=(const Pipe&) = delete;
+};
+
+struct RunTimes {
+  int64_t spawned_ns = 0;
+  int64_t main_ns = 0;  // 0 unless probed
+  int64_t reaped_ns = 0;
+};
+
+/**
+ * Spawns path with stdout on out_fd, stderr on err_fd (and the probe pipe on
+ * fd 3), waits for it, and returns the clock readings; throws if it fails or
+ * exits non-zero
+ */
+RunTimes runOnce(const std::string& path, int out_fd, int err_fd, const Pipe* probe, char** envp) {
+  FileActions actions;
+  actions.dup2(out_fd, STDOUT_FILENO);
+  actions.dup2(err_fd, STDERR_FILENO);
+  if (probe != nullptr) {
+    actions.dup2(probe->write, kProbeFd);
+  }
+  char* argv[] = {const_cast<char*>(path.c_str()), nullptr};
+  RunTimes t;
+  pid_t pid = 0;
+  t.spawned_ns = monotonicNs();
+  const int error = ::posix_spawn(&pid, path.c_str(), actions.get(), nullptr, argv, envp);
+  if (error != 0) {
+    throw std::system_error(error, std::generic_category(), "posix_spawn " + path);
+  }
+  int status = 0;
+  while (::waitpid(pid, &status, 0) < 0) {
+    if (errno != EINTR) {
+      throw std::system_error(errno, std::generic_category(), "waitpid");
+    }
+  }
+  t.reaped_ns = monotonicNs();
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    throw std::runtime_error(path + " did not exit with status 0");
+  }
+  if (probe != nullptr) {
+    int64_t main_ns = 0;
+    if (::read(probe->read, &main_ns, sizeof(main_ns)) != static_cast<ssize_t>(sizeof(main_ns))) {
+      throw std::runtime_error(path + " did not report its main() entry time");
+    }
+    t.main_ns = main_ns;
+  }
+  return t;
+}
+
+int temporaryFile() {
+  char temp[] = "/tmp/startup_bench_XXXXXX";
+  const int fd = ::mkstemp(temp);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), "mkstemp");
+  }
+  ::unlink(temp);
+  return fd;
+}
+
+std::string readAndClose(int fd) {
+  std::string text(static_cast<size_t>(::lseek(fd, 0, SEEK_END)), '\0');
+  const ssize_t n = ::pread(fd, text.data(), text.size(), 0);
+  ::close(fd);
+  if (n != static_cast<ssize_t>(text.size())) {
+    throw std::runtime_error("short read of captured output");
+  }
+  return text;
+}
+
+/**
+ * True if one run of path writes exactly the expected stdout and stderr
+ */
+bool outputMatches(const std::string& path, const Variant& v, char** envp) {
+  const int out_fd = temporaryFile();
+  const int err_fd = temporaryFile();
+  runOnce(path, out_fd, err_fd, nullptr, envp);
+  const bool out_ok = readAndClose(out_fd) == v.expected_out;
+  return readAndClose(err_fd) == v.expected_err && out_ok;
+}
+
+double percentile(std::vector<double> values, double p) {
+  if (values.empty()) {
+    return 0;
+  }
+  const auto rank = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+  std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(rank), values.end());
+  return values[rank];
+}
+
+std::filesystem::path ownDirectory() {
+  return std::filesystem::read_symlink("/proc/self/exe").parent_path();
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    int runs = 1000;
+    std::filesystem::path bin;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--runs" && i + 1 < argc) {
+        runs = std::max(1, std::atoi(argv[++i]));
+      } else if (arg == "--bin" && i + 1 < argc) {
+        bin = argv[++i];
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--runs N] [--bin DIR]\n";
+        return EXIT_FAILURE;
+      }
+    }
+    if (bin.empty()) {
+      bin = ownDirectory();
+    }
+
+    // Children inherit this environment plus the probe descriptor number
+    std::vector<std::string> env_storage;
+    for (char** e = environ; *e != nullptr; ++e) {
+      if (std::strncmp(*e, "CSC450_PROBE_FD=", 16) != 0) {
+        env_storage.emplace_back(*e);
+      }
+    }
+    env_storage.push_back("CSC450_PROBE_FD=" + std::to_string(kProbeFd));
+    std::vector<char*> envp;
+    for (std::string& entry : env_storage) {
+      envp.push_back(entry.data());
+    }
+    envp.push_back(nullptr);
+
+    const int null_fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (null_fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "open /dev/null");
+    }
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "startup_latency");
+    json.field("runs", runs);
+    json.field("bin", bin.string());
+    json.key("variants").beginArray();
+    bool all_match = true;
+    std::vector<std::pair<std::string, double>> family_p50;  // course build of each family
+    for (const Variant& v : variants()) {
+      const std::filesystem::path path = bin / v.name;
+      json.beginObject();
+      json.field("name", v.name);
+      if (!std::filesystem::exists(path)) {
+        json.key("p50_us").null();
+        json.endObject();
+        continue;
+      }
+      const bool match = outputMatches(path.string(), v, envp.data());
+      all_match = all_match && match;
+
+      std::vector<double> total_us;
+      std::vector<double> to_main_us;
+      std::vector<double> after_main_us;
+      total_us.reserve(static_cast<size_t>(runs));
+      const auto start = csc450::bench::Clock::now();
+      for (int r = 0; r < runs; ++r) {
+        std::unique_ptr<Pipe> probe = v.probe ? std::make_unique<Pipe>() : nullptr;
+        const RunTimes t = runOnce(path.string(), null_fd, null_fd, probe.get(), envp.data());
+        total_us.push_back(static_cast<double>(t.reaped_ns - t.spawned_ns) / 1e3);
+        if (v.probe) {
+          to_main_us.push_back(static_cast<double>(t.main_ns - t.spawned_ns) / 1e3);
+          after_main_us.push_back(static_cast<double>(t.reaped_ns - t.main_ns) / 1e3);
+        }
+      }
+      const double seconds = csc450::bench::secondsSince(start);
+
+      const double p50 = percentile(total_us, 0.50);
+      if (v.name == v.family) {
+        family_p50.emplace_back(v.family, p50);
+      }
+      double baseline = p50;
+      for (const auto& [family, value] : family_p50) {
+        if (family == v.family) {
+          baseline = value;
+        }
+      }
+      json.field("binary_bytes", static_cast<size_t>(std::filesystem::file_size(path)));
+      json.field("output_matches", match);
+      json.field("p50_us", p50);
+      json.field("p90_us", percentile(total_us, 0.90));
+      json.field("p99_us", percentile(total_us, 0.99));
+      json.field("runs_per_sec", runs / seconds);
+      json.field("speedup_vs_course_build", baseline / p50);
+      if (v.probe) {
+        json.field("exec_to_main_p50_us", percentile(to_main_us, 0.50));
+        json.field("main_to_exit_p50_us", percentile(after_main_us, 0.50));
+      }
+      json.endObject();
+    }
+    json.endArray();
+    json.field("all_match", all_match);
+    json.endObject();
+    std::cout << '\n';
+    ::close(null_fd);
+    return all_match ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "startup_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
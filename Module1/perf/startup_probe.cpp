@@ -0,0 +1,55 @@
+/**
+ * hello_world with a start-up probe, for startup_bench's exec -> main -> exit split
+ *
+ * If CSC450_PROBE_FD names an open descriptor, main() first writes the
+ * CLOCK_MONOTONIC time at entry to it (8 bytes, nanoseconds), then prints
+ * "Hello World.." like "../hello world.cpp". The parent records the clock
+ * before spawning and after reaping, so the two intervals are everything
+ * before main (exec, dynamic loading, static initialization) and everything
+ * after (the program, exit handlers, teardown). Built with
+ * CSC450_STARTUP_LEAN it prints through lean_output.h instead of iostream.
+ */
+
+#include <time.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+
+#if CSC450_STARTUP_LEAN
+#include "lean_output.h"
+#else
+#include <iostream>
+#endif
+
+namespace {
+
+void reportMainEntry() {
+  timespec now{};
+  ::clock_gettime(CLOCK_MONOTONIC, &now);
+  const char* fd_text = std::getenv("CSC450_PROBE_FD");
+  if (fd_text == nullptr) {
+    return;
+  }
+  char* end = nullptr;
+  const long fd = std::strtol(fd_text, &end, 10);
+  if (end == fd_text || *end != '\0' || fd < 0 || fd > 1024) {
+    return;
+  }
+  const int64_t ns = static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+  if (::write(static_cast<int>(fd), &ns, sizeof(ns)) != static_cast<ssize_t>(sizeof(ns))) {
+    return;  // the parent notices the missing timestamp
+  }
+}
+
+}  // anonymous namespace
+
+int main() {
+  reportMainEntry();
+#if CSC450_STARTUP_LEAN
+  return csc450::lean::print("Hello World..\n") ? 0 : 1;
+#else
+  std::cout << "Hello World.." << std::endl;
+  return std::cout ? 0 : 1;
+#endif
+}
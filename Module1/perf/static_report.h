@@ -0,0 +1,450 @@
+/**
+ * Compile-time rendered text reports
+ *
+ * displayPersonalInfo() in ../cert_compliant_datatypes.cpp formats ten
+ * compile-time constants through std::cout at run time and flushes after
+ * every line with std::endl: seventeen write(2) calls for text that never
+ * changes. Here the same report is rendered during compilation into a
+ * static character array and emitted with one write.
+ *
+ * ReportBuilder is an ordinary constexpr text builder (fixed capacity, no
+ * allocation) with the iostream defaults for each type: integers in
+ * decimal, char as the character, float and double like %g with six
+ * significant digits. Digits come from exact integer arithmetic on the
+ * double's bits, so they match printf for every finite value, subnormals
+ * included. The same builder works at run time, which is how the
+ * benchmark measures what the compile-time version saves.
+ *
+ * render() evaluates a builder function in a consteval context and copies
+ * the result into a StaticText exactly as long as the report:
+ *
+ *     inline constexpr auto kBanner = csc450::report::render([] {
+ *       csc450::report::ReportBuilder<> b;
+ *       b.line("Age: ", 33, " years old");
+ *       return b;
+ *     });
+ *     kBanner.write(STDOUT_FILENO);
+ *
+ * Overflowing a builder's capacity is a compile error during constant
+ * evaluation and std::length_error at run time (STR50-CPP: guarantee that
+ * storage for strings has sufficient space). write() reports failures with
+ * std::system_error instead of leaving them in a stream state (ERR33-C:
+ * detect and handle standard library errors; FIO04-C: detect and handle
+ * input and output errors).
+ */
+
+#ifndef CSC450_MODULE1_PERF_STATIC_REPORT_H_
+#define CSC450_MODULE1_PERF_STATIC_REPORT_H_
+
+#include <unistd.h>
+
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "posix_io.h"
+
+namespace csc450::report {
+
+/**
+ * Prints a bool as "Yes"/"No", like displayPersonalInfo()'s ternary
+ */
+struct YesNo {
+  bool value;
+};
+
+namespace detail {
+
+inline constexpr uint32_t kPow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+/**
+ * Unsigned integer wide enough for any double written as a ratio of two
+ * integers and scaled by a power of ten into [1, 10): at most 2^1074 times
+ * a 53-bit mantissa, or 10^324 times one, with room for a factor of 20
+ */
+struct BigUint {
+  static constexpr int kLimbs = 40;
+  uint32_t limbs[kLimbs] = {};  // little-endian base 2^32
+
+  constexpr void multiply(uint32_t factor) noexcept {
+    uint64_t carry = 0;
+    for (uint32_t& limb : limbs) {
+      const uint64_t product = uint64_t{limb} * factor + carry;
+      limb = static_cast<uint32_t>(product);
+      carry = product >> 32;
+    }
+  }
+  constexpr void multiplyPow2(int e) noexcept {
+    for (; e >= 31; e -= 31) {
+      multiply(uint32_t{1} << 31);
+    }
+    multiply(uint32_t{1} << e);
+  }
+  constexpr void multiplyPow10(int e) noexcept {
+    for (; e >= 9; e -= 9) {
+      multiply(kPow10[9]);
+    }
+    multiply(kPow10[e]);
+  }
+  // Assumes *this >= other
+  constexpr void subtract(const BigUint& other) noexcept {
+    uint64_t borrow = 0;
+    for (int i = 0; i < kLimbs; ++i) {
+      const uint64_t difference = uint64_t{limbs[i]} - other.limbs[i] - borrow;
+      limbs[i] = static_cast<uint32_t>(difference);
+      borrow = difference >> 63;
+    }
+  }
+  [[nodiscard]] constexpr int compare(const BigUint& other) const noexcept {
+    for (int i = kLimbs - 1; i >= 0; --i) {
+      if (limbs[i] != other.limbs[i]) {
+        return limbs[i] < other.limbs[i] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+};
+
+}  // namespace detail
+
+/**
+ * Fixed-capacity text builder usable in constant expressions
+ */
+template <size_t Capacity = 4096>
+class ReportBuilder {
+ public:
+  constexpr ReportBuilder& text(std::string_view s) {
+    reserveFor(s.size());
+    for (const char c : s) {
+      data_[size_++] = c;
+    }
+    return *this;
+  }
+
+  constexpr ReportBuilder& character(char c) {
+    reserveFor(1);
+    data_[size_++] = c;
+    return *this;
+  }
+
+  template <std::integral Int>
+  constexpr ReportBuilder& integer(Int value) {
+    char digits[24] = {};
+    int count = 0;
+    const bool negative = value < 0;
+    // Work in the unsigned magnitude so the most negative value is safe (INT32-C)
+    auto magnitude = static_cast<std::make_unsigned_t<Int>>(value);
+    if (negative) {
+      magnitude = static_cast<std::make_unsigned_t<Int>>(0 - magnitude);
+    }
+    do {
+      digits[count++] = static_cast<char>('0' + magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude != 0);
+    if (negative) {
+      character('-');
+    }
+    while (count > 0) {
+      character(digits[--count]);
+    }
+    return *this;
+  }
+
+  /**
+   * %g: `precision` significant digits, trailing zeros dropped, scientific
+   * below 1e-4 or from 10^precision. The value is held exactly as
+   * numerator / denominator, digits are produced by long division, and the
+   * remainder decides rounding (ties to even, as printf does), so no
+   * intermediate double is ever rounded.
+   */
+  constexpr ReportBuilder& floating(double value, int precision = 6) {
+    if (value != value) {
+      return text("nan");
+    }
+    if (value < 0 || (value == 0 && 1 / value < 0)) {
+      character('-');
+      value = -value;
+    }
+    if (value > 1.7976931348623157e308) {
+      return text("inf");
+    }
+    precision = precision < 1 ? 1 : (precision > 17 ? 17 : precision);
+    if (value == 0) {
+      return character('0');
+    }
+
+    // value = mantissa * 2^binary_exponent, exactly
+    const auto bits = std::bit_cast<uint64_t>(value);
+    const int biased = static_cast<int>(bits >> 52);
+    uint64_t mantissa = bits & ((uint64_t{1} << 52) - 1);
+    int binary_exponent = -1074;
+    if (biased != 0) {
+      mantissa |= uint64_t{1} << 52;
+      binary_exponent = biased - 1075;
+    }
+
+    // numerator / denominator = value / 10^exponent, brought into [1, 10);
+    // the estimate from the top bit is at most one off either way
+    detail::BigUint numerator;
+    numerator.limbs[0] = static_cast<uint32_t>(mantissa);
+    numerator.limbs[1] = static_cast<uint32_t>(mantissa >> 32);
+    detail::BigUint denominator;
+    denominator.limbs[0] = 1;
+    if (binary_exponent > 0) {
+      numerator.multiplyPow2(binary_exponent);
+    } else {
+      denominator.multiplyPow2(-binary_exponent);
+    }
+    const int top_bit = 63 - std::countl_zero(mantissa) + binary_exponent;
+    int exponent = (top_bit * 78913) >> 18;  // floor(top_bit * log10(2))
+    if (exponent >= 0) {
+      denominator.multiplyPow10(exponent);
+    } else {
+      numerator.multiplyPow10(-exponent);
+    }
+    if (numerator.compare(denominator) < 0) {
+      numerator.multiply(10);
+      --exponent;
+    }
+    detail::BigUint tenfold = denominator;
+    tenfold.multiply(10);
+    if (numerator.compare(tenfold) >= 0) {
+      denominator = tenfold;
+      ++exponent;
+    }
+
+    char d[17] = {};
+    for (int i = 0; i < precision; ++i) {
+      if (i != 0) {
+        numerator.multiply(10);
+      }
+      char digit = '0';
+      while (numerator.compare(denominator) >= 0) {
+        numerator.subtract(denominator);
+        ++digit;
+      }
+      d[i] = digit;
+    }
+    numerator.multiply(2);  // twice the remainder against the denominator
+    const int half = numerator.compare(denominator);
+    if (half > 0 || (half == 0 && (d[precision - 1] - '0') % 2 != 0)) {
+      int i = precision - 1;
+      for (; i >= 0 && d[i] == '9'; --i) {
+        d[i] = '0';
+      }
+      if (i >= 0) {
+        ++d[i];
+      } else {
+        d[0] = '1';
+        ++exponent;
+      }
+    }
+    int used = precision;
+    while (used > 1 && d[used - 1] == '0') {
+      --used;
+    }
+
+    if (exponent < -4 || exponent >= precision) {
+      character(d[0]);
+      if (used > 1) {
+        character('.');
+        text(std::string_view(d + 1, static_cast<size_t>(used - 1)));
+      }
+      character('e');
+      character(exponent < 0 ? '-' : '+');
+      const int magnitude = exponent < 0 ? -exponent : exponent;
+      if (magnitude < 10) {
+        character('0');
+      }
+      return integer(magnitude);
+    }
+    if (exponent < 0) {
+      text("0.");
+      for (int i = -1; i > exponent; --i) {
+        character('0');
+      }
+      return text(std::string_view(d, static_cast<size_t>(used)));
+    }
+    const int whole = exponent + 1;
+    text(std::string_view(d, static_cast<size_t>(used < whole ? used : whole)));
+    for (int i = used; i < whole; ++i) {
+      character('0');
+    }
+    if (used > whole) {
+      character('.');
+      text(std::string_view(d + whole, static_cast<size_t>(used - whole)));
+    }
+    return *this;
+  }
+
+  // One overload per printable type, with the iostream default for each
+  constexpr ReportBuilder& append(std::string_view s) {
+    return text(s);
+  }
+  constexpr ReportBuilder& append(const char* s) {
+    return text(s);
+  }
+  constexpr ReportBuilder& append(char c) {
+    return character(c);
+  }
+  constexpr ReportBuilder& append(YesNo b) {
+    return text(b.value ? "Yes" : "No");
+  }
+  constexpr ReportBuilder& append(double value) {
+    return floating(value);
+  }
+  constexpr ReportBuilder& append(float value) {
+    return floating(static_cast<double>(value));
+  }
+  template <std::integral Int>
+    requires(!std::same_as<Int, char> && !std::same_as<Int, bool>)
+  constexpr ReportBuilder& append(Int value) {
+    return integer(value);
+  }
+
+  /**
+   * Appends each part, then '\n'
+   */
+  template <typename... Parts>
+  constexpr ReportBuilder& line(const Parts&... parts) {
+    (append(parts), ...);
+    return character('\n');
+  }
+
+  [[nodiscard]] constexpr size_t size() const noexcept {
+    return size_;
+  }
+  [[nodiscard]] constexpr std::string_view view() const noexcept {
+    return std::string_view(data_, size_);
+  }
+  constexpr void clear() noexcept {
+    size_ = 0;
+  }
+
+ private:
+  constexpr void reserveFor(size_t n) const {
+    if (n > Capacity - size_) {
+      throw std::length_error("report exceeds builder capacity");
+    }
+  }
+
+  char data_[Capacity] = {};
+  size_t size_ = 0;
+};
+
+/**
+ * Report text fixed at compile time, exactly N bytes
+ */
+template <size_t N>
+struct StaticText {
+  std::array<char, N> bytes{};
+
+  [[nodiscard]] constexpr std::string_view view() const noexcept {
+    return std::string_view(bytes.data(), N);
+  }
+
+  void write(int fd) const {
+    io::writeAllOrThrow(fd, view(), "write report");
+  }
+};
+
+/**
+ * Runs make() during compilation and keeps only the text it built. make
+ * must be a captureless lambda (or other default-constructible function
+ * object) returning a ReportBuilder.
+ */
+template <typename Make>
+consteval auto render(Make) {
+  constexpr auto built = Make{}();
+  StaticText<built.size()> out;
+  for (size_t i = 0; i < built.size(); ++i) {
+    out.bytes[i] = built.view()[i];
+  }
+  return out;
+}
+
+// The constants displayPersonalInfo() prints
+struct PersonalInfo {
+  std::string_view name;
+  std::string_view birthdate;
+  int age;
+  double height;
+  char grade;
+  bool is_student;
+  unsigned int student_id;
+  long long ssn;
+  float gpa;
+  short credit_hours;
+};
+
+inline constexpr PersonalInfo kPersonalInfo{"John Doe", "1990-05-15", 33, 5.9, 'A', true, 12345U, 123456789LL, 3.85F, 15};
+
+/**
+ * displayPersonalInfo()'s output, line for line
+ */
+template <size_t Capacity>
+constexpr void buildPersonalInfo(ReportBuilder<Capacity>& b, const PersonalInfo& p) {
+  b.line("=== Personal Information ===");
+  b.line("Name: ", p.name);
+  b.line("Birthdate: ", p.birthdate);
+  b.line("Age: ", p.age, " years old");
+  b.line("Height: ", p.height, " feet");
+  b.line("Grade: ", p.grade);
+  b.line("Is Student: ", YesNo{p.is_student});
+  b.line("Student ID: ", p.student_id);
+  b.line("SSN: ", p.ssn);
+  b.line("GPA: ", p.gpa);
+  b.line("Credit Hours: ", p.credit_hours);
+  b.line();
+  b.line("=== Data Type Sizes ===");
+  b.line("Size of int: ", sizeof(int), " bytes");
+  b.line("Size of double: ", sizeof(double), " bytes");
+  b.line("Size of char: ", sizeof(char), " bytes");
+  b.line("Size of bool: ", sizeof(bool), " bytes");
+  b.line("Size of string: ", sizeof(std::string), " bytes");
+}
+
+inline constexpr auto kPersonalInfoReport = render([] {
+  ReportBuilder<1024> b;
+  buildPersonalInfo(b, kPersonalInfo);
+  return b;
+});
+
+namespace detail {
+
+template <typename T>
+constexpr bool formatsAs(T value, std::string_view expected) {
+  ReportBuilder<64> b;
+  b.append(value);
+  return b.view() == expected;
+}
+
+// %g agreement with printf/iostream on the cases that matter here
+static_assert(formatsAs(5.9, "5.9") && formatsAs(3.85F, "3.85") && formatsAs(0.0001, "0.0001") && formatsAs(1e-5, "1e-05"));
+static_assert(formatsAs(123456789.0, "1.23457e+08") && formatsAs(999999.5, "1e+06") && formatsAs(100.0, "100") && formatsAs(-2.5, "-2.5"));
+static_assert(formatsAs(-2147483647 - 1, "-2147483648") && formatsAs(18446744073709551615ull, "18446744073709551615"));
+
+constexpr bool roundsAs(double value, int precision, std::string_view expected) {
+  ReportBuilder<64> b;
+  b.floating(value, precision);
+  return b.view() == expected;
+}
+
+// Near ties are decided by the exact binary value, not a rescaled double
+static_assert(roundsAs(0.1000005, 6, "0.100001") && roundsAs(0.1000015, 6, "0.100001") && roundsAs(0.15, 1, "0.1") && roundsAs(0.35, 1, "0.3"));
+static_assert(roundsAs(0.45, 1, "0.5") && roundsAs(4.35, 2, "4.3") && roundsAs(0.125, 2, "0.12") && roundsAs(0.375, 2, "0.38"));
+static_assert(roundsAs(5e-324, 6, "4.94066e-324") && roundsAs(2.2250738585072014e-308, 17, "2.2250738585072014e-308"));
+static_assert(roundsAs(1.7976931348623157e308, 6, "1.79769e+308") && roundsAs(1e23, 17, "9.9999999999999992e+22"));
+
+}  // namespace detail
+
+}  // namespace csc450::report
+
+#endif  // CSC450_MODULE1_PERF_STATIC_REPORT_H_
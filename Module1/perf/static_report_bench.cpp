@@ -0,0 +1,199 @@
+/**
+ * displayPersonalInfo(): iostream at run time vs a report rendered at compile time
+ *
+ * Emits the personal-information report to stdout (redirected to /dev/null
+ * while timing) four ways:
+ *   iostream_endl     the current code: std::cout << ... << std::endl per line
+ *   iostream_newline  the same with '\n' and one flush at the end
+ *   runtime_builder   ReportBuilder filled at run time, then one write(2)
+ *   static_write      csc450::report::kPersonalInfoReport, one write(2)
+ * Each path's output is first captured to a temporary file and compared
+ * byte for byte with the compile-time text. The report gives ns per report
+ * and the write(2) calls each path makes (one per std::endl flush, else one).
+ *
+ * Usage: static_report_bench [--min-time SECONDS]
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <system_error>
+
+#include "bench_util.h"
+#include "static_report.h"
+
+namespace {
+
+using csc450::report::kPersonalInfo;
+using csc450::report::kPersonalInfoReport;
+
+// The body of displayPersonalInfo(), values taken from kPersonalInfo
+void iostreamReport(const csc450::report::PersonalInfo& p, bool use_endl) {
+  const auto end = [use_endl](std::ostream& out) -> std::ostream& { return use_endl ? out << std::endl : out << '\n'; };
+  end(std::cout << "=== Personal Information ===");
+  end(std::cout << "Name: " << p.name);
+  end(std::cout << "Birthdate: " << p.birthdate);
+  end(std::cout << "Age: " << p.age << " years old");
+  end(std::cout << "Height: " << p.height << " feet");
+  end(std::cout << "Grade: " << p.grade);
+  end(std::cout << "Is Student: " << (p.is_student ? "Yes" : "No"));
+  end(std::cout << "Student ID: " << p.student_id);
+  end(std::cout << "SSN: " << p.ssn);
+  end(std::cout << "GPA: " << p.gpa);
+  end(std::cout << "Credit Hours: " << p.credit_hours);
+  end(std::cout << "\n=== Data Type Sizes ===");
+  end(std::cout << "Size of int: " << sizeof(int) << " bytes");
+  end(std::cout << "Size of double: " << sizeof(double) << " bytes");
+  end(std::cout << "Size of char: " << sizeof(char) << " bytes");
+  end(std::cout << "Size of bool: " << sizeof(bool) << " bytes");
+  end(std::cout << "Size of string: " << sizeof(std::string) << " bytes");
+  if (!use_endl) {
+    std::cout.flush();
+  }
+  if (!std::cout) {
+    throw std::runtime_error("Output stream error");
+  }
+}
+
+void runtimeReport(const csc450::report::PersonalInfo& p) {
+  csc450::report::ReportBuilder<1024> b;
+  csc450::report::buildPersonalInfo(b, p);
+  csc450::io::writeAllOrThrow(STDOUT_FILENO, b.view(), "write report");
+}
+
+enum Method { kIostreamEndl, kIostreamNewline, kRuntimeBuilder, kStaticWrite, kMethods };
+const char* const kMethodNames[kMethods] = {"iostream_endl", "iostream_newline", "runtime_builder", "static_write"};
+const int kWritesPerReport[kMethods] = {17, 1, 1, 1};  // one per endl; one per flush or write
+
+void emit(Method m, const csc450::report::PersonalInfo& p) {
+  switch (m) {
+    case kIostreamEndl:
+      iostreamReport(p, true);
+      break;
+    case kIostreamNewline:
+      iostreamReport(p, false);
+      break;
+    case kRuntimeBuilder:
+      runtimeReport(p);
+      break;
+    default:
+      kPersonalInfoReport.write(STDOUT_FILENO);
+      break;
+  }
+}
+
+/**
+ * Points fd 1 at another descriptor for its lifetime
+ */
+class StdoutRedirect {
+ public:
+  explicit StdoutRedirect(int fd) : saved_(::dup(STDOUT_FILENO)) {
+    std::cout.flush();
+    if (saved_ < 0 || ::dup2(fd, STDOUT_FILENO) < 0) {
+      throw std::system_error(errno, std::generic_category(), "redirect stdout");
+    }
+  }
+  ~StdoutRedirect() {
+    std::cout.flush();
+    ::dup2(saved_, STDOUT_FILENO);
+    ::close(saved_);
+  }
+  StdoutRedirect(const StdoutRedirect&) = delete;
+  StdoutRedirect& operator=(const StdoutRedirect&) = delete;
+
+ private:
+  int saved_;
+};
+
+std::string capture(Method m) {
+  char path[] = "/tmp/static_report_bench_XXXXXX";
+  const int fd = ::mkstemp(path);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), "mkstemp");
+  }
+  ::unlink(path);
+  {
+    StdoutRedirect redirect(fd);
+    emit(m, kPersonalInfo);
+  }
+  std::string text(static_cast<size_t>(::lseek(fd, 0, SEEK_END)), '\0');
+  const ssize_t n = ::pread(fd, text.data(), text.size(), 0);
+  ::close(fd);
+  if (n != static_cast<ssize_t>(text.size())) {
+    throw std::runtime_error("short read of captured output");
+  }
+  return text;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    double min_time = 0.2;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--min-time SECONDS]\n";
+        return EXIT_FAILURE;
+      }
+    }
+
+    bool match[kMethods];
+    bool all_match = true;
+    for (int m = 0; m < kMethods; ++m) {
+      match[m] = capture(static_cast<Method>(m)) == kPersonalInfoReport.view();
+      all_match = all_match && match[m];
+    }
+
+    const int null_fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (null_fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "open /dev/null");
+    }
+    double ns[kMethods];
+    {
+      StdoutRedirect redirect(null_fd);
+      for (int m = 0; m < kMethods; ++m) {
+        csc450::report::PersonalInfo info = kPersonalInfo;
+        ns[m] = csc450::bench::nsPerOp(
+            [&] {
+              csc450::bench::doNotOptimize(info);  // runtime paths must read the values
+              emit(static_cast<Method>(m), info);
+            },
+            min_time);
+      }
+    }
+    ::close(null_fd);
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "static_report");
+    json.field("report_bytes", kPersonalInfoReport.view().size());
+    json.field("all_match", all_match);
+    json.key("methods").beginArray();
+    for (int m = 0; m < kMethods; ++m) {
+      json.beginObject();
+      json.field("method", kMethodNames[m]);
+      json.field("ns_per_report", ns[m]);
+      json.field("writes_per_report", kWritesPerReport[m]);
+      json.field("speedup_vs_iostream_endl", ns[kIostreamEndl] / ns[m]);
+      json.field("output_matches", match[m]);
+      json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    std::cout << '\n';
+    return all_match ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "static_report_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
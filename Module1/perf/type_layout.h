@@ -0,0 +1,252 @@
+/**
+ * Reflection-lite struct layout analysis: offsets, padding, cache-line spans
+ *
+ * cert_compliant_datatypes.cpp prints sizeof for single types; what costs
+ * memory and bandwidth is how those types pack once they are fields of a
+ * record. A Layout lists a struct's fields from offsetof/sizeof/alignof
+ * (C++ cannot enumerate members, so the caller names them):
+ *
+ *     inline constexpr auto kLayout = describe<PersonFields>("PersonFields",
+ *         CSC450_LAYOUT_FIELD(PersonFields, age), CSC450_LAYOUT_FIELD(PersonFields, height), ...);
+ *
+ * Everything is computed at compile time, so a hand-reordered twin can be
+ * pinned to the suggestion:
+ *
+ *     static_assert(sizeof(PersonFieldsPacked) == suggestReordering(kLayout).size);
+ *
+ * A field left out of the list shows up as padding, so list every member.
+ * offsetof is only conditionally supported for types that are not
+ * standard-layout ([support.types.layout]), so describe() requires one. The suggested order is the classic one:
+ * decreasing alignment, then decreasing size, declaration order for ties;
+ * with power-of-two alignments it leaves only tail padding. Cache-line
+ * figures assume the array starts on a kCacheLine boundary.
+ */
+
+#ifndef CSC450_MODULE1_PERF_TYPE_LAYOUT_H_
+#define CSC450_MODULE1_PERF_TYPE_LAYOUT_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace csc450::layout {
+
+inline constexpr size_t kCacheLine = 64;
+
+/**
+ * Readable name of T, taken from the compiler's function signature
+ */
+template <typename T>
+constexpr std::string_view typeName() noexcept {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return "std::string";
+  } else {
+#if defined(__GNUC__) || defined(__clang__)
+    constexpr std::string_view pretty = __PRETTY_FUNCTION__;
+    constexpr size_t start = pretty.find("T = ") + 4;
+    return pretty.substr(start, pretty.find_first_of(";]", start) - start);
+#else
+    return "?";
+#endif
+  }
+}
+
+struct Field {
+  std::string_view name;
+  std::string_view type;
+  size_t offset = 0;
+  size_t size = 0;
+  size_t align = 1;
+};
+
+template <size_t N>
+struct Layout {
+  std::string_view name;
+  size_t size = 0;
+  size_t align = 1;
+  std::array<Field, N> fields{};  // by offset
+};
+
+/**
+ * Layout of T from its fields (any order; stored by offset)
+ */
+template <typename T, typename... Fields>
+constexpr Layout<sizeof...(Fields)> describe(std::string_view name, Fields... fields) {
+  static_assert(std::is_standard_layout_v<T>, "offsetof is only reliable for standard-layout types");
+  Layout<sizeof...(Fields)> layout{name, sizeof(T), alignof(T), {fields...}};
+  for (size_t i = 1; i < layout.fields.size(); ++i) {
+    for (size_t j = i; j > 0 && layout.fields[j].offset < layout.fields[j - 1].offset; --j) {
+      const Field moved = layout.fields[j];
+      layout.fields[j] = layout.fields[j - 1];
+      layout.fields[j - 1] = moved;
+    }
+  }
+  return layout;
+}
+
+template <size_t N>
+constexpr size_t fieldBytes(const Layout<N>& layout) noexcept {
+  size_t total = 0;
+  for (const Field& f : layout.fields) {
+    total += f.size;
+  }
+  return total;
+}
+
+template <size_t N>
+constexpr size_t paddingBytes(const Layout<N>& layout) noexcept {
+  return layout.size - fieldBytes(layout);
+}
+
+/**
+ * Padding between field i and the next field (or the end of the struct)
+ */
+template <size_t N>
+constexpr size_t paddingAfter(const Layout<N>& layout, size_t i) noexcept {
+  const size_t end = layout.fields[i].offset + layout.fields[i].size;
+  return (i + 1 < N ? layout.fields[i + 1].offset : layout.size) - end;
+}
+
+constexpr size_t firstLine(size_t offset) noexcept {
+  return offset / kCacheLine;
+}
+
+constexpr size_t lastLine(size_t offset, size_t size) noexcept {
+  return (offset + (size == 0 ? 1 : size) - 1) / kCacheLine;
+}
+
+/**
+ * Array behaviour of records of `size` bytes: averaged over one period of
+ * the record/cache-line pattern
+ */
+struct ArrayFootprint {
+  double records_per_line = 0;
+  double lines_per_record = 0;  // distinct lines a single record touches
+  double straddling = 0;        // fraction of records crossing a line boundary
+};
+
+constexpr ArrayFootprint arrayFootprint(size_t size) noexcept {
+  size_t period = 1;  // records until the pattern repeats: lcm(size, kCacheLine) / size
+  while ((period * size) % kCacheLine != 0) {
+    ++period;
+  }
+  size_t lines = 0;
+  size_t straddling = 0;
+  for (size_t i = 0; i < period; ++i) {
+    const size_t touched = lastLine(i * size, size) - firstLine(i * size) + 1;
+    lines += touched;
+    straddling += touched > 1 ? 1 : 0;
+  }
+  const auto n = static_cast<double>(period);
+  return {static_cast<double>(kCacheLine) / static_cast<double>(size), static_cast<double>(lines) / n, static_cast<double>(straddling) / n};
+}
+
+/**
+ * Fields in the suggested order, their offsets there, and the size and
+ * padding that order gives
+ */
+template <size_t N>
+struct Reordering {
+  std::array<size_t, N> order{};  // indexes into Layout::fields
+  std::array<size_t, N> offsets{};
+  size_t size = 0;
+  size_t padding = 0;
+};
+
+template <size_t N>
+constexpr Reordering<N> suggestReordering(const Layout<N>& layout) noexcept {
+  Reordering<N> r;
+  for (size_t i = 0; i < N; ++i) {
+    r.order[i] = i;
+  }
+  const auto before = [&layout](size_t a, size_t b) {
+    const Field& x = layout.fields[a];
+    const Field& y = layout.fields[b];
+    return x.align != y.align ? x.align > y.align : x.size > y.size;
+  };
+  for (size_t i = 1; i < N; ++i) {  // insertion sort keeps ties in declaration order
+    for (size_t j = i; j > 0 && before(r.order[j], r.order[j - 1]); --j) {
+      const size_t moved = r.order[j];
+      r.order[j] = r.order[j - 1];
+      r.order[j - 1] = moved;
+    }
+  }
+  size_t at = 0;
+  for (size_t i = 0; i < N; ++i) {
+    const Field& f = layout.fields[r.order[i]];
+    at = (at + f.align - 1) / f.align * f.align;
+    r.offsets[i] = at;
+    at += f.size;
+  }
+  r.size = (at + layout.align - 1) / layout.align * layout.align;
+  r.padding = r.size - fieldBytes(layout);
+  return r;
+}
+
+namespace detail {
+
+template <typename... Args>
+void appendf(std::string& out, const char* format, Args... args) {
+  char line[256];
+  const int n = std::snprintf(line, sizeof(line), format, args...);
+  out.append(line, static_cast<size_t>(n < 0 ? 0 : std::min(n, static_cast<int>(sizeof(line)) - 1)));
+}
+
+inline std::string lineSpan(size_t first, size_t last) {
+  return first == last ? std::to_string(first) : std::to_string(first) + "-" + std::to_string(last) + " (split)";
+}
+
+}  // namespace detail
+
+/**
+ * Human-readable report: field table with padding rows, array footprint,
+ * and the suggested order
+ */
+template <size_t N>
+std::string formatReport(const Layout<N>& layout) {
+  std::string out;
+  const double padding_share = layout.size == 0 ? 0 : 100.0 * static_cast<double>(paddingBytes(layout)) / static_cast<double>(layout.size);
+  detail::appendf(out, "%.*s: %zu bytes, align %zu, %zu bytes of fields, %zu bytes of padding (%.1f%%)\n", static_cast<int>(layout.name.size()), layout.name.data(),
+                  layout.size, layout.align, fieldBytes(layout), paddingBytes(layout), padding_share);
+  detail::appendf(out, "  %6s %5s %5s  %-14s %-18s %s\n", "offset", "size", "align", "field", "type", "line");
+  for (size_t i = 0; i < N; ++i) {
+    const Field& f = layout.fields[i];
+    detail::appendf(out, "  %6zu %5zu %5zu  %-14.*s %-18.*s %s\n", f.offset, f.size, f.align, static_cast<int>(f.name.size()), f.name.data(), static_cast<int>(f.type.size()),
+                    f.type.data(), detail::lineSpan(firstLine(f.offset), lastLine(f.offset, f.size)).c_str());
+    if (const size_t pad = paddingAfter(layout, i); pad != 0) {
+      detail::appendf(out, "  %6zu %5zu %5s  %s\n", f.offset + f.size, pad, "", "<padding>");
+    }
+  }
+  const ArrayFootprint array = arrayFootprint(layout.size);
+  detail::appendf(out, "  in arrays: %.2f records per %zu-byte line, %.2f lines touched per record, %.0f%% of records split across lines\n", array.records_per_line,
+                  kCacheLine, array.lines_per_record, 100.0 * array.straddling);
+
+  const Reordering<N> r = suggestReordering(layout);
+  if (r.size >= layout.size) {
+    out += "  suggested order: keep (reordering does not shrink it)\n";
+    return out;
+  }
+  const ArrayFootprint packed = arrayFootprint(r.size);
+  detail::appendf(out, "  suggested order: %zu bytes (-%zu, %.1f%%), %zu bytes of padding, %.2f lines per record, %.0f%% split:", r.size, layout.size - r.size,
+                  100.0 * static_cast<double>(layout.size - r.size) / static_cast<double>(layout.size), r.padding, packed.lines_per_record, 100.0 * packed.straddling);
+  for (size_t i = 0; i < N; ++i) {
+    const Field& f = layout.fields[r.order[i]];
+    detail::appendf(out, "%s %.*s@%zu", i == 0 ? "" : ",", static_cast<int>(f.name.size()), f.name.data(), r.offsets[i]);
+  }
+  out += '\n';
+  return out;
+}
+
+}  // namespace csc450::layout
+
+// Field descriptor for describe(): name, type, offset, size and alignment of Struct::member
+#define CSC450_LAYOUT_FIELD(Struct, member)                                                                                                                   \
+  ::csc450::layout::Field {                                                                                                                                   \
+    #member, ::csc450::layout::typeName<decltype(Struct::member)>(), offsetof(Struct, member), sizeof(Struct::member), alignof(decltype(Struct::member)) \
+  }
+
+#endif  // CSC450_MODULE1_PERF_TYPE_LAYOUT_H_
@@ -0,0 +1,273 @@
+/**
+ * Bounded, allocation-free line reader for untrusted input
+ *
+ * The secure paths in the Module 2 demos call std::getline into a
+ * std::string and truncate afterwards, so a single hostile line can make
+ * the program allocate gigabytes before the length check runs.
+ * BoundedLineReader copies at most `capacity - 1` bytes of a line into a
+ * caller-provided buffer and then skips the rest of the line without
+ * storing it. Memory use is the caller's buffers, whatever the input.
+ *
+ * Newlines are located with an SSE2/AVX2 compare + movemask scan.
+ * The reader pulls bytes through a Source with `size_t read(char*, size_t)`
+ * returning 0 at end of input; FdSource and IstreamSource are provided.
+ */
+
+#ifndef CSC450_MODULE2_PERF_BOUNDED_READER_H_
+#define CSC450_MODULE2_PERF_BOUNDED_READER_H_
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <stdexcept>
+#include <system_error>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CSC450_READER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace csc450 {
+
+namespace linescan {
+
+namespace detail {
+
+inline const char* findScalar(const char* begin, const char* end) noexcept {
+  const void* hit = std::memchr(begin, '\n', static_cast<size_t>(end - begin));
+  return hit != nullptr ? static_cast<const char*>(hit) : end;
+}
+
+#if defined(CSC450_READER_X86)
+
+inline const char* findSse2(const char* begin, const char* end) noexcept {
+  const __m128i newline = _mm_set1_epi8('\n');
+  const char* p = begin;
+  for (; p + 16 <= end; p += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)));
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+  for (; p < end; ++p) {
+    if (*p == '\n') {
+      return p;
+    }
+  }
+  return end;
+}
+
+// Two 32-byte vectors per step so long lines run at load bandwidth
+__attribute__((target("avx2,bmi"))) inline const char* findAvx2(const char* begin, const char* end) noexcept {
+  const __m256i newline = _mm256_set1_epi8('\n');
+  const char* p = begin;
+  for (; p + 64 <= end; p += 64) {
+    const __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), newline);
+    const __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), newline);
+    const uint64_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(a)) | (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(b))) << 32);
+    if (mask != 0) {
+      return p + __builtin_ctzll(mask);
+    }
+  }
+  return findSse2(p, end);
+}
+
+#endif  // CSC450_READER_X86
+
+using FindFn = const char* (*)(const char*, const char*) noexcept;
+
+inline FindFn selectFind() {
+#if defined(CSC450_READER_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return findAvx2;
+  }
+  return findSse2;
+#else
+  return findScalar;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * Returns a pointer to the first '\n' in [begin, end), or end
+ */
+inline const char* findNewline(const char* begin, const char* end) noexcept {
+  static const detail::FindFn find = detail::selectFind();
+  return find(begin, end);
+}
+
+}  // namespace linescan
+
+/**
+ * Reads from a POSIX file descriptor, retrying on EINTR
+ */
+class FdSource {
+ public:
+  explicit FdSource(int fd) noexcept : fd_(fd) {}
+
+  size_t read(char* buffer, size_t size) {
+    for (;;) {
+      const ssize_t got = ::read(fd_, buffer, size);
+      if (got >= 0) {
+        return static_cast<size_t>(got);
+      }
+      if (errno != EINTR) {
+        throw std::system_error(errno, std::generic_category(), "read");
+      }
+    }
+  }
+
+ private:
+  int fd_;
+};
+
+/**
+ * Reads from a std::istream's buffer without blocking for more than is
+ * already available, and never past a newline: the bytes after the line
+ * stay in the stream, so the reader can be a short-lived local on
+ * interactive std::cin and later reads of the stream see them. (FdSource
+ * cannot give that guarantee; its reader must own the descriptor.)
+ *
+ * Each read() opens an std::istream::sentry first, like any unformatted
+ * input function: the tie()d stream is flushed so a prompt appears before
+ * the read blocks, a stream that is not good() yields 0 with failbit set,
+ * and eofbit / failbit are raised through setstate so the exception mask
+ * applies. gcount() is not updated; the reader's Line carries the counts.
+ *
+ * Cost: bytes after the first come only from what in_avail() reports. A
+ * std::cin still synced with stdio (the default) buffers nothing, so there
+ * every byte is a separate read() with a virtual uflow() call; call
+ * std::ios::sync_with_stdio(false) before reading bulk input from std::cin.
+ */
+class IstreamSource {
+ public:
+  explicit IstreamSource(std::istream& in) noexcept : in_(in) {}
+
+  size_t read(char* buffer, size_t size) {
+    if (size == 0) {
+      return 0;
+    }
+    const std::istream::sentry ok(in_, true);  // flushes tie(); keeps whitespace
+    std::streambuf* buf = in_.rdbuf();
+    if (!ok || buf == nullptr) {
+      return 0;
+    }
+    using traits = std::char_traits<char>;
+    const int first = buf->sbumpc();  // blocks until at least one byte
+    if (first == traits::eof()) {
+      in_.setstate(std::ios_base::eofbit);
+      return 0;
+    }
+    buffer[0] = static_cast<char>(first);
+    size_t got = 1;
+    if (first == '\n') {
+      return got;
+    }
+    // Only bytes already buffered, so this never blocks; sbumpc is an
+    // inline pointer bump while the get area has data
+    std::streamsize available = buf->in_avail();
+    while (got < size && available-- > 0) {
+      const int c = buf->sbumpc();
+      if (c == traits::eof()) {
+        break;
+      }
+      buffer[got++] = static_cast<char>(c);
+      if (c == '\n') {
+        break;
+      }
+    }
+    return got;
+  }
+
+ private:
+  std::istream& in_;
+};
+
+template <typename Source>
+class BoundedLineReader {
+ public:
+  enum class Status { kLine, kEndOfInput };
+
+  struct Line {
+    Status status = Status::kEndOfInput;
+    size_t length = 0;     // bytes stored (excluding the terminator)
+    size_t discarded = 0;  // bytes dropped because the line was too long
+    [[nodiscard]] bool truncated() const noexcept {
+      return discarded != 0;
+    }
+  };
+
+  /**
+   * `scratch` is the read-ahead buffer; both it and every destination
+   * buffer belong to the caller, so the reader never allocates
+   */
+  BoundedLineReader(Source source, char* scratch, size_t scratch_size) : source_(source), scratch_(scratch), scratch_size_(scratch_size) {
+    if (scratch == nullptr || scratch_size == 0) {
+      throw std::invalid_argument("BoundedLineReader: scratch buffer required");
+    }
+  }
+
+  /**
+   * Reads one line into dest (capacity includes the NUL terminator).
+   * The newline is consumed but not stored; a final line without a newline
+   * is still returned as kLine.
+   */
+  Line readLine(char* dest, size_t capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument("BoundedLineReader: destination capacity must be at least 1");
+    }
+    Line line;
+    const size_t limit = capacity - 1;
+    bool saw_any = false;
+    for (;;) {
+      if (begin_ == end_ && !refill()) {
+        dest[line.length] = '\0';
+        line.status = saw_any ? Status::kLine : Status::kEndOfInput;
+        return line;
+      }
+      saw_any = true;
+      const char* start = scratch_ + begin_;
+      const char* stop = scratch_ + end_;
+      const char* newline = linescan::findNewline(start, stop);
+      const size_t chunk = static_cast<size_t>(newline - start);
+
+      const size_t room = limit - line.length;
+      const size_t copy = chunk < room ? chunk : room;
+      std::memcpy(dest + line.length, start, copy);
+      line.length += copy;
+      line.discarded += chunk - copy;
+
+      if (newline != stop) {
+        begin_ += chunk + 1;  // consume the newline too
+        dest[line.length] = '\0';
+        line.status = Status::kLine;
+        return line;
+      }
+      begin_ = end_;
+    }
+  }
+
+ private:
+  bool refill() {
+    begin_ = 0;
+    end_ = source_.read(scratch_, scratch_size_);
+    return end_ != 0;
+  }
+
+  Source source_;
+  char* scratch_;
+  size_t scratch_size_;
+  size_t begin_ = 0;
+  size_t end_ = 0;
+};
+
+}  // namespace csc450
+
+#endif  // CSC450_MODULE2_PERF_BOUNDED_READER_H_
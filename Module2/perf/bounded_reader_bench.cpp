@@ -0,0 +1,264 @@
+/**
+ * Bounded line reader benchmark
+ *
+ * Throughput: lines/sec over an in-memory corpus of short lines for
+ *   bounded_reader   BoundedLineReader into a 256-byte buffer
+ *   std_getline      std::getline into a std::string (the demos' approach)
+ * plus the raw newline search (SIMD vs memchr) in GB/s.
+ *
+ * Adversarial: a single line of --line-bytes 'A's (1 GiB by default) is
+ * generated on the fly and read with a 16-byte limit. Peak RSS growth is
+ * reported for the bounded reader and for std::getline on a line of
+ * --getline-bytes (smaller by default, since it really allocates it).
+ *
+ * Usage: bounded_reader_bench [--line-bytes N] [--getline-bytes N] [--min-time SECONDS]
+ */
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "bounded_reader.h"
+
+namespace {
+
+constexpr size_t kChunk = 64 * 1024;
+
+long peakRssKb() {
+  rusage usage{};
+  ::getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/**
+ * Produces `line_bytes` 'A's, a newline, then "ok\n", without storing them
+ */
+class AdversarialSource {
+ public:
+  explicit AdversarialSource(size_t line_bytes) : remaining_(line_bytes) {}
+
+  size_t read(char* buffer, size_t size) {
+    if (remaining_ > 0) {
+      const size_t n = std::min(size, remaining_);
+      std::memset(buffer, 'A', n);
+      remaining_ -= n;
+      return n;
+    }
+    const size_t n = std::min(size, sizeof(kTail) - 1 - tail_pos_);
+    std::memcpy(buffer, kTail + tail_pos_, n);
+    tail_pos_ += n;
+    return n;
+  }
+
+ private:
+  static constexpr char kTail[] = "\nok\n";
+  size_t remaining_;
+  size_t tail_pos_ = 0;
+};
+
+/**
+ * Streambuf over an AdversarialSource, so std::getline sees the same input
+ */
+class AdversarialStreambuf : public std::streambuf {
+ public:
+  explicit AdversarialStreambuf(size_t line_bytes) : source_(line_bytes), buffer_(kChunk) {}
+
+ protected:
+  int_type underflow() override {
+    const size_t got = source_.read(buffer_.data(), buffer_.size());
+    if (got == 0) {
+      return traits_type::eof();
+    }
+    setg(buffer_.data(), buffer_.data(), buffer_.data() + got);
+    return traits_type::to_int_type(buffer_[0]);
+  }
+
+ private:
+  AdversarialSource source_;
+  std::vector<char> buffer_;
+};
+
+/**
+ * Hands out an in-memory corpus in read()-sized pieces
+ */
+class MemorySource {
+ public:
+  MemorySource(const char* data, size_t size) : data_(data), size_(size) {}
+
+  size_t read(char* buffer, size_t size) {
+    const size_t n = std::min(size, size_ - pos_);
+    std::memcpy(buffer, data_ + pos_, n);
+    pos_ += n;
+    return n;
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t pos_ = 0;
+};
+
+// Name-like lines of 1..80 bytes
+std::string makeCorpus(size_t bytes, size_t& lines) {
+  std::string corpus;
+  corpus.reserve(bytes + 128);
+  uint32_t state = 0xBADC0DEu;
+  lines = 0;
+  while (corpus.size() < bytes) {
+    state = state * 1664525u + 1013904223u;
+    const size_t length = 1 + (state >> 24) % 80;
+    for (size_t i = 0; i < length; ++i) {
+      corpus.push_back(static_cast<char>('a' + (i * 7 + state) % 26));
+    }
+    corpus.push_back('\n');
+    ++lines;
+  }
+  return corpus;
+}
+
+struct AdversarialResult {
+  size_t line_bytes = 0;
+  size_t kept = 0;
+  size_t discarded = 0;
+  bool next_line_ok = false;
+  long rss_growth_kb = 0;
+};
+
+AdversarialResult adversarialBounded(size_t line_bytes) {
+  AdversarialResult result;
+  result.line_bytes = line_bytes;
+  const long before = peakRssKb();
+  char scratch[kChunk];
+  char name[16];
+  csc450::BoundedLineReader<AdversarialSource> reader(AdversarialSource(line_bytes), scratch, sizeof(scratch));
+  const auto line = reader.readLine(name, sizeof(name));
+  result.kept = line.length;
+  result.discarded = line.discarded;
+  const auto next = reader.readLine(name, sizeof(name));
+  result.next_line_ok = next.status == decltype(next.status)::kLine && std::strcmp(name, "ok") == 0;
+  result.rss_growth_kb = peakRssKb() - before;
+  return result;
+}
+
+AdversarialResult adversarialGetline(size_t line_bytes) {
+  AdversarialResult result;
+  result.line_bytes = line_bytes;
+  const long before = peakRssKb();
+  AdversarialStreambuf buffer(line_bytes);
+  std::istream in(&buffer);
+  std::string line;
+  std::getline(in, line);
+  result.kept = std::min<size_t>(line.size(), 15);  // truncated afterwards, as the demos do
+  result.discarded = line.size() - result.kept;
+  std::string next;
+  std::getline(in, next);
+  result.next_line_ok = next == "ok";
+  result.rss_growth_kb = peakRssKb() - before;
+  return result;
+}
+
+void writeAdversarial(csc450::bench::JsonWriter& json, const char* method, const AdversarialResult& result) {
+  json.beginObject();
+  json.field("method", method);
+  json.field("line_bytes", result.line_bytes);
+  json.field("bytes_kept", result.kept);
+  json.field("bytes_discarded", result.discarded);
+  json.field("next_line_intact", result.next_line_ok);
+  json.field("peak_rss_growth_kb", static_cast<int64_t>(result.rss_growth_kb));
+  json.endObject();
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    size_t line_bytes = size_t{1} << 30;
+    size_t getline_bytes = size_t{256} << 20;
+    double min_time = 0.1;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--line-bytes" && i + 1 < argc) {
+        line_bytes = std::strtoull(argv[++i], nullptr, 10);
+      } else if (arg == "--getline-bytes" && i + 1 < argc) {
+        getline_bytes = std::strtoull(argv[++i], nullptr, 10);
+      } else if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--line-bytes N] [--getline-bytes N] [--min-time SECONDS]\n";
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Adversarial runs first, before the corpus raises the peak RSS
+    const AdversarialResult bounded = adversarialBounded(line_bytes);
+    const AdversarialResult getline = adversarialGetline(getline_bytes);
+
+    size_t lines = 0;
+    const std::string corpus = makeCorpus(size_t{32} << 20, lines);
+
+    const double bounded_ns = csc450::bench::nsPerOp([&] {
+      char scratch[kChunk];
+      char line[256];
+      csc450::BoundedLineReader<MemorySource> reader(MemorySource(corpus.data(), corpus.size()), scratch, sizeof(scratch));
+      size_t total = 0;
+      while (reader.readLine(line, sizeof(line)).status == csc450::BoundedLineReader<MemorySource>::Status::kLine) {
+        ++total;
+      }
+      csc450::bench::doNotOptimize(total);
+    }, min_time, 3);
+
+    const double getline_ns = csc450::bench::nsPerOp([&] {
+      std::istringstream in(corpus);
+      std::string line;
+      size_t total = 0;
+      while (std::getline(in, line)) {
+        ++total;
+      }
+      csc450::bench::doNotOptimize(total);
+    }, min_time, 3);
+
+    // Raw newline search over a single long line
+    const std::string haystack(size_t{16} << 20, 'A');
+    const char* hay_end = haystack.data() + haystack.size();
+    const double simd_ns = csc450::bench::nsPerOp([&] { csc450::bench::doNotOptimize(csc450::linescan::findNewline(haystack.data(), hay_end)); }, min_time);
+    const double memchr_ns = csc450::bench::nsPerOp([&] { csc450::bench::doNotOptimize(std::memchr(haystack.data(), '\n', haystack.size())); }, min_time);
+
+    const auto linesPerSec = [&](double ns) { return static_cast<double>(lines) / (ns * 1e-9); };
+    const auto gbPerSec = [&](double ns) { return static_cast<double>(haystack.size()) / ns; };
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "bounded_line_reader");
+    json.field("corpus_bytes", corpus.size());
+    json.field("corpus_lines", lines);
+    json.key("throughput").beginArray();
+    json.beginObject().field("method", "bounded_reader").field("lines_per_sec", linesPerSec(bounded_ns)).endObject();
+    json.beginObject().field("method", "std_getline").field("lines_per_sec", linesPerSec(getline_ns)).endObject();
+    json.endArray();
+    json.key("newline_search_gb_per_sec").beginObject();
+    json.field("simd", gbPerSec(simd_ns));
+    json.field("memchr", gbPerSec(memchr_ns));
+    json.endObject();
+    json.key("adversarial").beginArray();
+    writeAdversarial(json, "bounded_reader", bounded);
+    writeAdversarial(json, "std_getline", getline);
+    json.endArray();
+    json.endObject();
+    std::cout << '\n';
+    return bounded.next_line_ok && bounded.kept == 15 ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "bounded_reader_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
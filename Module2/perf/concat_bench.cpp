@@ -0,0 +1,251 @@
+/**
+ * Concatenation strategy benchmark for the Module 2 concat program
+ *
+ * csc450_mod2_critthink.cpp joins its two inputs with `first + second`.
+ * This benchmark times the alternatives over operand sizes from a few bytes
+ * (inside the small-string buffer) up to 1 MB, and reports which strategy
+ * wins at each size so the point where the SSO boundary flips the best
+ * choice is visible in the JSON.
+ *
+ * Strategies:
+ *   operator_plus         std::string r = a + b;
+ *   append_reserve        r.reserve(a+b); r.append(a).append(b);
+ *   ostringstream         os << a << b; r = os.str();
+ *   std_format            std::format("{}{}", a, b)   (null when unavailable)
+ *   resize_and_overwrite  C++23 member when available, otherwise the
+ *                         resize() + memcpy equivalent (pays a zero fill)
+ *   arena_memcpy          memcpy both operands into a bump arena
+ *
+ * Usage: concat_bench [--min-time SECONDS] [--out FILE]
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <version>
+
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+#include "bench_util.h"
+
+namespace {
+
+/**
+ * Bump arena that rewinds when full, standing in for a per-request arena
+ */
+class BumpArena {
+ public:
+  explicit BumpArena(size_t capacity) : storage_(capacity) {}
+
+  char* concat(const std::string& a, const std::string& b) {
+    const size_t total = a.size() + b.size();
+    if (used_ + total > storage_.size()) {
+      used_ = 0;  // request boundary: everything before is released at once
+    }
+    char* dest = storage_.data() + used_;
+    std::memcpy(dest, a.data(), a.size());
+    std::memcpy(dest + a.size(), b.data(), b.size());
+    used_ += total;
+    return dest;
+  }
+
+ private:
+  std::vector<char> storage_;
+  size_t used_ = 0;
+};
+
+std::string resizeAndOverwrite(const std::string& a, const std::string& b) {
+  std::string result;
+#if defined(__cpp_lib_string_resize_and_overwrite)
+  result.resize_and_overwrite(a.size() + b.size(), [&](char* buffer, size_t n) {
+    std::memcpy(buffer, a.data(), a.size());
+    std::memcpy(buffer + a.size(), b.data(), b.size());
+    return n;
+  });
+#else
+  result.resize(a.size() + b.size());
+  std::memcpy(result.data(), a.data(), a.size());
+  std::memcpy(result.data() + a.size(), b.data(), b.size());
+#endif
+  return result;
+}
+
+struct Strategy {
+  const char* name;
+  bool available;
+};
+
+constexpr Strategy kStrategies[] = {
+    {"operator_plus", true},
+    {"append_reserve", true},
+    {"ostringstream", true},
+#if defined(__cpp_lib_format)
+    {"std_format", true},
+#else
+    {"std_format", false},
+#endif
+    {"resize_and_overwrite", true},
+    {"arena_memcpy", true},
+};
+
+double timeStrategy(size_t index, const std::string& a, const std::string& b, BumpArena& arena, double min_time) {
+  using csc450::bench::doNotOptimize;
+  using csc450::bench::nsPerOp;
+  switch (index) {
+    case 0:
+      return nsPerOp([&] {
+        std::string r = a + b;
+        doNotOptimize(r);
+      }, min_time);
+    case 1:
+      return nsPerOp([&] {
+        std::string r;
+        r.reserve(a.size() + b.size());
+        r.append(a).append(b);
+        doNotOptimize(r);
+      }, min_time);
+    case 2:
+      return nsPerOp([&] {
+        std::ostringstream os;
+        os << a << b;
+        std::string r = os.str();
+        doNotOptimize(r);
+      }, min_time);
+    case 3:
+#if defined(__cpp_lib_format)
+      return nsPerOp([&] {
+        std::string r = std::format("{}{}", a, b);
+        doNotOptimize(r);
+      }, min_time);
+#else
+      return -1;
+#endif
+    case 4:
+      return nsPerOp([&] {
+        std::string r = resizeAndOverwrite(a, b);
+        doNotOptimize(r);
+      }, min_time);
+    case 5:
+      return nsPerOp([&] {
+        char* r = arena.concat(a, b);
+        doNotOptimize(r);
+        csc450::bench::clobberMemory();
+      }, min_time);
+    default:
+      return -1;
+  }
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    double min_time = 0.02;
+    std::string out_path;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else if (arg == "--out" && i + 1 < argc) {
+        out_path = argv[++i];
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--min-time SECONDS] [--out FILE]\n";
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Operand sizes straddle the SSO capacity (15 in libstdc++, 22 in libc++)
+    const std::vector<size_t> operand_sizes = {1, 4, 7, 8, 10, 11, 12, 15, 16, 32, 64, 256, 1024, 4096, 65536, 1 << 20};
+    const size_t sso_capacity = std::string().capacity();
+    constexpr size_t kStrategyCount = sizeof(kStrategies) / sizeof(kStrategies[0]);
+
+    // Large enough to hold several 2 MB results before rewinding
+    BumpArena arena(16u << 20);
+
+    std::ofstream file_out;
+    if (!out_path.empty()) {
+      file_out.open(out_path);
+      if (!file_out) {
+        throw std::runtime_error("Cannot open output file: " + out_path);
+      }
+    }
+    std::ostream& out = out_path.empty() ? std::cout : file_out;
+    csc450::bench::JsonWriter json(out);
+
+    json.beginObject();
+    json.field("benchmark", "concat_strategies");
+    json.field("sso_capacity", sso_capacity);
+#if defined(__cpp_lib_string_resize_and_overwrite)
+    json.field("native_resize_and_overwrite", true);
+#else
+    json.field("native_resize_and_overwrite", false);
+#endif
+    json.key("results").beginArray();
+
+    std::string previous_best;
+    std::vector<std::pair<size_t, std::string>> best_changes;
+    for (const size_t size : operand_sizes) {
+      const std::string a(size, 'a');
+      const std::string b(size, 'b');
+
+      json.beginObject();
+      json.field("operand_bytes", size);
+      json.field("result_bytes", 2 * size);
+      json.field("result_fits_sso", 2 * size <= sso_capacity);
+      json.key("ns_per_op").beginObject();
+
+      std::string best;
+      double best_ns = 0;
+      for (size_t s = 0; s < kStrategyCount; ++s) {
+        json.key(kStrategies[s].name);
+        if (!kStrategies[s].available) {
+          json.null();
+          continue;
+        }
+        const double ns = timeStrategy(s, a, b, arena, min_time);
+        json.value(ns);
+        // The arena is reported but excluded from "best" among std::string
+        // producers: it returns a view whose lifetime the caller must manage
+        if (s != 5 && (best.empty() || ns < best_ns)) {
+          best = kStrategies[s].name;
+          best_ns = ns;
+        }
+      }
+      json.endObject();
+      json.field("best_std_string", best);
+      json.endObject();
+
+      if (best != previous_best) {
+        best_changes.emplace_back(2 * size, best);
+        previous_best = best;
+      }
+    }
+    json.endArray();
+
+    json.key("best_changes").beginArray();
+    for (const auto& [result_bytes, name] : best_changes) {
+      json.beginObject();
+      json.field("from_result_bytes", result_bytes);
+      json.field("crosses_sso", result_bytes > sso_capacity);
+      json.field("best_std_string", name);
+      json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    out << '\n';
+    return EXIT_SUCCESS;
+
+  } catch (const std::exception& e) {
+    std::cerr << "concat_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,140 @@
+/**
+ * Interned concatenation workload for the Module 2 concat program
+ *
+ * Runs the same "take two strings, concatenate them" job as
+ * Module2/critthink/csc450_mod2_critthink.cpp, but over a whole batch of
+ * pairs and through the StringInterner / ConcatCache layer, then reports how
+ * much memory interning saved and how often the caches hit.
+ *
+ * Usage:
+ *   concat_intern < pairs.txt          (first/second string on alternate lines)
+ *   concat_intern --synthetic 1000000  (generated names with shared prefixes)
+ *
+ * Baseline memory is what the original program would hold if it kept every
+ * input and result as its own std::string (object header plus heap buffer
+ * whenever the text does not fit the small-string buffer).
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "string_intern.h"
+
+namespace {
+
+// Bytes a std::string holding `length` characters occupies (object + heap)
+size_t stdStringFootprint(size_t length) {
+  const std::string probe;
+  const size_t sso_capacity = probe.capacity();
+  return sizeof(std::string) + (length > sso_capacity ? length + 1 : 0);
+}
+
+// Deterministic workload: a small vocabulary combined with repeated prefixes
+std::vector<std::string> syntheticLines(size_t pair_count) {
+  static const char* const kPrefixes[] = {"Mr. ", "Ms. ", "Dr. ", "Prof. ", "user_", "tmp/", "https://example.com/"};
+  static const char* const kNames[] = {"Alice", "Bob", "Carol", "Dave", "Eve", "Mallory", "Trent", "Peggy", "Victor", "Walter"};
+  constexpr size_t kPrefixCount = sizeof(kPrefixes) / sizeof(kPrefixes[0]);
+  constexpr size_t kNameCount = sizeof(kNames) / sizeof(kNames[0]);
+
+  std::vector<std::string> lines;
+  lines.reserve(pair_count * 2);
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < pair_count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    lines.emplace_back(kPrefixes[state % kPrefixCount]);
+    std::string name = kNames[(state >> 16) % kNameCount];
+    // ~1 in 16 names carries a numeric suffix so not everything repeats
+    if (((state >> 32) & 0xF) == 0) {
+      name += std::to_string((state >> 40) % 1000);
+    }
+    lines.push_back(std::move(name));
+  }
+  return lines;
+}
+
+double percent(uint64_t part, uint64_t whole) {
+  return whole == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    std::vector<std::string> lines;
+    if (argc == 3 && std::string(argv[1]) == "--synthetic") {
+      lines = syntheticLines(std::strtoull(argv[2], nullptr, 10));
+    } else if (argc == 1) {
+      std::ios_base::sync_with_stdio(false);
+      std::string line;
+      while (std::getline(std::cin, line)) {
+        lines.push_back(std::move(line));
+      }
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--synthetic PAIRS]  (pairs read from stdin by default)\n";
+      return EXIT_FAILURE;
+    }
+
+    const size_t pair_count = lines.size() / 2;
+    csc450::StringInterner interner(1024);
+    csc450::ConcatCache cache(interner, 1024);
+
+    size_t baseline_bytes = 0;
+    size_t result_chars = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < pair_count; ++i) {
+      const std::string& first = lines[2 * i];
+      const std::string& second = lines[2 * i + 1];
+      const auto left = interner.intern(first);
+      const auto right = interner.intern(second);
+      const auto joined = cache.concat(left, right);
+      result_chars += interner.view(joined).size();
+      baseline_bytes += stdStringFootprint(first.size()) + stdStringFootprint(second.size()) +
+                        stdStringFootprint(first.size() + second.size());
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Interned footprint: arena blocks, lookup tables, and one 4-byte ID per
+    // input/result that the caller keeps instead of a std::string
+    const size_t id_bytes = pair_count * 3 * sizeof(csc450::StringInterner::Id);
+    const size_t interned_bytes = interner.arena().bytesReserved() + interner.indexBytes() + cache.indexBytes() + id_bytes;
+
+    const auto& istats = interner.stats();
+    const auto& cstats = cache.stats();
+
+    std::cout << "=== Interned Concatenation Report ===\n";
+    std::cout << "Pairs processed:        " << pair_count << '\n';
+    std::cout << "Result characters:      " << result_chars << '\n';
+    std::cout << "Distinct strings:       " << interner.size() << '\n';
+    std::cout << "Distinct pairs cached:  " << cache.size() << '\n';
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Intern hit ratio:       " << percent(istats.hits, istats.lookups) << "% (" << istats.hits << '/' << istats.lookups
+              << ")\n";
+    std::cout << "Concat cache hit ratio: " << percent(cstats.hits, cstats.lookups) << "% (" << cstats.hits << '/' << cstats.lookups
+              << ")\n";
+    std::cout << "Bytes requested:        " << istats.bytes_requested << '\n';
+    std::cout << "Bytes stored in arena:  " << istats.bytes_stored << " (" << interner.arena().bytesReserved() << " reserved)\n";
+    std::cout << "Baseline std::string:   " << baseline_bytes << " bytes\n";
+    std::cout << "Interned footprint:     " << interned_bytes << " bytes\n";
+    if (baseline_bytes >= interned_bytes) {
+      std::cout << "Memory saved:           " << (baseline_bytes - interned_bytes) << " bytes ("
+                << percent(baseline_bytes - interned_bytes, baseline_bytes) << "%)\n";
+    } else {
+      std::cout << "Memory saved:           none (workload has too little repetition, overhead "
+                << (interned_bytes - baseline_bytes) << " bytes)\n";
+    }
+    std::cout << "Elapsed:                " << elapsed * 1e3 << " ms ("
+              << (elapsed > 0 ? static_cast<double>(pair_count) / elapsed / 1e6 : 0.0) << " M pairs/s)\n";
+    return EXIT_SUCCESS;
+
+  } catch (const std::exception& e) {
+    std::cerr << "concat_intern failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
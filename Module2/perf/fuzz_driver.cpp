@@ -0,0 +1,306 @@
+/**
+ * Standalone, coverage-guided driver for libFuzzer-style targets
+ *
+ * Used when libFuzzer is not available (GCC builds). It runs the seed
+ * corpus, then mutates corpus entries and keeps every input that reaches a
+ * new program counter. Coverage comes from GCC's
+ * -fsanitize-coverage=trace-pc: each instrumented basic block calls
+ * __sanitizer_cov_trace_pc(), defined here. This file itself must not be
+ * instrumented.
+ *
+ * A crash (sanitizer report, fatal signal or escaped exception) saves the
+ * current input as crash-<hash> in the working directory.
+ *
+ * Usage: fuzz_<target> [--seconds N] [--runs N] [--seed N] [--max-len N]
+ *                      [--out DIR] [CORPUS_DIR...]
+ * Prints a JSON summary with execs/sec and coverage on exit.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench_util.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+extern "C" void __sanitizer_set_death_callback(void (*callback)()) __attribute__((weak));
+
+namespace {
+
+// Program counters seen so far (open addressing; 0 marks a free slot)
+constexpr size_t kPcSlots = size_t{1} << 18;
+uintptr_t g_pcs[kPcSlots];
+size_t g_pc_count = 0;
+
+// Input currently executing, for the crash handlers
+const uint8_t* g_current = nullptr;
+size_t g_current_size = 0;
+
+uint64_t fnv1a(const uint8_t* data, size_t size) {
+  uint64_t hash = 1469598103934665603ull;
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ data[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+// Async-signal-safe: only open/write/close and stack buffers
+void saveCrashInput() {
+  if (g_current == nullptr) {
+    return;
+  }
+  char name[32] = "crash-";
+  uint64_t hash = fnv1a(g_current, g_current_size);
+  for (int i = 0; i < 16; ++i) {
+    name[6 + i] = "0123456789abcdef"[(hash >> (60 - 4 * i)) & 0xF];
+  }
+  name[22] = '\0';
+  const int fd = ::open(name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd >= 0) {
+    size_t done = 0;
+    while (done < g_current_size) {
+      const ssize_t n = ::write(fd, g_current + done, g_current_size - done);
+      if (n <= 0) {
+        break;
+      }
+      done += static_cast<size_t>(n);
+    }
+    ::close(fd);
+    static const char kNote[] = "fuzz_driver: crashing input saved as ";
+    (void)!::write(STDERR_FILENO, kNote, sizeof(kNote) - 1);
+    (void)!::write(STDERR_FILENO, name, 22);
+    (void)!::write(STDERR_FILENO, "\n", 1);
+  }
+  g_current = nullptr;
+}
+
+extern "C" void onFatalSignal(int signal) {
+  saveCrashInput();
+  std::signal(signal, SIG_DFL);
+  std::raise(signal);
+}
+
+std::string hexName(const std::string& data) {
+  char name[17];
+  std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(fnv1a(reinterpret_cast<const uint8_t*>(data.data()), data.size())));
+  return name;
+}
+
+class Mutator {
+ public:
+  Mutator(uint64_t seed, size_t max_len) : rng_(seed), max_len_(max_len) {}
+
+  std::string mutate(const std::string& base, const std::vector<std::string>& corpus) {
+    std::string data = base;
+    const int rounds = 1 + static_cast<int>(below(4));
+    for (int r = 0; r < rounds; ++r) {
+      mutateOnce(data, corpus);
+    }
+    if (data.size() > max_len_) {
+      data.resize(max_len_);
+    }
+    return data;
+  }
+
+  size_t below(size_t n) {
+    return n == 0 ? 0 : static_cast<size_t>(rng_() % n);
+  }
+
+ private:
+  // Tokens the demo parsers care about (line ends, signs, limits, format)
+  static constexpr std::string_view kDictionary[] = {"\n", "\r\n", " ", "\t", "-", "+", "0", "200", "201", "-1", "2147483647", "2147483648", "-2147483649",
+                                                     "99999999999999999999", "%x", "%n", "%s", std::string_view("\0", 1), "\x7f", "\xc3\xa9", "\xff"};
+
+  void mutateOnce(std::string& data, const std::vector<std::string>& corpus) {
+    switch (below(8)) {
+      case 0:  // flip a bit
+        if (!data.empty()) {
+          data[below(data.size())] ^= static_cast<char>(1u << below(8));
+        }
+        break;
+      case 1:  // overwrite a byte
+        if (!data.empty()) {
+          data[below(data.size())] = static_cast<char>(below(256));
+        }
+        break;
+      case 2:  // insert a byte
+        data.insert(data.begin() + static_cast<std::ptrdiff_t>(below(data.size() + 1)), static_cast<char>(below(256)));
+        break;
+      case 3:  // erase a range
+        if (!data.empty()) {
+          const size_t at = below(data.size());
+          data.erase(at, 1 + below(std::min<size_t>(16, data.size() - at)));
+        }
+        break;
+      case 4: {  // duplicate a range (grows lines past the limits)
+        if (!data.empty()) {
+          const size_t at = below(data.size());
+          const std::string piece = data.substr(at, 1 + below(std::min<size_t>(64, data.size() - at)));
+          data.insert(below(data.size() + 1), piece);
+        }
+        break;
+      }
+      case 5: {  // insert a dictionary token
+        data.insert(below(data.size() + 1), kDictionary[below(std::size(kDictionary))]);
+        break;
+      }
+      case 6:  // splice with another corpus entry
+        if (!corpus.empty()) {
+          const std::string& other = corpus[below(corpus.size())];
+          data = data.substr(0, below(data.size() + 1)) + other.substr(below(other.size() + 1));
+        }
+        break;
+      default:  // truncate
+        data.resize(below(data.size() + 1));
+        break;
+    }
+  }
+
+  std::mt19937_64 rng_;
+  size_t max_len_;
+};
+
+}  // anonymous namespace
+
+extern "C" void __sanitizer_cov_trace_pc() {
+  const auto pc = reinterpret_cast<uintptr_t>(__builtin_return_address(0));
+  size_t slot = (pc * 0x9E3779B97F4A7C15ull) >> (64 - 18);
+  for (;;) {
+    const uintptr_t seen = g_pcs[slot];
+    if (seen == pc) {
+      return;
+    }
+    if (seen == 0) {
+      if (g_pc_count < kPcSlots / 2) {
+        g_pcs[slot] = pc;
+        ++g_pc_count;
+      }
+      return;
+    }
+    slot = (slot + 1) & (kPcSlots - 1);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  double seconds = 10.0;
+  uint64_t max_runs = 0;
+  uint64_t seed = 1;
+  size_t max_len = 4096;
+  std::string out_dir;
+  std::vector<std::string> corpus_dirs;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--seconds" && i + 1 < argc) {
+      seconds = std::strtod(argv[++i], nullptr);
+    } else if (arg == "--runs" && i + 1 < argc) {
+      max_runs = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--seed" && i + 1 < argc) {
+      seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--max-len" && i + 1 < argc) {
+      max_len = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--out" && i + 1 < argc) {
+      out_dir = argv[++i];
+    } else if (!arg.empty() && arg[0] != '-') {
+      corpus_dirs.push_back(arg);
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--seconds N] [--runs N] [--seed N] [--max-len N] [--out DIR] [CORPUS_DIR...]\n";
+      return EXIT_FAILURE;
+    }
+  }
+#if defined(CSC450_FUZZ_DEFAULT_CORPUS)
+  if (corpus_dirs.empty()) {
+    corpus_dirs.push_back(CSC450_FUZZ_DEFAULT_CORPUS);
+  }
+#endif
+
+  if (__sanitizer_set_death_callback != nullptr) {
+    __sanitizer_set_death_callback(saveCrashInput);
+  }
+  for (const int signal : {SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT}) {
+    std::signal(signal, onFatalSignal);
+  }
+
+  std::string current;
+  try {
+    std::vector<std::string> corpus;
+    for (const auto& dir : corpus_dirs) {
+      for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        if (entry.is_regular_file()) {
+          std::ifstream file(entry.path(), std::ios::binary);
+          corpus.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+      }
+    }
+    if (corpus.empty()) {
+      corpus.emplace_back();
+    }
+    const size_t seeds = corpus.size();
+
+    uint64_t execs = 0;
+    const auto run = [&](const std::string& input) {
+      current = input;
+      g_current = reinterpret_cast<const uint8_t*>(current.data());
+      g_current_size = current.size();
+      const size_t before = g_pc_count;
+      LLVMFuzzerTestOneInput(g_current, g_current_size);
+      g_current = nullptr;
+      ++execs;
+      return g_pc_count > before;
+    };
+
+    const auto start = csc450::bench::Clock::now();
+    for (const auto& input : corpus) {
+      run(input);
+    }
+    const size_t seed_coverage = g_pc_count;
+
+    Mutator mutator(seed, max_len);
+    while ((max_runs == 0 || execs < max_runs) && (seconds <= 0 || csc450::bench::secondsSince(start) < seconds)) {
+      std::string input = mutator.mutate(corpus[mutator.below(corpus.size())], corpus);
+      if (run(input)) {
+        if (!out_dir.empty()) {
+          std::ofstream(std::filesystem::path(out_dir) / hexName(input), std::ios::binary) << input;
+        }
+        corpus.push_back(std::move(input));
+      }
+    }
+    const double elapsed = csc450::bench::secondsSince(start);
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("fuzz_target", std::filesystem::path(argv[0]).filename().string());
+    json.field("execs", execs);
+    json.field("seconds", elapsed);
+    json.field("execs_per_sec", static_cast<double>(execs) / elapsed);
+    json.field("coverage_instrumented", g_pc_count != 0);
+    json.field("pcs_covered_by_seeds", seed_coverage);
+    json.field("pcs_covered", g_pc_count);
+    json.field("seed_inputs", seeds);
+    json.field("corpus_size", corpus.size());
+    json.endObject();
+    std::cout << '\n';
+    return EXIT_SUCCESS;
+
+  } catch (const std::exception& e) {
+    // An exception escaping the target counts as a crash, as in libFuzzer
+    saveCrashInput();
+    std::cerr << "fuzz_driver failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,24 @@
+/**
+ * Fuzz target: demonstrate_input_validation_issues() from
+ * Module4/reference/iostream_vulnerabilities.cpp
+ *
+ * The input is what is typed at the "Enter your age" prompt. The demo is
+ * called twice on the same stream so the recovery path (clear + ignore
+ * after a failed extraction) is exercised as well.
+ * Seeds: fuzz_corpus/fuzz_input_validation/
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "fuzz_support.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  csc450::fuzz::InputStreambuf input(data, size);
+  csc450::fuzz::DiscardStreambuf output;
+  std::istream in(&input);
+  std::ostream out(&output);
+  demonstrate_input_validation_issues(in, out);
+  demonstrate_input_validation_issues(in, out);
+  return 0;
+}
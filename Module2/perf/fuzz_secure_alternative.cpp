@@ -0,0 +1,20 @@
+/**
+ * Fuzz target: secureAlternative() from buffer_overflow_demo.cpp
+ *
+ * The whole input is the line typed at the "Enter your name" prompt
+ * (and whatever follows it). Seeds: fuzz_corpus/fuzz_secure_alternative/
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "fuzz_support.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  csc450::fuzz::InputStreambuf input(data, size);
+  csc450::fuzz::DiscardStreambuf output;
+  std::istream in(&input);
+  std::ostream out(&output);
+  secureAlternative(in, out);
+  return 0;
+}
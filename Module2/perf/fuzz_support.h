@@ -0,0 +1,61 @@
+/**
+ * Shared pieces for the demo fuzz targets
+ *
+ * The demo input paths take (std::istream&, std::ostream&) so a fuzz target
+ * can feed them a byte buffer and throw the output away. Each target
+ * defines the libFuzzer entry point
+ *
+ *     extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+ *
+ * and links either against libFuzzer (clang, CSC450_FUZZ_LIBFUZZER=ON) or
+ * against the standalone driver in fuzz_driver.cpp.
+ */
+
+#ifndef CSC450_MODULE2_PERF_FUZZ_SUPPORT_H_
+#define CSC450_MODULE2_PERF_FUZZ_SUPPORT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+
+namespace csc450 {
+
+namespace fuzz {
+
+/**
+ * Read-only view of the fuzz input; no copy per execution
+ */
+class InputStreambuf : public std::streambuf {
+ public:
+  InputStreambuf(const uint8_t* data, size_t size) {
+    // The get area is never written through (pbackfail is not overridden)
+    char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+    setg(begin, begin, begin + size);
+  }
+};
+
+/**
+ * Accepts and drops everything, so formatting code still runs
+ */
+class DiscardStreambuf : public std::streambuf {
+ protected:
+  int_type overflow(int_type c) override {
+    return traits_type::not_eof(c);
+  }
+  std::streamsize xsputn(const char*, std::streamsize count) override {
+    return count;
+  }
+};
+
+}  // namespace fuzz
+
+}  // namespace csc450
+
+// Entry points exported by the demos (compiled with CSC450_FUZZING so they
+// leave out their interactive main)
+void secureAlternative(std::istream& in, std::ostream& out);
+void demonstrate_input_validation_issues(std::istream& in, std::ostream& out);
+
+#endif  // CSC450_MODULE2_PERF_FUZZ_SUPPORT_H_
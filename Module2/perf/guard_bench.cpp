@@ -0,0 +1,189 @@
+/**
+ * Guard-page allocator vs canary checking: cost and memory overhead
+ *
+ * Modes, each timed as allocate + write every byte + release:
+ *   malloc          plain malloc/free (baseline, no detection)
+ *   canary          malloc with a 16-byte canary after the buffer, compared
+ *                   on release like vulnerableFunction() does with strcmp
+ *   guard_every     GuardedAllocator, every allocation guarded
+ *   guard_1_in_N    GuardedAllocator sampling modes: only the sampled
+ *                   allocations trap, so they report detects_at_write
+ *                   false and the measured detection_probability (~1/N)
+ *   guard_uncached  every allocation guarded, mappings never reused
+ *                   (fresh mmap + mprotect each time, also traps UAF)
+ *
+ * Also verifies, in a forked child, that a one-byte overflow of a guarded
+ * buffer dies with SIGSEGV at the write.
+ *
+ * Usage: guard_bench [--min-time SECONDS]
+ */
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "guarded_alloc.h"
+
+namespace {
+
+constexpr char kCanary[16] = "CANARY_VALUE__";
+
+size_t mallocFootprint([[maybe_unused]] void* pointer, [[maybe_unused]] size_t requested) {
+#if defined(__GLIBC__)
+  return malloc_usable_size(pointer) + sizeof(size_t);  // chunk header
+#else
+  return requested + sizeof(size_t);
+#endif
+}
+
+struct ModeResult {
+  std::string name;
+  double ns_per_cycle = 0;
+  double bytes_per_allocation = 0;
+  double overhead_ratio = 0;
+  bool detects_at_write = false;     // every overflow traps at the faulting write
+  double detection_probability = 0;  // share of allocations that got a guard page
+};
+
+ModeResult timeMalloc(size_t size, bool with_canary, double min_time) {
+  ModeResult result;
+  result.name = with_canary ? "canary" : "malloc";
+  const size_t total = size + (with_canary ? sizeof(kCanary) : 0);
+  uint64_t corrupted = 0;
+  result.ns_per_cycle = csc450::bench::nsPerOp([&] {
+    auto* buffer = static_cast<char*>(std::malloc(total));
+    if (buffer == nullptr) {
+      throw std::bad_alloc();
+    }
+    if (with_canary) {
+      std::memcpy(buffer + size, kCanary, sizeof(kCanary));
+    }
+    std::memset(buffer, 'A', size);
+    csc450::bench::clobberMemory();
+    if (with_canary && std::memcmp(buffer + size, kCanary, sizeof(kCanary)) != 0) {
+      ++corrupted;
+    }
+    std::free(buffer);
+  }, min_time);
+  csc450::bench::doNotOptimize(corrupted);
+
+  void* probe = std::malloc(total);
+  result.bytes_per_allocation = static_cast<double>(mallocFootprint(probe, total));
+  std::free(probe);
+  result.overhead_ratio = result.bytes_per_allocation / static_cast<double>(size);
+  return result;
+}
+
+ModeResult timeGuarded(size_t size, size_t sample_every, size_t cached, double min_time) {
+  ModeResult result;
+  result.name = sample_every == 1 ? "guard_every" : "guard_1_in_" + std::to_string(sample_every);
+  if (cached == 0) {
+    result.name = "guard_uncached";
+  }
+  csc450::GuardedAllocator allocator({sample_every, 16, cached});
+  result.ns_per_cycle = csc450::bench::nsPerOp([&] {
+    auto* buffer = static_cast<char*>(allocator.allocate(size));
+    std::memset(buffer, 'A', size);
+    csc450::bench::clobberMemory();
+    allocator.deallocate(buffer);
+  }, min_time);
+  const auto stats = allocator.stats();
+  result.bytes_per_allocation = static_cast<double>(stats.bytes_reserved) / static_cast<double>(stats.allocations);
+  result.overhead_ratio = result.bytes_per_allocation / static_cast<double>(size);
+  result.detection_probability = static_cast<double>(stats.guarded) / static_cast<double>(stats.allocations);
+  result.detects_at_write = sample_every == 1;
+  return result;
+}
+
+/**
+ * Child writes one byte past a guarded 10-byte buffer; the parent expects
+ * it to be killed by SIGSEGV before it can report success
+ */
+bool guardTrapsOverflow() {
+  const pid_t child = ::fork();
+  if (child < 0) {
+    throw std::runtime_error("fork failed");
+  }
+  if (child == 0) {
+    csc450::GuardedAllocator allocator({1, 1, 0});
+    auto* buffer = static_cast<volatile char*>(allocator.allocate(10));
+    for (int i = 0; i <= 10; ++i) {  // off-by-one, like strcpy of a 10-char name
+      buffer[i] = 'A';
+    }
+    ::_exit(0);
+  }
+  int status = 0;
+  ::waitpid(child, &status, 0);
+  return WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    double min_time = 0.05;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--min-time SECONDS]\n";
+        return EXIT_FAILURE;
+      }
+    }
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "guarded_allocator");
+    json.field("page_size", static_cast<size_t>(::sysconf(_SC_PAGESIZE)));
+    json.field("guard_page_traps_off_by_one", guardTrapsOverflow());
+    json.key("results").beginArray();
+    for (const size_t size : {16, 256, 4096, 65536}) {
+      std::vector<ModeResult> modes;
+      modes.push_back(timeMalloc(size, false, min_time));
+      modes.push_back(timeMalloc(size, true, min_time));
+      modes.push_back(timeGuarded(size, 1, 0, min_time));
+      for (const size_t n : {1, 16, 64, 256}) {
+        modes.push_back(timeGuarded(size, n, 64, min_time));
+      }
+      const double canary_ns = modes[1].ns_per_cycle;
+      json.beginObject();
+      json.field("buffer_bytes", size);
+      json.key("modes").beginArray();
+      for (const auto& mode : modes) {
+        json.beginObject();
+        json.field("mode", mode.name);
+        json.field("ns_per_cycle", mode.ns_per_cycle);
+        json.field("cost_vs_canary", mode.ns_per_cycle / canary_ns);
+        json.field("bytes_per_allocation", mode.bytes_per_allocation);
+        json.field("memory_overhead_ratio", mode.overhead_ratio);
+        json.field("detects_at_write", mode.detects_at_write);
+        json.field("detection_probability", mode.detection_probability);
+        json.endObject();
+      }
+      json.endArray();
+      json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    std::cout << '\n';
+    return EXIT_SUCCESS;
+
+  } catch (const std::exception& e) {
+    std::cerr << "guard_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,219 @@
+/**
+ * Guard-page buffer allocator for immediate overflow detection
+ *
+ * The overflow demos detect corruption after the fact by strcmp'ing a
+ * hand-placed canary[16]. Here a buffer is placed so that its last byte
+ * sits directly in front of a PROT_NONE page: the first byte written past
+ * the end raises SIGSEGV at the faulting instruction, long before the
+ * corrupted data is used.
+ *
+ * Guarding costs an mmap/mprotect/munmap and at least two pages per
+ * allocation, so a sampling mode guards only 1 in N allocations (the rest
+ * come from malloc). Over many requests a systematic overflow is still
+ * caught quickly, at a fraction of the cost (the same idea as GWP-ASan).
+ *
+ * Released guarded mappings are kept in a small cache and reused for the
+ * next guarded allocation of the same page count; the guard page stays
+ * PROT_NONE, so reuse needs no system call at all. Set cached_mappings to 0
+ * to unmap on release and also trap use-after-free.
+ *
+ * Limits: only overflows past the end are trapped; with alignment > 1 up to
+ * alignment-1 bytes of slack sit between the buffer end and the guard page.
+ * POSIX only.
+ */
+
+#ifndef CSC450_MODULE2_PERF_GUARDED_ALLOC_H_
+#define CSC450_MODULE2_PERF_GUARDED_ALLOC_H_
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace csc450 {
+
+class GuardedAllocator {
+ public:
+  struct Options {
+    size_t sample_every = 1;  // guard 1 in N allocations (1 = all, 0 = none)
+    size_t alignment = 16;    // power of two; 1 traps off-by-one exactly
+    size_t cached_mappings = 64;  // released guarded mappings kept for reuse
+  };
+
+  struct Stats {
+    uint64_t allocations = 0;
+    uint64_t guarded = 0;
+    uint64_t bytes_requested = 0;
+    uint64_t bytes_reserved = 0;  // cumulative pages mapped / bytes malloc'ed
+  };
+
+  GuardedAllocator() : GuardedAllocator(Options{}) {}
+
+  explicit GuardedAllocator(Options options) : options_(options), page_size_(static_cast<size_t>(::sysconf(_SC_PAGESIZE))) {
+    if (options_.alignment == 0 || (options_.alignment & (options_.alignment - 1)) != 0) {
+      throw std::invalid_argument("GuardedAllocator: alignment must be a power of two");
+    }
+  }
+
+  ~GuardedAllocator() {
+    for (const Mapping& mapping : cache_) {
+      ::munmap(mapping.base, mapping.size);
+    }
+  }
+
+  GuardedAllocator(const GuardedAllocator&) = delete;
+  GuardedAllocator& operator=(const GuardedAllocator&) = delete;
+
+  /**
+   * Returns `size` usable bytes; throws std::bad_alloc on failure
+   */
+  void* allocate(size_t size) {
+    const uint64_t n = counter_.fetch_add(1, std::memory_order_relaxed);
+    stats_.allocations.fetch_add(1, std::memory_order_relaxed);
+    stats_.bytes_requested.fetch_add(size, std::memory_order_relaxed);
+    const bool guard = options_.sample_every != 0 && n % options_.sample_every == 0;
+    return guard ? allocateGuarded(size) : allocatePlain(size);
+  }
+
+  /**
+   * Releases memory from allocate()
+   */
+  void deallocate(void* pointer) noexcept {
+    if (pointer == nullptr) {
+      return;
+    }
+    const Header header = readHeader(pointer);
+    writeHeader(pointer, Header{nullptr, 0, 0});
+    if (header.magic == kGuardedMagic) {
+      releaseMapping(header.base, header.mapping_size);
+    } else if (header.magic == kPlainMagic) {
+      std::free(header.base);
+    } else {
+      std::abort();  // double free or foreign pointer (MEM51-CPP)
+    }
+  }
+
+  [[nodiscard]] Stats stats() const noexcept {
+    return Stats{stats_.allocations.load(std::memory_order_relaxed), stats_.guarded.load(std::memory_order_relaxed),
+                 stats_.bytes_requested.load(std::memory_order_relaxed), stats_.bytes_reserved.load(std::memory_order_relaxed)};
+  }
+
+  [[nodiscard]] size_t pageSize() const noexcept {
+    return page_size_;
+  }
+
+ private:
+  static constexpr uint32_t kGuardedMagic = 0x47554152;  // "GUAR"
+  static constexpr uint32_t kPlainMagic = 0x504C4149;    // "PLAI"
+
+  // Sits immediately before the user pointer in both modes. Accessed with
+  // memcpy because alignment 1 can leave it unaligned.
+  struct Header {
+    void* base;
+    size_t mapping_size;
+    uint32_t magic;
+  };
+
+  static Header readHeader(const void* pointer) noexcept {
+    Header header;
+    std::memcpy(&header, static_cast<const unsigned char*>(pointer) - sizeof(Header), sizeof(Header));
+    return header;
+  }
+
+  static void writeHeader(void* pointer, const Header& header) noexcept {
+    std::memcpy(static_cast<unsigned char*>(pointer) - sizeof(Header), &header, sizeof(Header));
+  }
+
+  void* allocateGuarded(size_t size) {
+    // [ header + data, right-aligned ][ guard page ]
+    const size_t usable_pages = (size + sizeof(Header) + options_.alignment + page_size_ - 1) / page_size_;
+    const size_t mapping_size = (usable_pages + 1) * page_size_;
+    void* base = takeCachedMapping(mapping_size);
+    if (base == nullptr) {
+      base = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (base == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+      if (::mprotect(static_cast<unsigned char*>(base) + usable_pages * page_size_, page_size_, PROT_NONE) != 0) {
+        ::munmap(base, mapping_size);
+        throw std::bad_alloc();
+      }
+    }
+    unsigned char* guard = static_cast<unsigned char*>(base) + usable_pages * page_size_;
+    const uintptr_t end = reinterpret_cast<uintptr_t>(guard);
+    const uintptr_t user = (end - size) & ~(static_cast<uintptr_t>(options_.alignment) - 1);
+    writeHeader(reinterpret_cast<void*>(user), Header{base, mapping_size, kGuardedMagic});
+    stats_.guarded.fetch_add(1, std::memory_order_relaxed);
+    stats_.bytes_reserved.fetch_add(mapping_size, std::memory_order_relaxed);
+    return reinterpret_cast<void*>(user);
+  }
+
+  void* allocatePlain(size_t size) {
+    const size_t total = sizeof(Header) + size + options_.alignment;
+    void* base = std::malloc(total);
+    if (base == nullptr) {
+      throw std::bad_alloc();
+    }
+    const uintptr_t first = reinterpret_cast<uintptr_t>(base) + sizeof(Header);
+    const uintptr_t mask = static_cast<uintptr_t>(options_.alignment) - 1;
+    const uintptr_t user = (first + mask) & ~mask;
+    writeHeader(reinterpret_cast<void*>(user), Header{base, total, kPlainMagic});
+    stats_.bytes_reserved.fetch_add(total, std::memory_order_relaxed);
+    return reinterpret_cast<void*>(user);
+  }
+
+  struct Mapping {
+    void* base;
+    size_t size;
+  };
+
+  void* takeCachedMapping(size_t size) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    for (size_t i = 0; i < cache_.size(); ++i) {
+      if (cache_[i].size == size) {
+        void* base = cache_[i].base;
+        cache_[i] = cache_.back();
+        cache_.pop_back();
+        return base;
+      }
+    }
+    return nullptr;
+  }
+
+  void releaseMapping(void* base, size_t size) noexcept {
+    {
+      std::lock_guard<std::mutex> lock(cache_mutex_);
+      if (cache_.size() < options_.cached_mappings) {
+        cache_.push_back(Mapping{base, size});
+        return;
+      }
+    }
+    ::munmap(base, size);
+  }
+
+  struct AtomicStats {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> guarded{0};
+    std::atomic<uint64_t> bytes_requested{0};
+    std::atomic<uint64_t> bytes_reserved{0};
+  };
+
+  Options options_;
+  size_t page_size_;
+  std::atomic<uint64_t> counter_{0};
+  AtomicStats stats_;
+  std::mutex cache_mutex_;
+  std::vector<Mapping> cache_;  // guarded by cache_mutex_
+};
+
+}  // namespace csc450
+
+#endif  // CSC450_MODULE2_PERF_GUARDED_ALLOC_H_
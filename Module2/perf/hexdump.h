@@ -0,0 +1,409 @@
+/**
+ * Table-driven / SIMD hex dump engine
+ *
+ * Replaces the per-byte `std::hex << std::setw(2) << std::setfill('0')`
+ * loop in displayMemory(). Bytes are hex-encoded 16 or 32 at a time with a
+ * nibble lookup (SSSE3/AVX2 pshufb, SSE2 arithmetic, or a 256-entry table as
+ * the portable fallback) into a caller-side output buffer, and whole lines
+ * are handed to a sink in large blocks. No stream state is touched.
+ *
+ * Default layout matches `hexdump -C`:
+ *   00000000  53 45 4e 53 49 54 49 56  45 5f 44 41 54 41 21 00  |SENSITIVE_DATA!.|
+ *
+ * The SIMD kernels are compiled with target attributes and selected once at
+ * run time, so the default -O2 build still uses AVX2 where the CPU has it.
+ */
+
+#ifndef CSC450_MODULE2_PERF_HEXDUMP_H_
+#define CSC450_MODULE2_PERF_HEXDUMP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CSC450_HEXDUMP_X86 1
+#include <immintrin.h>
+#endif
+
+namespace csc450::hexdump {
+
+struct Options {
+  size_t bytes_per_line = 16;  // 1..64; 16 and 32 take the full-width SIMD path
+  size_t group_size = 8;       // extra space every N bytes (0 = no grouping)
+  bool show_offset = true;
+  bool show_ascii = true;
+  bool uppercase = false;
+  uint64_t base_offset = 0;  // value printed for the first byte
+};
+
+inline constexpr size_t kMaxBytesPerLine = 64;
+
+namespace detail {
+
+inline constexpr char kLowerDigits[] = "0123456789abcdef";
+inline constexpr char kUpperDigits[] = "0123456789ABCDEF";
+
+// 256-entry byte -> two ASCII digits table (the portable fallback)
+struct PairTable {
+  char pairs[256][2];
+  constexpr explicit PairTable(const char* digits) : pairs{} {
+    for (int i = 0; i < 256; ++i) {
+      pairs[i][0] = digits[i >> 4];
+      pairs[i][1] = digits[i & 0xF];
+    }
+  }
+};
+
+inline constexpr PairTable kLowerPairs{kLowerDigits};
+inline constexpr PairTable kUpperPairs{kUpperDigits};
+
+inline void encodeHexScalar(const uint8_t* in, size_t n, char* out, bool upper) {
+  const PairTable& table = upper ? kUpperPairs : kLowerPairs;
+  for (size_t i = 0; i < n; ++i) {
+    std::memcpy(out + 2 * i, table.pairs[in[i]], 2);
+  }
+}
+
+inline void encodeAsciiScalar(const uint8_t* in, size_t n, char* out) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = (in[i] >= 0x20 && in[i] <= 0x7E) ? static_cast<char>(in[i]) : '.';
+  }
+}
+
+#if defined(CSC450_HEXDUMP_X86)
+
+// SSE2 is part of the x86-64 baseline: nibble + '0', plus 39 (or 7) past 9
+inline void encodeHexSse2(const uint8_t* in, size_t n, char* out, bool upper) {
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  const __m128i nine = _mm_set1_epi8(9);
+  const __m128i zero_char = _mm_set1_epi8('0');
+  const __m128i letter_gap = _mm_set1_epi8(upper ? 7 : 39);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), mask);
+    __m128i lo = _mm_and_si128(v, mask);
+    hi = _mm_add_epi8(_mm_add_epi8(hi, zero_char), _mm_and_si128(_mm_cmpgt_epi8(hi, nine), letter_gap));
+    lo = _mm_add_epi8(_mm_add_epi8(lo, zero_char), _mm_and_si128(_mm_cmpgt_epi8(lo, nine), letter_gap));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+  }
+  encodeHexScalar(in + i, n - i, out + 2 * i, upper);
+}
+
+__attribute__((target("ssse3"))) inline void encodeHexSsse3(const uint8_t* in, size_t n, char* out, bool upper) {
+  const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(upper ? kUpperDigits : kLowerDigits));
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    const __m128i hi = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+    const __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(v, mask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+  }
+  encodeHexScalar(in + i, n - i, out + 2 * i, upper);
+}
+
+__attribute__((target("avx2"))) inline void encodeHexAvx2(const uint8_t* in, size_t n, char* out, bool upper) {
+  const __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(upper ? kUpperDigits : kLowerDigits)));
+  const __m256i mask = _mm256_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+    const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, mask));
+    // unpack works per 128-bit lane; permute restores byte order
+    const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+    const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+  }
+  encodeHexSsse3(in + i, n - i, out + 2 * i, upper);
+}
+
+// Printable range 0x20..0x7E: signed compares reject 0x80..0xFF for free
+inline void encodeAsciiSse2(const uint8_t* in, size_t n, char* out) {
+  const __m128i low = _mm_set1_epi8(0x1F);
+  const __m128i high = _mm_set1_epi8(0x7F);
+  const __m128i dot = _mm_set1_epi8('.');
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(v, low), _mm_cmplt_epi8(v, high));
+    const __m128i result = _mm_or_si128(_mm_and_si128(printable, v), _mm_andnot_si128(printable, dot));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), result);
+  }
+  encodeAsciiScalar(in + i, n - i, out + i);
+}
+
+#endif  // CSC450_HEXDUMP_X86
+
+using EncodeHexFn = void (*)(const uint8_t*, size_t, char*, bool);
+
+inline EncodeHexFn selectEncodeHex() {
+#if defined(CSC450_HEXDUMP_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return encodeHexAvx2;
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    return encodeHexSsse3;
+  }
+  return encodeHexSse2;
+#else
+  return encodeHexScalar;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * Hex-encodes n bytes into 2*n characters using the best available kernel
+ */
+inline void encodeHex(const void* data, size_t n, char* out, bool uppercase = false) {
+  static const detail::EncodeHexFn encode = detail::selectEncodeHex();
+  encode(static_cast<const uint8_t*>(data), n, out, uppercase);
+}
+
+/**
+ * Copies n bytes, replacing anything outside 0x20..0x7E with '.'
+ */
+inline void encodeAscii(const void* data, size_t n, char* out) {
+#if defined(CSC450_HEXDUMP_X86)
+  detail::encodeAsciiSse2(static_cast<const uint8_t*>(data), n, out);
+#else
+  detail::encodeAsciiScalar(static_cast<const uint8_t*>(data), n, out);
+#endif
+}
+
+inline void validate(const Options& options) {
+  if (options.bytes_per_line == 0 || options.bytes_per_line > kMaxBytesPerLine) {
+    throw std::invalid_argument("hexdump: bytes_per_line must be 1..64");
+  }
+}
+
+/**
+ * Upper bound on characters in one formatted line, including '\n'
+ */
+inline size_t lineCapacity(const Options& options) {
+  const size_t groups = options.group_size == 0 ? 0 : options.bytes_per_line / options.group_size;
+  return 16 + 2                              // offset (up to 64-bit) + gap
+         + options.bytes_per_line * 3 + groups  // "xx " per byte + group gaps
+         + 3 + options.bytes_per_line           // " |" + gutter + "|"
+         + 1;                                   // newline
+}
+
+/**
+ * Formats one line of up to bytes_per_line bytes; returns characters written
+ */
+inline size_t formatLine(const uint8_t* data, size_t count, uint64_t offset, const Options& options, char* out) {
+  char* p = out;
+  if (options.show_offset) {
+    // 8 digits like hexdump -C, widening only when the offset needs it
+    const int digits = offset > 0xFFFFFFFFULL ? 16 : 8;
+    const char* table = options.uppercase ? detail::kUpperDigits : detail::kLowerDigits;
+    for (int d = digits - 1; d >= 0; --d) {
+      *p++ = table[(offset >> (4 * d)) & 0xF];
+    }
+    *p++ = ' ';
+    *p++ = ' ';
+  }
+
+  char hex[2 * kMaxBytesPerLine];
+  encodeHex(data, count, hex, options.uppercase);
+  const size_t group = options.group_size;
+  for (size_t i = 0; i < options.bytes_per_line; ++i) {
+    if (group != 0 && i != 0 && i % group == 0) {
+      *p++ = ' ';
+    }
+    if (i < count) {
+      p[0] = hex[2 * i];
+      p[1] = hex[2 * i + 1];
+    } else {
+      p[0] = ' ';
+      p[1] = ' ';
+    }
+    p[2] = ' ';
+    p += 3;
+  }
+
+  if (options.show_ascii) {
+    *p++ = ' ';
+    *p++ = '|';
+    encodeAscii(data, count, p);
+    p += count;
+    *p++ = '|';
+  } else {
+    --p;  // drop the trailing space after the last hex pair
+  }
+  *p++ = '\n';
+  return static_cast<size_t>(p - out);
+}
+
+namespace detail {
+
+/**
+ * Precomputed positions for a full line so the hot loop is plain stores:
+ * the template already holds spaces, gutter bars and the newline.
+ */
+struct LineLayout {
+  size_t hex_start = 0;
+  size_t ascii_start = 0;
+  size_t length = 0;
+  uint8_t hex_pos[kMaxBytesPerLine] = {};
+  char line_template[16 + 2 + kMaxBytesPerLine * 5 + 4] = {};  // offset, hex + groups, gutter
+
+  LineLayout(const Options& options, int offset_digits) {
+    size_t p = 0;
+    if (options.show_offset) {
+      p += static_cast<size_t>(offset_digits);
+      line_template[p++] = ' ';
+      line_template[p++] = ' ';
+    }
+    hex_start = p;
+    for (size_t i = 0; i < options.bytes_per_line; ++i) {
+      if (options.group_size != 0 && i != 0 && i % options.group_size == 0) {
+        line_template[p++] = ' ';
+      }
+      hex_pos[i] = static_cast<uint8_t>(p - hex_start);
+      p += 2;
+      line_template[p++] = ' ';
+    }
+    if (options.show_ascii) {
+      line_template[p++] = ' ';
+      line_template[p++] = '|';
+      ascii_start = p;
+      p += options.bytes_per_line;
+      line_template[p++] = '|';
+    } else {
+      --p;
+    }
+    line_template[p++] = '\n';
+    length = p;
+  }
+};
+
+/**
+ * Fixed hexdump -C line (16 bytes, groups of 8, 8-digit offset). All
+ * positions are compile-time constants so the stores fully unroll.
+ */
+inline constexpr char kCanonicalTemplate[] = "00000000  00 00 00 00 00 00 00 00  00 00 00 00 00 00 00 00  |0000000000000000|\n";
+inline constexpr size_t kCanonicalLineLength = sizeof(kCanonicalTemplate) - 1;
+
+inline void formatCanonicalLine(const char* hex, const char* ascii, uint32_t offset, const PairTable& pairs, char* out) {
+  std::memcpy(out, kCanonicalTemplate, kCanonicalLineLength);
+  std::memcpy(out + 0, pairs.pairs[(offset >> 24) & 0xFF], 2);
+  std::memcpy(out + 2, pairs.pairs[(offset >> 16) & 0xFF], 2);
+  std::memcpy(out + 4, pairs.pairs[(offset >> 8) & 0xFF], 2);
+  std::memcpy(out + 6, pairs.pairs[offset & 0xFF], 2);
+  for (int i = 0; i < 8; ++i) {
+    std::memcpy(out + 10 + 3 * i, hex + 2 * i, 2);
+    std::memcpy(out + 35 + 3 * i, hex + 16 + 2 * i, 2);
+  }
+  std::memcpy(out + 61, ascii, 16);
+}
+
+}  // namespace detail
+
+/**
+ * Dumps size bytes, passing formatted text to sink(const char*, size_t) in
+ * blocks of roughly 64 KiB. Works for arbitrarily large regions with a
+ * fixed-size buffer: input is hex/ASCII encoded a chunk at a time, then the
+ * digits are scattered into a precomputed line template.
+ */
+template <typename Sink>
+void dump(const void* data, size_t size, const Options& options, Sink&& sink) {
+  validate(options);
+  constexpr size_t kBlockSize = 64 * 1024;
+  char block[kBlockSize];
+  const size_t per_line = options.bytes_per_line;
+  const size_t line_max = lineCapacity(options);
+  const auto* bytes = static_cast<const uint8_t*>(data);
+
+  // Lines per encode chunk: keeps the scratch arrays around 2 KiB of input
+  const size_t chunk_lines = (2048 / per_line) == 0 ? 1 : 2048 / per_line;
+  char hex[2 * 2048 + 2 * kMaxBytesPerLine];
+  char ascii[2048 + kMaxBytesPerLine];
+  const char* digits = options.uppercase ? detail::kUpperDigits : detail::kLowerDigits;
+
+  size_t used = 0;
+  size_t pos = 0;
+  const size_t full_end = size - size % per_line;
+  int offset_digits = 0;
+  const detail::LineLayout* layout = nullptr;
+  detail::LineLayout narrow(options, 8);
+  detail::LineLayout wide(options, 16);
+  const bool canonical = per_line == 16 && options.group_size == 8 && options.show_offset && options.show_ascii;
+  const detail::PairTable& pairs = options.uppercase ? detail::kUpperPairs : detail::kLowerPairs;
+
+  while (pos < full_end) {
+    const size_t lines = std::min(chunk_lines, (full_end - pos) / per_line);
+    const size_t chunk_bytes = lines * per_line;
+    encodeHex(bytes + pos, chunk_bytes, hex, options.uppercase);
+    if (options.show_ascii) {
+      encodeAscii(bytes + pos, chunk_bytes, ascii);
+    }
+    for (size_t line = 0; line < lines; ++line) {
+      if (used + line_max > kBlockSize) {
+        sink(block, used);
+        used = 0;
+      }
+      const uint64_t offset = options.base_offset + pos + line * per_line;
+      const int needed = offset > 0xFFFFFFFFULL ? 16 : 8;
+      if (needed != offset_digits) {
+        offset_digits = needed;
+        layout = needed == 8 ? &narrow : &wide;
+      }
+      char* out = block + used;
+      if (canonical && offset_digits == 8) {
+        detail::formatCanonicalLine(hex + 32 * line, ascii + 16 * line, static_cast<uint32_t>(offset), pairs, out);
+        used += detail::kCanonicalLineLength;
+        continue;
+      }
+      std::memcpy(out, layout->line_template, layout->length);
+      if (options.show_offset) {
+        for (int d = 0; d < offset_digits; ++d) {
+          out[offset_digits - 1 - d] = digits[(offset >> (4 * d)) & 0xF];
+        }
+      }
+      const char* line_hex = hex + 2 * line * per_line;
+      char* hex_out = out + layout->hex_start;
+      for (size_t i = 0; i < per_line; ++i) {
+        std::memcpy(hex_out + layout->hex_pos[i], line_hex + 2 * i, 2);
+      }
+      if (options.show_ascii) {
+        std::memcpy(out + layout->ascii_start, ascii + line * per_line, per_line);
+      }
+      used += layout->length;
+    }
+    pos += chunk_bytes;
+  }
+
+  // Trailing partial line uses the general formatter
+  if (pos < size) {
+    if (used + line_max > kBlockSize) {
+      sink(block, used);
+      used = 0;
+    }
+    used += formatLine(bytes + pos, size - pos, options.base_offset + pos, options, block + used);
+  }
+  if (used != 0) {
+    sink(block, used);
+  }
+}
+
+/**
+ * Convenience overload for std::ostream (one write() per block)
+ */
+inline void dump(const void* data, size_t size, const Options& options, std::ostream& out) {
+  dump(data, size, options, [&out](const char* text, size_t length) { out.write(text, static_cast<std::streamsize>(length)); });
+}
+
+}  // namespace csc450::hexdump
+
+#endif  // CSC450_MODULE2_PERF_HEXDUMP_H_
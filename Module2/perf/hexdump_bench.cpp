@@ -0,0 +1,167 @@
+/**
+ * Hex dump throughput benchmark
+ *
+ * Compares the original displayMemory() approach (per-byte iostream
+ * manipulators) with the hexdump engine, both for the raw hex-encoding
+ * kernels and for complete `hexdump -C` style output. Output goes to a
+ * discarding sink so only formatting cost is measured.
+ *
+ * Usage: hexdump_bench [--size BYTES] [--min-time SECONDS]
+ */
+
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "hexdump.h"
+
+namespace {
+
+// Discards everything but still goes through the streambuf interface
+class NullBuffer : public std::streambuf {
+ protected:
+  int_type overflow(int_type ch) override {
+    return traits_type::not_eof(ch);
+  }
+  std::streamsize xsputn(const char*, std::streamsize count) override {
+    return count;
+  }
+};
+
+// The loop from Module2/reference/buffer_overflow_demo.cpp, with the cast
+// fixed to unsigned so it really prints hex digits
+void iostreamHexDump(std::ostream& out, const uint8_t* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    out << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned>(data[i]) << " ";
+    if ((i + 1) % 8 == 0) {
+      out << " ";
+    }
+    if ((i + 1) % 16 == 0) {
+      out << '\n';
+    }
+  }
+  out << std::dec;
+}
+
+using EncodeFn = void (*)(const uint8_t*, size_t, char*, bool);
+
+struct Kernel {
+  const char* name;
+  EncodeFn fn;
+  bool supported;
+};
+
+std::vector<Kernel> kernels() {
+  namespace d = csc450::hexdump::detail;
+  std::vector<Kernel> list = {{"table_scalar", d::encodeHexScalar, true}};
+#if defined(CSC450_HEXDUMP_X86)
+  __builtin_cpu_init();
+  list.push_back({"sse2", d::encodeHexSse2, true});
+  list.push_back({"ssse3_pshufb", d::encodeHexSsse3, __builtin_cpu_supports("ssse3") != 0});
+  list.push_back({"avx2_pshufb", d::encodeHexAvx2, __builtin_cpu_supports("avx2") != 0});
+#endif
+  return list;
+}
+
+double gbPerSecond(size_t bytes, double ns) {
+  return ns > 0 ? static_cast<double>(bytes) / ns : 0.0;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    size_t size = 1 << 20;
+    double min_time = 0.05;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--size" && i + 1 < argc) {
+        size = std::strtoull(argv[++i], nullptr, 10);
+      } else if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--size BYTES] [--min-time SECONDS]\n";
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::vector<uint8_t> data(size);
+    uint32_t state = 12345;
+    for (auto& byte : data) {
+      state = state * 1103515245u + 12345u;
+      byte = static_cast<uint8_t>(state >> 16);
+    }
+
+    // Every kernel must agree with the table before it is timed
+    const auto available = kernels();
+    std::vector<char> reference(2 * size);
+    std::vector<char> encoded(2 * size);
+    csc450::hexdump::detail::encodeHexScalar(data.data(), size, reference.data(), false);
+    for (const auto& kernel : available) {
+      if (!kernel.supported) {
+        continue;
+      }
+      kernel.fn(data.data(), size, encoded.data(), false);
+      if (encoded != reference) {
+        throw std::runtime_error(std::string("kernel mismatch: ") + kernel.name);
+      }
+    }
+
+    NullBuffer null_buffer;
+    std::ostream null_stream(&null_buffer);
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "hexdump");
+    json.field("region_bytes", size);
+
+    json.key("encode_kernels").beginArray();
+    for (const auto& kernel : available) {
+      json.beginObject();
+      json.field("kernel", kernel.name);
+      if (kernel.supported) {
+        const double ns = csc450::bench::nsPerOp([&] {
+          kernel.fn(data.data(), size, encoded.data(), false);
+          csc450::bench::clobberMemory();
+        }, min_time);
+        json.field("gb_per_s", gbPerSecond(size, ns));
+      } else {
+        json.key("gb_per_s").null();
+      }
+      json.endObject();
+    }
+    json.endArray();
+
+    const double iostream_ns = csc450::bench::nsPerOp([&] { iostreamHexDump(null_stream, data.data(), size); }, min_time, 1);
+    size_t output_bytes = 0;
+    const csc450::hexdump::Options options;
+    const double engine_ns = csc450::bench::nsPerOp([&] {
+      output_bytes = 0;
+      csc450::hexdump::dump(data.data(), size, options, [&](const char* text, size_t length) {
+        csc450::bench::doNotOptimize(text);
+        output_bytes += length;
+      });
+    }, min_time);
+    const double engine_stream_ns = csc450::bench::nsPerOp([&] { csc450::hexdump::dump(data.data(), size, options, null_stream); }, min_time);
+
+    json.key("full_dump").beginArray();
+    json.beginObject().field("path", "iostream_per_byte").field("gb_per_s", gbPerSecond(size, iostream_ns)).endObject();
+    json.beginObject().field("path", "engine_block_sink").field("gb_per_s", gbPerSecond(size, engine_ns)).endObject();
+    json.beginObject().field("path", "engine_ostream").field("gb_per_s", gbPerSecond(size, engine_stream_ns)).endObject();
+    json.endArray();
+    json.field("engine_output_bytes", output_bytes);
+    json.field("speedup_vs_iostream", engine_ns > 0 ? iostream_ns / engine_ns : 0.0);
+    json.endObject();
+    std::cout << '\n';
+    return EXIT_SUCCESS;
+
+  } catch (const std::exception& e) {
+    std::cerr << "hexdump_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,208 @@
+/**
+ * Bulk integrity verification benchmark
+ *
+ * Registers thousands of heap buffers with an IntegrityRegistry and times
+ * full verification passes, reported as ns per KB verified, for:
+ *   exact          byte-for-byte snapshot compare
+ *   crc32c         checksum regions (hardware crc32 when available)
+ *   crc32c_table   the table-driven CRC over the same bytes, for reference
+ *
+ * Detection is checked too: a few buffers are corrupted and both an
+ * explicit checkpoint and the background pass must report exactly those.
+ * Last, vulnerableFunction()'s protect / verify / unprotect cycle is run
+ * --churn times with varying canary sizes next to a long-lived region; the
+ * registry's footprint must not grow after the first thousand rounds, and
+ * a canary corrupted in the final round must still be reported.
+ *
+ * Usage: integrity_bench [--buffers N] [--min-time SECONDS] [--churn ROUNDS]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "integrity_registry.h"
+
+namespace {
+
+struct Buffers {
+  std::vector<std::unique_ptr<uint8_t[]>> storage;
+  std::vector<size_t> sizes;
+  size_t total_bytes = 0;
+};
+
+// Sizes spread from 16 B (canary-sized) to 16 KiB
+Buffers makeBuffers(size_t count) {
+  Buffers buffers;
+  uint32_t state = 0xC0FFEEu;
+  for (size_t i = 0; i < count; ++i) {
+    state = state * 1664525u + 1013904223u;
+    const size_t size = size_t{16} << ((state >> 24) % 11);
+    auto buffer = std::make_unique<uint8_t[]>(size);
+    for (size_t b = 0; b < size; ++b) {
+      buffer[b] = static_cast<uint8_t>(b * 31 + i);
+    }
+    buffers.total_bytes += size;
+    buffers.sizes.push_back(size);
+    buffers.storage.push_back(std::move(buffer));
+  }
+  return buffers;
+}
+
+double nsPerKb(double ns_per_pass, size_t bytes) {
+  return ns_per_pass / (static_cast<double>(bytes) / 1024.0);
+}
+
+constexpr size_t kChurnWarmup = 1000;
+
+struct Churn {
+  size_t warm_bytes = 0;   // footprint after kChurnWarmup rounds
+  size_t final_bytes = 0;  // footprint after the last round
+  bool detects = false;
+};
+
+Churn churnRegistry(size_t rounds) {
+  Churn churn;
+  csc450::IntegrityRegistry registry;
+  uint8_t canary[256] = {};
+  uint8_t data[1024] = {};
+  uint8_t sentinel[48] = {};
+  registry.protectExact(sentinel, sizeof(sentinel));
+  for (size_t r = 0; r < rounds; ++r) {
+    const size_t canary_size = size_t{8} << (r % 6);  // 8 to 256 bytes
+    const auto canary_id = registry.protectExact(canary, canary_size);
+    const auto data_id = registry.protectChecksum(data, sizeof(data));
+    if (r + 1 == rounds) {
+      canary[canary_size - 1] ^= 0x5A;
+      const auto report = registry.verifyAll();
+      churn.detects = report.violations.size() == 1 && report.violations[0].id == canary_id;
+      canary[canary_size - 1] ^= 0x5A;
+    } else {
+      csc450::bench::doNotOptimize(registry.verifyAll().regions_checked);
+    }
+    registry.unprotect(canary_id);
+    registry.unprotect(data_id);
+    if (r + 1 == kChurnWarmup) {
+      churn.warm_bytes = registry.footprintBytes();
+    }
+  }
+  churn.final_bytes = registry.footprintBytes();
+  churn.detects = churn.detects && registry.size() == 1 && registry.verifyAll().clean();
+  return churn;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    size_t count = 5000;
+    double min_time = 0.1;
+    size_t churn_rounds = 100000;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--buffers" && i + 1 < argc) {
+        count = std::strtoull(argv[++i], nullptr, 10);
+      } else if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else if (arg == "--churn" && i + 1 < argc) {
+        churn_rounds = std::max<size_t>(kChurnWarmup, std::strtoull(argv[++i], nullptr, 10));
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--buffers N] [--min-time SECONDS] [--churn ROUNDS]\n";
+        return EXIT_FAILURE;
+      }
+    }
+
+    Buffers buffers = makeBuffers(count);
+    csc450::IntegrityRegistry exact;
+    csc450::IntegrityRegistry checksum;
+    for (size_t i = 0; i < count; ++i) {
+      exact.protectExact(buffers.storage[i].get(), buffers.sizes[i]);
+      checksum.protectChecksum(buffers.storage[i].get(), buffers.sizes[i]);
+    }
+
+    const double exact_ns = csc450::bench::nsPerOp([&] { csc450::bench::doNotOptimize(exact.verifyAll().regions_checked); }, min_time);
+    const double crc_ns = csc450::bench::nsPerOp([&] { csc450::bench::doNotOptimize(checksum.verifyAll().regions_checked); }, min_time);
+    const double table_ns = csc450::bench::nsPerOp([&] {
+      uint32_t combined = 0;
+      for (size_t i = 0; i < count; ++i) {
+        combined ^= csc450::crc32c::detail::updateSoftware(~0u, buffers.storage[i].get(), buffers.sizes[i]);
+      }
+      csc450::bench::doNotOptimize(combined);
+    }, min_time);
+
+    // Detection: flip one byte in three buffers
+    const std::vector<size_t> victims = {0, count / 2, count - 1};
+    for (const size_t victim : victims) {
+      buffers.storage[victim][buffers.sizes[victim] - 1] ^= 0x5A;
+    }
+    const auto sameIds = [&](const csc450::IntegrityRegistry::Report& report) {
+      if (report.violations.size() != victims.size()) {
+        return false;
+      }
+      for (size_t v = 0; v < victims.size(); ++v) {
+        if (report.violations[v].id != victims[v]) {
+          return false;
+        }
+      }
+      return true;
+    };
+    const bool exact_detects = sameIds(exact.verifyAll());
+    const bool crc_detects = sameIds(checksum.verifyAll());
+
+    std::atomic<bool> background_detected{false};
+    checksum.startBackground(std::chrono::milliseconds(5), [&](const csc450::IntegrityRegistry::Report& report) {
+      if (sameIds(report)) {
+        background_detected = true;
+      }
+    });
+    for (int wait = 0; wait < 200 && !background_detected; ++wait) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    checksum.stopBackground();
+    const Churn churn = churnRegistry(churn_rounds);
+    const bool churn_flat = churn.final_bytes == churn.warm_bytes;
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "integrity_registry");
+    json.field("buffers", count);
+    json.field("bytes_per_pass", buffers.total_bytes);
+    json.field("crc32c_hardware", csc450::crc32c::hardwareAvailable());
+    json.key("results").beginArray();
+    json.beginObject().field("mode", "exact").field("ns_per_pass", exact_ns).field("ns_per_kb", nsPerKb(exact_ns, buffers.total_bytes)).endObject();
+    json.beginObject().field("mode", "crc32c").field("ns_per_pass", crc_ns).field("ns_per_kb", nsPerKb(crc_ns, buffers.total_bytes)).endObject();
+    json.beginObject()
+        .field("mode", "crc32c_table")
+        .field("ns_per_pass", table_ns)
+        .field("ns_per_kb", nsPerKb(table_ns, buffers.total_bytes))
+        .endObject();
+    json.endArray();
+    json.key("detection").beginObject();
+    json.field("exact_checkpoint", exact_detects);
+    json.field("crc32c_checkpoint", crc_detects);
+    json.field("background_pass", background_detected.load());
+    json.endObject();
+    json.key("churn").beginObject();
+    json.field("rounds", churn_rounds);
+    json.field("footprint_after_warmup", churn.warm_bytes);
+    json.field("footprint_final", churn.final_bytes);
+    json.field("flat", churn_flat);
+    json.field("detects", churn.detects);
+    json.endObject();
+    json.endObject();
+    std::cout << '\n';
+    return exact_detects && crc_detects && background_detected && churn_flat && churn.detects ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "integrity_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,399 @@
+/**
+ * Bulk integrity verification for many protected buffers
+ *
+ * vulnerableFunction() checks two buffers with strcmp after reading input.
+ * IntegrityRegistry generalises that: any number of regions are registered
+ * once and verified together, either at explicit checkpoints or by a
+ * periodic background pass.
+ *
+ * Two protection kinds:
+ * - Exact:    small regions (canaries, sentinels) are snapshotted and
+ *             compared byte for byte; any change is reported
+ * - Checksum: larger regions store only a CRC32C (SSE4.2 crc32 instruction
+ *             when the CPU has it, table-driven otherwise) and are rehashed
+ *
+ * Regions are kept as parallel arrays so a verification pass is a linear
+ * sweep. Registered memory must outlive its registration, and legitimate
+ * writes to a Checksum region must be followed by reseal(). Unprotected ids
+ * go on a free list and are reused together with their snapshot bytes, and
+ * the snapshot store is compacted once most of it is dead, so a caller
+ * that protects and unprotects on every call (vulnerableFunction() does)
+ * keeps the registry at a constant size.
+ */
+
+#ifndef CSC450_MODULE2_PERF_INTEGRITY_REGISTRY_H_
+#define CSC450_MODULE2_PERF_INTEGRITY_REGISTRY_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CSC450_INTEGRITY_X86 1
+#include <immintrin.h>
+#endif
+
+namespace csc450 {
+
+namespace crc32c {
+
+namespace detail {
+
+// Castagnoli polynomial, reflected
+inline constexpr uint32_t kPolynomial = 0x82F63B78u;
+
+struct Table {
+  uint32_t entries[256];
+  constexpr Table() : entries{} {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc >> 1) ^ ((crc & 1u) ? kPolynomial : 0u);
+      }
+      entries[i] = crc;
+    }
+  }
+};
+
+inline constexpr Table kTable{};
+
+inline uint32_t updateSoftware(uint32_t crc, const uint8_t* data, size_t size) noexcept {
+  for (size_t i = 0; i < size; ++i) {
+    crc = kTable.entries[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#if defined(CSC450_INTEGRITY_X86) && defined(__x86_64__)
+__attribute__((target("sse4.2"))) inline uint32_t updateHardware(uint32_t crc, const uint8_t* data, size_t size) noexcept {
+  uint64_t crc64 = crc;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+  uint32_t crc32 = static_cast<uint32_t>(crc64);
+  for (; i < size; ++i) {
+    crc32 = _mm_crc32_u8(crc32, data[i]);
+  }
+  return crc32;
+}
+#endif
+
+using UpdateFn = uint32_t (*)(uint32_t, const uint8_t*, size_t) noexcept;
+
+inline UpdateFn selectUpdate() {
+#if defined(CSC450_INTEGRITY_X86) && defined(__x86_64__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse4.2")) {
+    return updateHardware;
+  }
+#endif
+  return updateSoftware;
+}
+
+}  // namespace detail
+
+inline bool hardwareAvailable() {
+  return detail::selectUpdate() != detail::updateSoftware;
+}
+
+/**
+ * CRC32C of a buffer (initial value and final xor of ~0, as in iSCSI/ext4)
+ */
+inline uint32_t compute(const void* data, size_t size) noexcept {
+  static const detail::UpdateFn update = detail::selectUpdate();
+  return ~update(~0u, static_cast<const uint8_t*>(data), size);
+}
+
+}  // namespace crc32c
+
+class IntegrityRegistry {
+ public:
+  using Id = uint32_t;
+
+  enum class Kind : uint8_t { kExact, kChecksum };
+
+  struct Violation {
+    Id id;
+    const void* address;
+    size_t size;
+    Kind kind;
+  };
+
+  struct Report {
+    size_t regions_checked = 0;
+    size_t bytes_checked = 0;
+    double seconds = 0;
+    std::vector<Violation> violations;
+
+    [[nodiscard]] bool clean() const noexcept {
+      return violations.empty();
+    }
+    [[nodiscard]] double nsPerKilobyte() const noexcept {
+      return bytes_checked == 0 ? 0.0 : seconds * 1e9 / (static_cast<double>(bytes_checked) / 1024.0);
+    }
+  };
+
+  using ViolationHandler = std::function<void(const Report&)>;
+
+  IntegrityRegistry() = default;
+  ~IntegrityRegistry() {
+    stopBackground();
+  }
+
+  IntegrityRegistry(const IntegrityRegistry&) = delete;
+  IntegrityRegistry& operator=(const IntegrityRegistry&) = delete;
+
+  /**
+   * Protects a small region by snapshotting its current bytes
+   */
+  Id protectExact(const void* address, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Id id = acquireLocked(size);
+    if (capacities_[id] < size) {
+      // The slot's old range (if any) is too small; take fresh bytes
+      capacities_[id] = 0;
+      compactIfSparseLocked(size);
+      expected_[id] = snapshots_.size();
+      snapshots_.resize(snapshots_.size() + size);
+      capacities_[id] = size;
+    }
+    std::memcpy(snapshots_.data() + expected_[id], address, size);
+    activateLocked(id, address, size, Kind::kExact, expected_[id]);
+    return id;
+  }
+
+  /**
+   * Protects a region by its CRC32C
+   */
+  Id protectChecksum(const void* address, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Id id = acquireLocked(0);
+    capacities_[id] = 0;  // expected_ holds the CRC now, so an old snapshot range is dead until compaction
+    activateLocked(id, address, size, Kind::kChecksum, crc32c::compute(address, size));
+    return id;
+  }
+
+  /**
+   * Accepts the current contents of a region as the new reference
+   */
+  void reseal(Id id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    checkId(id);
+    if (kinds_[id] == Kind::kChecksum) {
+      expected_[id] = crc32c::compute(addresses_[id], sizes_[id]);
+    } else {
+      std::memcpy(snapshots_.data() + expected_[id], addresses_[id], sizes_[id]);
+    }
+  }
+
+  /**
+   * Stops checking a region (its memory may then be released); the id may
+   * be handed out again by a later protect call
+   */
+  void unprotect(Id id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    checkId(id);
+    active_[id] = 0;
+    if (kinds_[id] == Kind::kExact) {
+      snapshot_bytes_ -= capacities_[id];
+    }
+    free_ids_.push_back(id);
+  }
+
+  /**
+   * Explicit checkpoint: verifies every active region now
+   */
+  Report verifyAll() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Report report;
+    const auto start = std::chrono::steady_clock::now();
+    const size_t count = addresses_.size();
+    for (size_t i = 0; i < count; ++i) {
+      if (active_[i] == 0) {
+        continue;
+      }
+      bool intact;
+      if (kinds_[i] == Kind::kExact) {
+        intact = std::memcmp(addresses_[i], snapshots_.data() + expected_[i], sizes_[i]) == 0;
+      } else {
+        intact = crc32c::compute(addresses_[i], sizes_[i]) == static_cast<uint32_t>(expected_[i]);
+      }
+      ++report.regions_checked;
+      report.bytes_checked += sizes_[i];
+      if (!intact) {
+        report.violations.push_back(Violation{static_cast<Id>(i), addresses_[i], sizes_[i], kinds_[i]});
+      }
+    }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+  }
+
+  /**
+   * Runs verifyAll() every `interval` on a background thread; the handler
+   * is called (on that thread) for passes that find violations
+   */
+  void startBackground(std::chrono::milliseconds interval, ViolationHandler handler) {
+    stopBackground();
+    {
+      std::lock_guard<std::mutex> lock(background_mutex_);
+      stop_requested_ = false;
+    }
+    background_ = std::thread([this, interval, handler = std::move(handler)] {
+      std::unique_lock<std::mutex> lock(background_mutex_);
+      // Predicate wait handles spurious wakeups (CON54-CPP)
+      while (!background_cv_.wait_for(lock, interval, [this] { return stop_requested_; })) {
+        lock.unlock();
+        const Report report = verifyAll();
+        passes_.fetch_add(1, std::memory_order_relaxed);
+        if (!report.clean() && handler) {
+          handler(report);
+        }
+        lock.lock();
+      }
+    });
+  }
+
+  void stopBackground() {
+    {
+      std::lock_guard<std::mutex> lock(background_mutex_);
+      stop_requested_ = true;
+    }
+    background_cv_.notify_all();
+    if (background_.joinable()) {
+      background_.join();
+    }
+  }
+
+  [[nodiscard]] uint64_t backgroundPasses() const noexcept {
+    return passes_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Regions currently protected
+   */
+  [[nodiscard]] size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return addresses_.size() - free_ids_.size();
+  }
+
+  /**
+   * Heap bytes held for bookkeeping and snapshots
+   */
+  [[nodiscard]] size_t footprintBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return addresses_.capacity() * sizeof(const void*) + sizes_.capacity() * sizeof(size_t) + kinds_.capacity() * sizeof(Kind) +
+           expected_.capacity() * sizeof(uint64_t) + capacities_.capacity() * sizeof(size_t) + active_.capacity() + free_ids_.capacity() * sizeof(Id) +
+           snapshots_.capacity();
+  }
+
+ private:
+  // Dead snapshot bytes tolerated before a compaction
+  static constexpr size_t kCompactSlack = 4096;
+
+  // Free slots looked at for one whose snapshot range fits
+  static constexpr size_t kFreeScan = 8;
+
+  // A free slot, or a new inactive one. Among the most recently freed,
+  // prefers one whose snapshot range holds `snapshot` bytes (a checksum
+  // region passes 0 and prefers a slot without one)
+  Id acquireLocked(size_t snapshot) {
+    if (!free_ids_.empty()) {
+      const size_t scan = free_ids_.size() < kFreeScan ? free_ids_.size() : kFreeScan;
+      for (size_t i = free_ids_.size() - 1; i >= free_ids_.size() - scan; --i) {
+        const size_t capacity = capacities_[free_ids_[i]];
+        if (snapshot == 0 ? capacity == 0 : capacity >= snapshot) {
+          std::swap(free_ids_[i], free_ids_.back());
+          break;
+        }
+        if (i == 0) {
+          break;
+        }
+      }
+      const Id id = free_ids_.back();
+      free_ids_.pop_back();
+      return id;
+    }
+    if (addresses_.size() >= UINT32_MAX) {
+      throw std::length_error("IntegrityRegistry: too many regions");
+    }
+    addresses_.push_back(nullptr);
+    sizes_.push_back(0);
+    kinds_.push_back(Kind::kChecksum);
+    expected_.push_back(0);
+    capacities_.push_back(0);
+    active_.push_back(0);
+    return static_cast<Id>(addresses_.size() - 1);
+  }
+
+  void activateLocked(Id id, const void* address, size_t size, Kind kind, uint64_t expected) noexcept {
+    addresses_[id] = address;
+    sizes_[id] = size;
+    kinds_[id] = kind;
+    expected_[id] = expected;
+    active_[id] = 1;
+    if (kind == Kind::kExact) {
+      snapshot_bytes_ += capacities_[id];
+    }
+  }
+
+  // Before `incoming` more snapshot bytes are appended: if live snapshots
+  // fill less than half the store, repack them and drop free slots' ranges
+  void compactIfSparseLocked(size_t incoming) {
+    if (snapshots_.size() + incoming <= 2 * (snapshot_bytes_ + incoming) + kCompactSlack) {
+      return;
+    }
+    std::vector<uint8_t> packed;
+    packed.reserve(snapshot_bytes_ + incoming);
+    for (size_t i = 0; i < addresses_.size(); ++i) {
+      if (active_[i] == 0 || kinds_[i] != Kind::kExact) {
+        capacities_[i] = 0;
+        continue;
+      }
+      const size_t offset = packed.size();
+      packed.insert(packed.end(), snapshots_.begin() + static_cast<std::ptrdiff_t>(expected_[i]),
+                    snapshots_.begin() + static_cast<std::ptrdiff_t>(expected_[i] + capacities_[i]));
+      expected_[i] = offset;
+    }
+    snapshots_.swap(packed);
+  }
+
+  void checkId(Id id) const {
+    if (id >= addresses_.size() || active_[id] == 0) {
+      throw std::out_of_range("IntegrityRegistry: unknown or unprotected region id");
+    }
+  }
+
+  // Parallel arrays, indexed by Id (guarded by mutex_)
+  mutable std::mutex mutex_;
+  std::vector<const void*> addresses_;
+  std::vector<size_t> sizes_;
+  std::vector<Kind> kinds_;
+  std::vector<uint64_t> expected_;    // CRC32C, or offset into snapshots_
+  std::vector<size_t> capacities_;   // snapshot bytes owned by the slot, kept while it is free
+  std::vector<uint8_t> active_;
+  std::vector<Id> free_ids_;
+  std::vector<uint8_t> snapshots_;
+  size_t snapshot_bytes_ = 0;  // capacities_ of active exact slots
+
+  std::thread background_;
+  std::mutex background_mutex_;
+  std::condition_variable background_cv_;
+  bool stop_requested_ = false;  // guarded by background_mutex_
+  std::atomic<uint64_t> passes_{0};
+};
+
+}  // namespace csc450
+
+#endif  // CSC450_MODULE2_PERF_INTEGRITY_REGISTRY_H_
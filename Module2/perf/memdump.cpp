@@ -0,0 +1,391 @@
+/**
+ * memdump - streaming xxd / hexdump -C style dump for large files
+ *
+ * Standalone dump mode built on the displayMemory() hex dump engine.
+ * The input is memory-mapped, split into line-aligned chunks that worker
+ * threads format in parallel, and the chunks are written to stdout in file
+ * order. Runs of identical lines collapse to a single '*' exactly like
+ * `hexdump -C` (disable with -v). Files that cannot be mapped (pipes,
+ * /proc entries) fall back to buffered reads on a single thread.
+ *
+ * Usage:
+ *   memdump [-s OFFSET] [-n LENGTH] [-c COLS] [-g GROUP] [-j THREADS] [-v] FILE
+ *   memdump --bench FILE     compare throughput with xxd and hexdump -C
+ *
+ * CERT notes:
+ * - FIO42-C: the mapping and descriptor are released by RAII wrappers
+ * - ERR50-CPP: errors surface as exceptions and a non-zero exit status
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "hexdump.h"
+#include "posix_io.h"
+
+namespace {
+
+struct DumpConfig {
+  std::string path;
+  uint64_t offset = 0;
+  uint64_t length = UINT64_MAX;
+  size_t threads = 0;  // 0 = hardware concurrency
+  bool squeeze = true;
+  bool bench = false;
+  csc450::hexdump::Options format;
+};
+
+/**
+ * Read-only file mapping (RAII)
+ */
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path) {
+    fd_.reset(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd_.get() < 0) {
+      throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+    struct stat info{};
+    if (::fstat(fd_.get(), &info) != 0) {
+      throw std::system_error(errno, std::generic_category(), "fstat " + path);
+    }
+    if (S_ISREG(info.st_mode) && info.st_size > 0) {
+      size_ = static_cast<size_t>(info.st_size);
+      void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_.get(), 0);
+      if (mapping != MAP_FAILED) {
+        data_ = static_cast<const uint8_t*>(mapping);
+        ::madvise(mapping, size_, MADV_SEQUENTIAL);
+      }
+    }
+  }
+
+  ~MappedFile() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<uint8_t*>(data_), size_);
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  [[nodiscard]] bool mapped() const noexcept {
+    return data_ != nullptr;
+  }
+  [[nodiscard]] const uint8_t* data() const noexcept {
+    return data_;
+  }
+  [[nodiscard]] size_t size() const noexcept {
+    return size_;
+  }
+  [[nodiscard]] int fd() const noexcept {
+    return fd_.get();
+  }
+
+ private:
+  csc450::io::Fd fd_;  // a member, so it is closed even if the constructor throws
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/**
+ * Formats lines [first_line, last_line) of the range starting at `range`.
+ * Squeezing only needs the line before the chunk, which the mapping holds,
+ * so chunks are independent and can be formatted in any order.
+ */
+std::string formatChunk(const uint8_t* range, size_t range_size, size_t first_line, size_t last_line, const DumpConfig& config) {
+  const size_t cols = config.format.bytes_per_line;
+  std::string out;
+  out.reserve((last_line - first_line) * csc450::hexdump::lineCapacity(config.format));
+  const auto sink = [&out](const char* text, size_t length) { out.append(text, length); };
+
+  const auto sameAsPrevious = [&](size_t line) {
+    if (line == 0 || (line + 1) * cols > range_size) {
+      return false;  // first line and the partial tail are always printed
+    }
+    return std::memcmp(range + line * cols, range + (line - 1) * cols, cols) == 0;
+  };
+
+  size_t line = first_line;
+  while (line < last_line) {
+    // Run of printed lines
+    size_t run_end = line;
+    while (run_end < last_line && !(config.squeeze && sameAsPrevious(run_end))) {
+      ++run_end;
+    }
+    if (run_end > line) {
+      csc450::hexdump::Options options = config.format;
+      options.base_offset = config.offset + line * cols;
+      const size_t bytes = std::min(range_size, run_end * cols) - line * cols;
+      csc450::hexdump::dump(range + line * cols, bytes, options, sink);
+      line = run_end;
+    }
+    // Run of suppressed lines: '*' only where the run starts
+    if (line < last_line && config.squeeze && sameAsPrevious(line)) {
+      if (!sameAsPrevious(line - 1)) {
+        out += "*\n";
+      }
+      while (line < last_line && sameAsPrevious(line)) {
+        ++line;
+      }
+    }
+  }
+  return out;
+}
+
+void writeTrailer(const DumpConfig& config, uint64_t end_offset) {
+  // hexdump -C closes with the offset one past the last byte
+  if (config.format.show_offset) {
+    char trailer[24];
+    const int length = std::snprintf(trailer, sizeof(trailer), "%08llx\n", static_cast<unsigned long long>(end_offset));
+    csc450::io::writeAllOrThrow(STDOUT_FILENO, trailer, static_cast<size_t>(length));
+  }
+}
+
+void dumpMapped(const MappedFile& file, const DumpConfig& config) {
+  if (config.offset >= file.size()) {
+    writeTrailer(config, config.offset);
+    return;
+  }
+  const uint8_t* range = file.data() + config.offset;
+  const size_t range_size = static_cast<size_t>(std::min<uint64_t>(config.length, file.size() - config.offset));
+  const size_t cols = config.format.bytes_per_line;
+  const size_t total_lines = (range_size + cols - 1) / cols;
+
+  // ~4 MiB of input per chunk keeps output buffers around 20 MiB each
+  const size_t lines_per_chunk = std::max<size_t>(1, (4u << 20) / cols);
+  const size_t chunk_count = (total_lines + lines_per_chunk - 1) / lines_per_chunk;
+  const size_t threads = std::max<size_t>(1, config.threads != 0 ? config.threads : std::thread::hardware_concurrency());
+
+  // Keep at most `threads` chunks in flight and write them in order
+  std::vector<std::future<std::string>> pending;
+  size_t next_chunk = 0;
+  size_t next_write = 0;
+  while (next_write < chunk_count) {
+    while (next_chunk < chunk_count && pending.size() - next_write < threads) {
+      const size_t first = next_chunk * lines_per_chunk;
+      const size_t last = std::min(total_lines, first + lines_per_chunk);
+      pending.push_back(std::async(threads == 1 ? std::launch::deferred : std::launch::async,
+                                   [=, &config] { return formatChunk(range, range_size, first, last, config); }));
+      ++next_chunk;
+    }
+    const std::string text = pending[next_write].get();
+    csc450::io::writeAllOrThrow(STDOUT_FILENO, text.data(), text.size());
+    ++next_write;
+  }
+  writeTrailer(config, config.offset + range_size);
+}
+
+/**
+ * Fallback for descriptors that cannot be mapped: sequential reads, one
+ * line of look-behind for squeezing.
+ */
+void dumpStreamed(const MappedFile& file, const DumpConfig& config) {
+  const size_t cols = config.format.bytes_per_line;
+  std::vector<uint8_t> buffer(cols * 65536 + cols);
+  uint64_t position = 0;
+  uint64_t remaining = config.length;
+
+  // Skip to the requested offset (lseek may fail on pipes, so read through)
+  if (::lseek(file.fd(), static_cast<off_t>(config.offset), SEEK_SET) >= 0) {
+    position = config.offset;
+  }
+  while (position < config.offset) {
+    const ssize_t got = ::read(file.fd(), buffer.data(), static_cast<size_t>(std::min<uint64_t>(buffer.size(), config.offset - position)));
+    if (got <= 0) {
+      writeTrailer(config, position);
+      return;
+    }
+    position += static_cast<uint64_t>(got);
+  }
+
+  // buffer[0, cols) holds the previous line once one has been seen
+  bool have_previous = false;
+  bool in_squeeze = false;
+  size_t filled = 0;
+  uint8_t* const data = buffer.data() + cols;
+  const size_t capacity = buffer.size() - cols;
+  for (;;) {
+    const ssize_t got = ::read(file.fd(), data + filled, static_cast<size_t>(std::min<uint64_t>(capacity - filled, remaining)));
+    if (got < 0 && errno == EINTR) {
+      continue;
+    }
+    if (got < 0) {
+      throw std::system_error(errno, std::generic_category(), "read");
+    }
+    filled += static_cast<size_t>(got);
+    remaining -= static_cast<uint64_t>(got);
+    const bool done = got == 0 || remaining == 0;
+    const size_t usable = done ? filled : filled - filled % cols;
+
+    std::string out;
+    for (size_t pos = 0; pos < usable; pos += cols) {
+      const size_t count = std::min(cols, usable - pos);
+      const uint8_t* previous = pos == 0 ? buffer.data() : data + pos - cols;
+      if (config.squeeze && have_previous && count == cols && std::memcmp(data + pos, previous, cols) == 0) {
+        if (!in_squeeze) {
+          out += "*\n";
+          in_squeeze = true;
+        }
+      } else {
+        in_squeeze = false;
+        csc450::hexdump::Options options = config.format;
+        options.base_offset = position + pos;
+        csc450::hexdump::dump(data + pos, count, options, [&out](const char* text, size_t length) { out.append(text, length); });
+      }
+      have_previous = true;
+    }
+    csc450::io::writeAllOrThrow(STDOUT_FILENO, out.data(), out.size());
+    if (usable >= cols) {
+      std::memcpy(buffer.data(), data + usable - cols, cols);
+    }
+    position += usable;
+    std::memmove(data, data + usable, filled - usable);
+    filled -= usable;
+    if (done) {
+      break;
+    }
+  }
+  writeTrailer(config, position);
+}
+
+double timeCommand(const std::string& command) {
+  const auto start = csc450::bench::Clock::now();
+  const int status = std::system(command.c_str());
+  const double elapsed = csc450::bench::secondsSince(start);
+  return status == 0 ? elapsed : -1.0;
+}
+
+/**
+ * Throughput comparison against the system tools, output discarded
+ */
+void runBench(const DumpConfig& config, char* self) {
+  const MappedFile file(config.path);
+  const double megabytes = static_cast<double>(file.size()) / (1024.0 * 1024.0);
+  const std::string quoted = "'" + config.path + "'";
+  const std::string me = std::string("'") + self + "'";
+
+  struct Entry {
+    std::string name;
+    std::string command;
+  };
+  std::vector<Entry> entries = {
+      {"memdump_1_thread", me + " -j 1 " + quoted},
+      {"memdump_all_threads", me + " " + quoted},
+      {"memdump_no_squeeze", me + " -v " + quoted},
+      {"xxd", "xxd " + quoted},
+      {"hexdump_C", "hexdump -C " + quoted},
+  };
+
+  csc450::bench::JsonWriter json(std::cout);
+  json.beginObject();
+  json.field("benchmark", "memdump");
+  json.field("file_bytes", file.size());
+  json.field("threads", std::thread::hardware_concurrency());
+  json.key("results").beginArray();
+  for (const auto& entry : entries) {
+    const std::string tool = entry.command.substr(0, entry.command.find(' '));
+    const bool available = tool.front() == '\'' || std::system(("command -v " + tool + " >/dev/null 2>&1").c_str()) == 0;
+    json.beginObject();
+    json.field("tool", entry.name);
+    const double seconds = available ? timeCommand(entry.command + " > /dev/null") : -1.0;
+    if (seconds > 0) {
+      json.field("seconds", seconds);
+      json.field("mb_per_s", megabytes / seconds);
+    } else {
+      json.key("seconds").null();
+      json.key("mb_per_s").null();
+    }
+    json.endObject();
+  }
+  json.endArray();
+  json.endObject();
+  std::cout << '\n';
+}
+
+uint64_t parseNumber(const char* text) {
+  // Accepts decimal or 0x-prefixed hex like xxd
+  char* end = nullptr;
+  errno = 0;
+  const unsigned long long value = std::strtoull(text, &end, 0);
+  if (errno != 0 || end == text || *end != '\0') {
+    throw std::invalid_argument(std::string("invalid number: ") + text);
+  }
+  return value;
+}
+
+DumpConfig parseArgs(int argc, char* argv[]) {
+  DumpConfig config;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "-s" && has_value) {
+      config.offset = parseNumber(argv[++i]);
+    } else if (arg == "-n" && has_value) {
+      config.length = parseNumber(argv[++i]);
+    } else if (arg == "-c" && has_value) {
+      config.format.bytes_per_line = static_cast<size_t>(parseNumber(argv[++i]));
+    } else if (arg == "-g" && has_value) {
+      config.format.group_size = static_cast<size_t>(parseNumber(argv[++i]));
+    } else if (arg == "-j" && has_value) {
+      config.threads = static_cast<size_t>(parseNumber(argv[++i]));
+    } else if (arg == "-v") {
+      config.squeeze = false;
+    } else if (arg == "--bench") {
+      config.bench = true;
+    } else if (!arg.empty() && arg[0] != '-' && config.path.empty()) {
+      config.path = arg;
+    } else {
+      throw std::invalid_argument("unknown argument: " + arg);
+    }
+  }
+  if (config.path.empty()) {
+    throw std::invalid_argument("no input file");
+  }
+  csc450::hexdump::validate(config.format);
+  return config;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    const DumpConfig config = parseArgs(argc, argv);
+    if (config.bench) {
+      runBench(config, argv[0]);
+      return EXIT_SUCCESS;
+    }
+    const MappedFile file(config.path);
+    if (file.mapped()) {
+      dumpMapped(file, config);
+    } else {
+      dumpStreamed(file, config);
+    }
+    return EXIT_SUCCESS;
+
+  } catch (const std::invalid_argument& e) {
+    std::cerr << "memdump: " << e.what() << '\n'
+              << "Usage: memdump [-s OFFSET] [-n LENGTH] [-c COLS] [-g GROUP] [-j THREADS] [-v] FILE\n"
+              << "       memdump --bench FILE\n";
+    return EXIT_FAILURE;
+  } catch (const std::exception& e) {
+    std::cerr << "memdump: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
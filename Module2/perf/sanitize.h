@@ -0,0 +1,172 @@
+/**
+ * Vectorized input sanitizer (secureAlternative() policy at bulk scale)
+ *
+ * Policy, unchanged from Module2/reference/buffer_overflow_demo.cpp:
+ * every byte outside the printable range 32..126 becomes '?'. Input is
+ * optionally truncated to a limit and the number of replacements is
+ * reported so callers can reject payloads that were mostly binary.
+ *
+ * Kernels: AVX2 (32 bytes/step, chosen at run time), SSE2 (x86-64
+ * baseline) and a scalar loop. Each step is a range compare, a blend with
+ * '?' and a popcount of the failing lanes; clean blocks skip the store.
+ */
+
+#ifndef CSC450_MODULE2_PERF_SANITIZE_H_
+#define CSC450_MODULE2_PERF_SANITIZE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CSC450_SANITIZE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace csc450::sanitize {
+
+inline constexpr char kReplacement = '?';
+
+struct Result {
+  size_t length = 0;    // bytes kept after truncation
+  size_t replaced = 0;  // bytes rewritten to kReplacement
+  bool truncated = false;
+};
+
+namespace detail {
+
+inline bool isAllowed(unsigned char c) noexcept {
+  return c >= 32 && c <= 126;
+}
+
+inline size_t sanitizeScalar(char* data, size_t n) noexcept {
+  size_t replaced = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (!isAllowed(static_cast<unsigned char>(data[i]))) {
+      data[i] = kReplacement;
+      ++replaced;
+    }
+  }
+  return replaced;
+}
+
+#if defined(CSC450_SANITIZE_X86)
+
+// Signed compares: 0x80..0xFF are negative and fail the lower bound
+inline size_t sanitizeSse2(char* data, size_t n) noexcept {
+  const __m128i low = _mm_set1_epi8(31);
+  const __m128i high = _mm_set1_epi8(127);
+  const __m128i replacement = _mm_set1_epi8(kReplacement);
+  size_t replaced = 0;
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i* block = reinterpret_cast<__m128i*>(data + i);
+    const __m128i v = _mm_loadu_si128(block);
+    const __m128i ok = _mm_and_si128(_mm_cmpgt_epi8(v, low), _mm_cmplt_epi8(v, high));
+    const unsigned bad = ~static_cast<unsigned>(_mm_movemask_epi8(ok)) & 0xFFFFu;
+    if (bad != 0) {
+      _mm_storeu_si128(block, _mm_or_si128(_mm_and_si128(ok, v), _mm_andnot_si128(ok, replacement)));
+      replaced += static_cast<size_t>(__builtin_popcount(bad));
+    }
+  }
+  return replaced + sanitizeScalar(data + i, n - i);
+}
+
+__attribute__((target("avx2,popcnt"))) inline size_t sanitizeAvx2(char* data, size_t n) noexcept {
+  const __m256i low = _mm256_set1_epi8(31);
+  const __m256i high = _mm256_set1_epi8(127);
+  const __m256i replacement = _mm256_set1_epi8(kReplacement);
+  size_t replaced = 0;
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i* block = reinterpret_cast<__m256i*>(data + i);
+    const __m256i v = _mm256_loadu_si256(block);
+    const __m256i ok = _mm256_and_si256(_mm256_cmpgt_epi8(v, low), _mm256_cmpgt_epi8(high, v));
+    const uint32_t bad = ~static_cast<uint32_t>(_mm256_movemask_epi8(ok));
+    if (bad != 0) {
+      _mm256_storeu_si256(block, _mm256_blendv_epi8(replacement, v, ok));
+      replaced += static_cast<size_t>(__builtin_popcount(bad));
+    }
+  }
+  return replaced + sanitizeSse2(data + i, n - i);
+}
+
+#endif  // CSC450_SANITIZE_X86
+
+using SanitizeFn = size_t (*)(char*, size_t) noexcept;
+
+inline SanitizeFn selectSanitize() {
+#if defined(CSC450_SANITIZE_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return sanitizeAvx2;
+  }
+  return sanitizeSse2;
+#else
+  return sanitizeScalar;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * Rewrites disallowed bytes in place; returns how many were replaced
+ */
+inline size_t sanitizeInPlace(char* data, size_t n) noexcept {
+  static const detail::SanitizeFn kernel = detail::selectSanitize();
+  return kernel(data, n);
+}
+
+/**
+ * Truncates to `limit` bytes, then sanitizes what is left
+ */
+inline Result sanitize(char* data, size_t size, size_t limit) noexcept {
+  Result result;
+  result.truncated = size > limit;
+  result.length = result.truncated ? limit : size;
+  result.replaced = sanitizeInPlace(data, result.length);
+  return result;
+}
+
+/**
+ * Incremental form for streamed payloads: the limit applies to the whole
+ * stream, so callers feed blocks and write out only `kept` bytes of each.
+ */
+class StreamSanitizer {
+ public:
+  explicit StreamSanitizer(size_t limit) : limit_(limit) {}
+
+  /**
+   * Sanitizes a block in place; returns how many of its bytes to keep
+   */
+  size_t feed(char* block, size_t size) noexcept {
+    const size_t room = limit_ - total_.length;
+    const Result part = sanitize(block, size, room);
+    total_.length += part.length;
+    total_.replaced += part.replaced;
+    total_.truncated = total_.truncated || part.truncated;
+    return part.length;
+  }
+
+  [[nodiscard]] bool full() const noexcept {
+    return total_.length >= limit_;
+  }
+
+  /**
+   * Marks the stream truncated when data arrives after the limit was hit
+   */
+  void noteOverflow() noexcept {
+    total_.truncated = true;
+  }
+
+  [[nodiscard]] const Result& result() const noexcept {
+    return total_;
+  }
+
+ private:
+  size_t limit_;
+  Result total_;
+};
+
+}  // namespace csc450::sanitize
+
+#endif  // CSC450_MODULE2_PERF_SANITIZE_H_
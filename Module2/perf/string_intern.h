@@ -0,0 +1,374 @@
+/**
+ * String interning for the Module 2 concatenation workload
+ *
+ * The concatenation program receives the same prefixes, names and suffixes
+ * over and over. Instead of holding one std::string per input, every distinct
+ * byte sequence is copied once into an append-only arena and handed out as a
+ * small integer ID. Equal strings get equal IDs, so comparison is an integer
+ * compare, and a concatenation of two already-seen IDs is answered from a
+ * pair cache instead of allocating a new result.
+ *
+ * Design notes:
+ * - StringArena hands out stable std::string_view's: blocks are never
+ *   reallocated, only new blocks are appended (MEM50-CPP: no dangling views)
+ * - StringInterner is an open-addressing (linear probing) table keyed by the
+ *   full 64-bit hash; the stored views live in the arena. The hash (FNV-1a)
+ *   can be continued across pieces, so left + right is hashed and compared
+ *   in place and only copied when it is new
+ * - ConcatCache maps the (left ID, right ID) pair to the interned result ID
+ *
+ * Not thread-safe: one interner per thread / per workload.
+ */
+
+#ifndef CSC450_MODULE2_PERF_STRING_INTERN_H_
+#define CSC450_MODULE2_PERF_STRING_INTERN_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace csc450 {
+
+/**
+ * Append-only byte arena with stable addresses
+ * Strings larger than the block size get a dedicated block so the
+ * regular blocks stay densely packed.
+ */
+class StringArena {
+ public:
+  static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+  explicit StringArena(size_t block_size = kDefaultBlockSize) : block_size_(block_size == 0 ? kDefaultBlockSize : block_size) {}
+
+  // Non-copyable: handed-out views point into our blocks (OOP58-CPP)
+  StringArena(const StringArena&) = delete;
+  StringArena& operator=(const StringArena&) = delete;
+  StringArena(StringArena&&) noexcept = default;
+  StringArena& operator=(StringArena&&) noexcept = default;
+
+  /**
+   * Copies the bytes of text into the arena and returns a view of the copy
+   */
+  std::string_view store(std::string_view text) {
+    if (text.empty()) {
+      return {};
+    }
+    char* dest = allocate(text.size());
+    std::memcpy(dest, text.data(), text.size());
+    return {dest, text.size()};
+  }
+
+  /**
+   * Stores left + right as one contiguous string without a temporary
+   */
+  std::string_view storeConcat(std::string_view left, std::string_view right) {
+    const size_t total = left.size() + right.size();
+    if (total == 0) {
+      return {};
+    }
+    char* dest = allocate(total);
+    std::memcpy(dest, left.data(), left.size());
+    std::memcpy(dest + left.size(), right.data(), right.size());
+    return {dest, total};
+  }
+
+  [[nodiscard]] size_t bytesUsed() const noexcept {
+    return bytes_used_;
+  }
+
+  [[nodiscard]] size_t bytesReserved() const noexcept {
+    return bytes_reserved_;
+  }
+
+ private:
+  char* allocate(size_t size) {
+    if (size > block_size_ / 4) {
+      // Oversized request: dedicated block, keep the current block open
+      blocks_.push_back(std::make_unique<char[]>(size));
+      bytes_reserved_ += size;
+      bytes_used_ += size;
+      return blocks_.back().get();
+    }
+    if (current_ == nullptr || remaining_ < size) {
+      blocks_.push_back(std::make_unique<char[]>(block_size_));
+      current_ = blocks_.back().get();
+      remaining_ = block_size_;
+      bytes_reserved_ += block_size_;
+    }
+    char* result = current_;
+    current_ += size;
+    remaining_ -= size;
+    bytes_used_ += size;
+    return result;
+  }
+
+  size_t block_size_;
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* current_ = nullptr;
+  size_t remaining_ = 0;
+  size_t bytes_used_ = 0;
+  size_t bytes_reserved_ = 0;
+};
+
+/**
+ * Maps distinct strings to dense 32-bit IDs
+ */
+class StringInterner {
+ public:
+  using Id = uint32_t;
+  static constexpr Id kInvalidId = std::numeric_limits<Id>::max();
+
+  struct Stats {
+    uint64_t lookups = 0;
+    uint64_t hits = 0;             // lookup found an existing entry
+    uint64_t bytes_requested = 0;  // total bytes passed to intern()
+    uint64_t bytes_stored = 0;     // bytes actually copied into the arena
+  };
+
+  explicit StringInterner(size_t expected_strings = 1024) {
+    size_t capacity = 16;
+    while (capacity < expected_strings * 2) {
+      capacity <<= 1;
+    }
+    slots_.assign(capacity, Slot{});
+  }
+
+  /**
+   * Returns the ID for text, storing it on first sight
+   */
+  Id intern(std::string_view text) {
+    ++stats_.lookups;
+    stats_.bytes_requested += text.size();
+    const uint64_t hash = hashOf(text);
+    size_t index = findSlot(text, {}, hash);
+    if (slots_[index].id != kInvalidId) {
+      ++stats_.hits;
+      return slots_[index].id;
+    }
+    return insertAt(index, arena_.store(text), hash);
+  }
+
+  /**
+   * Looks text up without inserting; kInvalidId when absent
+   */
+  [[nodiscard]] Id find(std::string_view text) const {
+    return slots_[findSlot(text, {}, hashOf(text))].id;
+  }
+
+  /**
+   * Interns left + right. The concatenated bytes are only written to the
+   * arena if the result has not been seen before.
+   */
+  Id internConcat(std::string_view left, std::string_view right) {
+    const size_t total = left.size() + right.size();
+    ++stats_.lookups;
+    stats_.bytes_requested += total;
+
+    // Hash and compare the logical concatenation without materialising it
+    const uint64_t hash = hashOf(right, hashOf(left));
+    size_t index = findSlot(left, right, hash);
+    if (slots_[index].id != kInvalidId) {
+      ++stats_.hits;
+      return slots_[index].id;
+    }
+    return insertAt(index, arena_.storeConcat(left, right), hash);
+  }
+
+  [[nodiscard]] std::string_view view(Id id) const {
+    if (id >= views_.size()) {
+      throw std::out_of_range("StringInterner::view: unknown id");
+    }
+    return views_[id];
+  }
+
+  [[nodiscard]] size_t size() const noexcept {
+    return views_.size();
+  }
+
+  [[nodiscard]] const Stats& stats() const noexcept {
+    return stats_;
+  }
+
+  [[nodiscard]] const StringArena& arena() const noexcept {
+    return arena_;
+  }
+
+  /**
+   * Approximate bookkeeping overhead: hash slots plus the ID -> view table
+   */
+  [[nodiscard]] size_t indexBytes() const noexcept {
+    return slots_.capacity() * sizeof(Slot) + views_.capacity() * sizeof(std::string_view);
+  }
+
+ private:
+  struct Slot {
+    uint64_t hash = 0;
+    Id id = kInvalidId;
+  };
+
+  static constexpr uint64_t kFnvOffset = 0xcbf29ce484222325ULL;
+  static constexpr uint64_t kFnvPrime = 0x100000001b3ULL;
+
+  // FNV-1a; hashOf(b, hashOf(a)) == hashOf(a + b)
+  static uint64_t hashOf(std::string_view text, uint64_t hash = kFnvOffset) noexcept {
+    for (const char c : text) {
+      hash = (hash ^ static_cast<unsigned char>(c)) * kFnvPrime;
+    }
+    return hash;
+  }
+
+  // Slot holding left + right, or the empty slot where it would go
+  size_t findSlot(std::string_view left, std::string_view right, uint64_t hash) const {
+    const size_t mask = slots_.size() - 1;
+    size_t index = static_cast<size_t>(hash) & mask;
+    while (slots_[index].id != kInvalidId) {
+      const std::string_view stored = views_[slots_[index].id];
+      if (slots_[index].hash == hash && stored.size() == left.size() + right.size() && stored.substr(0, left.size()) == left &&
+          stored.substr(left.size()) == right) {
+        return index;
+      }
+      index = (index + 1) & mask;
+    }
+    return index;
+  }
+
+  Id insertAt(size_t index, std::string_view stored, uint64_t hash) {
+    if (views_.size() >= kInvalidId) {
+      throw std::length_error("StringInterner: id space exhausted");
+    }
+    stats_.bytes_stored += stored.size();
+    const Id id = static_cast<Id>(views_.size());
+    views_.push_back(stored);
+    slots_[index] = Slot{hash, id};
+    // Keep the load factor at or below 1/2 so probe chains stay short
+    if (views_.size() * 2 > slots_.size()) {
+      grow();
+    }
+    return id;
+  }
+
+  void grow() {
+    std::vector<Slot> old = std::move(slots_);
+    slots_.assign(old.size() * 2, Slot{});
+    const size_t mask = slots_.size() - 1;
+    for (const Slot& slot : old) {
+      if (slot.id == kInvalidId) {
+        continue;
+      }
+      size_t index = static_cast<size_t>(slot.hash) & mask;
+      while (slots_[index].id != kInvalidId) {
+        index = (index + 1) & mask;
+      }
+      slots_[index] = slot;
+    }
+  }
+
+  StringArena arena_;
+  std::vector<Slot> slots_;
+  std::vector<std::string_view> views_;
+  Stats stats_;
+};
+
+/**
+ * Result cache for concatenations of interned pairs
+ * Key is (left << 32 | right); value is the interned result ID.
+ */
+class ConcatCache {
+ public:
+  using Id = StringInterner::Id;
+
+  struct Stats {
+    uint64_t lookups = 0;
+    uint64_t hits = 0;
+  };
+
+  explicit ConcatCache(StringInterner& interner, size_t expected_pairs = 1024) : interner_(interner) {
+    size_t capacity = 16;
+    while (capacity < expected_pairs * 2) {
+      capacity <<= 1;
+    }
+    slots_.assign(capacity, Slot{});
+  }
+
+  /**
+   * Returns the ID of view(left) + view(right), computing it only once
+   */
+  Id concat(Id left, Id right) {
+    ++stats_.lookups;
+    const uint64_t key = (static_cast<uint64_t>(left) << 32) | right;
+    const size_t mask = slots_.size() - 1;
+    size_t index = mix(key) & mask;
+    while (slots_[index].value != StringInterner::kInvalidId) {
+      if (slots_[index].key == key) {
+        ++stats_.hits;
+        return slots_[index].value;
+      }
+      index = (index + 1) & mask;
+    }
+
+    const Id result = interner_.internConcat(interner_.view(left), interner_.view(right));
+    slots_[index] = Slot{key, result};
+    if (++entries_ * 2 > slots_.size()) {
+      grow();
+    }
+    return result;
+  }
+
+  [[nodiscard]] const Stats& stats() const noexcept {
+    return stats_;
+  }
+
+  [[nodiscard]] size_t size() const noexcept {
+    return entries_;
+  }
+
+  [[nodiscard]] size_t indexBytes() const noexcept {
+    return slots_.capacity() * sizeof(Slot);
+  }
+
+ private:
+  struct Slot {
+    uint64_t key = 0;
+    Id value = StringInterner::kInvalidId;
+  };
+
+  // splitmix64 finaliser: spreads the packed ID pair across the table
+  static size_t mix(uint64_t key) noexcept {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return static_cast<size_t>(key);
+  }
+
+  void grow() {
+    std::vector<Slot> old = std::move(slots_);
+    slots_.assign(old.size() * 2, Slot{});
+    const size_t mask = slots_.size() - 1;
+    for (const Slot& slot : old) {
+      if (slot.value == StringInterner::kInvalidId) {
+        continue;
+      }
+      size_t index = mix(slot.key) & mask;
+      while (slots_[index].value != StringInterner::kInvalidId) {
+        index = (index + 1) & mask;
+      }
+      slots_[index] = slot;
+    }
+  }
+
+  StringInterner& interner_;
+  std::vector<Slot> slots_;
+  size_t entries_ = 0;
+  Stats stats_;
+};
+
+}  // namespace csc450
+
+#endif  // CSC450_MODULE2_PERF_STRING_INTERN_H_
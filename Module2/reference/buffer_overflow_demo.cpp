@@ -24,32 +24,47 @@
  * penetration testing training, and secure coding workshops.
  */
 
-#include <cstring>
-#include <iomanip>
 #include <iostream>
 #include <string>
 
+#include "../perf/bounded_reader.h"
+#include "../perf/hexdump.h"
+#include "../perf/integrity_registry.h"
+#include "../perf/sanitize.h"
+
 // Function to display memory contents (for demonstration purposes)
+// Uses the block-based hex dump engine: the whole region is formatted into
+// one buffer (hexdump -C layout) instead of mutating std::cout per byte
 void displayMemory(const char *buffer, size_t size, const char *label) {
   std::cout << "\n" << label << " Memory contents:" << std::endl;
   std::cout << "Address: " << static_cast<const void *>(buffer) << std::endl;
-  std::cout << "Hex dump: ";
-  for (size_t i = 0; i < size; ++i) {
-    std::cout << std::hex << std::setw(2) << std::setfill('0')
-              << (unsigned char)buffer[i] << " ";
-    if ((i + 1) % 8 == 0)
-      std::cout << " ";
-  }
-  std::cout << std::dec << std::endl;
+  std::cout << "Hex dump:" << std::endl;
+  csc450::hexdump::dump(buffer, size, csc450::hexdump::Options{}, std::cout);
   std::cout << "String: \"" << buffer << "\"" << std::endl;
 }
 
+// The registry that watches vulnerableFunction()'s buffers. It must not
+// live in the frame under attack (or any caller's frame, which the overflow
+// also runs into): a smashed local registry could lose its own heap
+// pointers and crash or miss the breach instead of reporting it
+csc450::IntegrityRegistry &demoRegistry() {
+  static csc450::IntegrityRegistry registry;
+  return registry;
+}
+
 // Vulnerable function that demonstrates stack corruption
 void vulnerableFunction() {
   char important_data[16] = "SENSITIVE_DATA!";
   char user_buffer[16];
   char canary[16] = "CANARY_VALUE__";
 
+  // Register both buffers so one checkpoint verifies them together; the
+  // ids are static too, so the overflow cannot redirect unprotect()
+  static csc450::IntegrityRegistry::Id canary_id;
+  static csc450::IntegrityRegistry::Id data_id;
+  canary_id = demoRegistry().protectExact(canary, sizeof(canary));
+  data_id = demoRegistry().protectChecksum(important_data, sizeof(important_data));
+
   std::cout << "\n=== STACK LAYOUT BEFORE INPUT ===" << std::endl;
   std::cout << "Stack layout (top to bottom):" << std::endl;
   std::cout << "1. important_data[16]: " << important_data << std::endl;
@@ -71,16 +86,20 @@ void vulnerableFunction() {
   displayMemory(user_buffer, 16, "User Buffer (AFTER)");
   displayMemory(canary, 16, "Canary (AFTER)");
 
-  // Check if adjacent memory was corrupted
-  if (strcmp(canary, "CANARY_VALUE__") != 0) {
-    std::cout << "\n🚨 SECURITY BREACH DETECTED! 🚨" << std::endl;
-    std::cout << "Stack canary was overwritten!" << std::endl;
-    std::cout << "This indicates a buffer overflow attack!" << std::endl;
-  }
-
-  if (strcmp(important_data, "SENSITIVE_DATA!") != 0) {
-    std::cout << "\n💥 CRITICAL: SENSITIVE DATA CORRUPTED! 💥" << std::endl;
-    std::cout << "Important data has been overwritten!" << std::endl;
+  // Check if adjacent memory was corrupted (bulk checkpoint over every
+  // registered region instead of one strcmp per buffer)
+  const auto report = demoRegistry().verifyAll();
+  demoRegistry().unprotect(canary_id);  // the frame is about to go away
+  demoRegistry().unprotect(data_id);
+  for (const auto &violation : report.violations) {
+    if (violation.address == canary) {
+      std::cout << "\n🚨 SECURITY BREACH DETECTED! 🚨" << std::endl;
+      std::cout << "Stack canary was overwritten!" << std::endl;
+      std::cout << "This indicates a buffer overflow attack!" << std::endl;
+    } else if (violation.address == important_data) {
+      std::cout << "\n💥 CRITICAL: SENSITIVE DATA CORRUPTED! 💥" << std::endl;
+      std::cout << "Important data has been overwritten!" << std::endl;
+    }
   }
 }
 
@@ -99,35 +118,42 @@ void demonstrateAttacks() {
 }
 
 // Safe alternative using modern C++
-void secureAlternative() {
-  std::cout << "\n=== SECURE ALTERNATIVE ===" << std::endl;
+// Takes its streams as parameters so it can also be driven without a
+// terminal (see ../perf/fuzz_secure_alternative.cpp)
+void secureAlternative(std::istream &in, std::ostream &out) {
+  out << "\n=== SECURE ALTERNATIVE ===" << std::endl;
 
-  std::string safe_input;
   const size_t MAX_LENGTH = 15;
 
-  std::cout << "Enter your name (SECURE version): ";
-  std::getline(std::cin, safe_input);
+  out << "Enter your name (SECURE version): ";
+
+  // Read straight into a fixed buffer: at most MAX_LENGTH bytes are kept
+  // and the rest of the line is skipped without ever being stored, so a
+  // huge line cannot force a huge allocation (see ../perf/bounded_reader.h)
+  char name_buffer[MAX_LENGTH + 1];
+  char scratch[256];
+  csc450::BoundedLineReader<csc450::IstreamSource> reader(
+      csc450::IstreamSource(in), scratch, sizeof(scratch));
+  const auto line = reader.readLine(name_buffer, sizeof(name_buffer));
 
   // Input validation and sanitization
-  if (safe_input.length() > MAX_LENGTH) {
-    std::cout << "⚠️  Input too long! Truncating to " << MAX_LENGTH
-              << " characters." << std::endl;
-    safe_input = safe_input.substr(0, MAX_LENGTH);
+  if (line.truncated()) {
+    out << "⚠️  Input too long! Truncating to " << MAX_LENGTH << " characters."
+        << std::endl;
   }
+  std::string safe_input(name_buffer, line.length);
 
   // Additional validation - remove dangerous characters
-  for (char &c : safe_input) {
-    if (c < 32 || c > 126) { // Remove non-printable characters
-      c = '?';
-    }
-  }
+  // (bytes outside 32..126 become '?', vectorized; see ../perf/sanitize.h)
+  csc450::sanitize::sanitizeInPlace(safe_input.data(), safe_input.size());
 
-  std::cout << "✅ Safely processed input: \"" << safe_input << "\""
-            << std::endl;
-  std::cout << "✅ Length: " << safe_input.length() << " characters"
-            << std::endl;
+  out << "✅ Safely processed input: \"" << safe_input << "\"" << std::endl;
+  out << "✅ Length: " << safe_input.length() << " characters" << std::endl;
 }
 
+void secureAlternative() { secureAlternative(std::cin, std::cout); }
+
+#ifndef CSC450_FUZZING  // fuzz builds supply their own entry point
 int main() {
   std::cout << "=== BUFFER OVERFLOW SECURITY DEMONSTRATION ===" << std::endl;
   std::cout << "This program demonstrates why input validation is critical!"
@@ -165,3 +191,4 @@ int main() {
 
   return 0;
 }
+#endif  // CSC450_FUZZING
@@ -1,7 +1,12 @@
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <string>
 
+#include "perf/float_format.h"
+#include "perf/format.h"
+#include "perf/padding.h"
+
 class StreamStateVulnerability {
 public:
   void process_user_data(const std::string &data) {
@@ -17,6 +22,7 @@ public:
     // showing the change prior to the stream state change:
     std::cout << "Before restoring state: \n";
     display_account_info();
+    display_account_info_stateless();
 
     // Restore original stream state
     std::cout.flags(original_flags);
@@ -27,6 +33,13 @@ public:
     // BUG: This will print in hex due to previous function
     std::cout << "Account: " << account_number << std::endl; // Prints "3039"
   }
+
+  void display_account_info_stateless() {
+    int account_number = 12345;
+    // SAFE: the format is fixed in the format string and written with
+    // ostream::write, so leaked flags have no effect (see perf/format.h)
+    csc450::fmt::print<"Account (stateless): {}\n">(std::cout, account_number);
+  }
 };
 
 void demonstrate_precision_vulnerability() {
@@ -65,6 +78,21 @@ void demonstrate_safe_precision() {
 
   std::cout << std::setw(safe_width) << "test" << std::endl;
 
+  // SAFE at the full requested width: the fill comes from a static page,
+  // never a width-sized buffer, so no low cap is needed (see perf/padding.h)
+  csc450::pad::writePadded(std::cout, "test",
+                           static_cast<size_t>(std::max(user_width, 0)));
+  std::cout << std::endl;
+
+  // SAFE without stream state: clamped, allocation-free to_chars output
+  // (see perf/float_format.h)
+  std::cout << "Shortest round-trip: "
+            << csc450::floatfmt::shortest(sensitive_value).view() << std::endl;
+  std::cout << "Requested 50 digits, clamped to 17: "
+            << csc450::floatfmt::significant(sensitive_value, user_precision)
+                   .view()
+            << std::endl;
+
   // Always restore original state
   std::cout.flags(original_flags);
   std::cout.precision(original_precision);
@@ -0,0 +1,216 @@
+/**
+ * Concurrent formatting: shared stream vs per-thread contexts
+ *
+ * Each thread writes lines "worker=<t> seq=<n> id=<HEX> ratio=<r>" with:
+ *   shared_ostream   one std::ostream for all threads; every line locks a
+ *                    mutex, saves flags/precision, sets hex/uppercase/
+ *                    setprecision, formats, and restores (the demos'
+ *                    pattern made thread-safe)
+ *   format_context   a csc450::FormatContext per thread feeding one
+ *                    LineSink; no lock is held while formatting
+ * Both write to /dev/null. Lines/sec are reported for 1..N threads, and a
+ * run into a temporary file checks that no line was torn or interleaved.
+ * Edge fields are checked the same way: the widest integers in radix 2
+ * (every bit plus a sign) and the character types std::ostream prints as
+ * characters.
+ *
+ * Usage: context_bench [--lines N] [--max-threads N]
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "bench_util.h"
+#include "format_context.h"
+#include "posix_io.h"
+
+namespace {
+
+double ratioFor(uint64_t n) {
+  return static_cast<double>(n % 9973) / 7.0;
+}
+
+uint32_t idFor(unsigned worker, uint64_t n) {
+  return static_cast<uint32_t>((n + 1) * 2654435761u) ^ worker;
+}
+
+template <typename Body>
+double runThreads(unsigned threads, Body body) {
+  std::vector<std::thread> workers;
+  const auto start = csc450::bench::Clock::now();
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back(body, t);
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return csc450::bench::secondsSince(start);
+}
+
+double sharedOstream(unsigned threads, uint64_t lines) {
+  std::ofstream out("/dev/null");
+  std::mutex mutex;
+  return runThreads(threads, [&](unsigned worker) {
+    for (uint64_t n = 0; n < lines; ++n) {
+      std::lock_guard<std::mutex> lock(mutex);
+      const std::ios_base::fmtflags saved_flags = out.flags();
+      const std::streamsize saved_precision = out.precision();
+      out << "worker=" << worker << " seq=" << n << " id=" << std::hex << std::uppercase << idFor(worker, n) << " ratio=" << std::dec << std::setprecision(4)
+          << ratioFor(n) << '\n';
+      out.flags(saved_flags);
+      out.precision(saved_precision);
+    }
+  });
+}
+
+void contextLines(csc450::LineSink& sink, unsigned worker, uint64_t lines) {
+  csc450::FormatContext out(sink);
+  out.precision(4);
+  for (uint64_t n = 0; n < lines; ++n) {
+    out.radix(10).uppercase(false) << "worker=" << worker << " seq=" << n;
+    out.radix(16).uppercase(true) << " id=" << idFor(worker, n);
+    out << " ratio=" << ratioFor(n);
+    out.endLine();
+  }
+}
+
+double formatContexts(unsigned threads, uint64_t lines, int fd) {
+  csc450::LineSink sink(fd);
+  return runThreads(threads, [&](unsigned worker) { contextLines(sink, worker, lines); });
+}
+
+/**
+ * Writes through contexts into a temporary file and checks every line is
+ * whole and every worker's sequence arrives complete and in order
+ */
+bool linesIntact(unsigned threads, uint64_t lines) {
+  char path[] = "/tmp/context_bench_XXXXXX";
+  const int fd = ::mkstemp(path);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), "mkstemp");
+  }
+  formatContexts(threads, lines, fd);
+  ::close(fd);
+  std::ifstream in(path);
+  std::vector<uint64_t> next(threads, 0);
+  std::string line;
+  bool intact = true;
+  while (intact && std::getline(in, line)) {
+    unsigned worker = 0;
+    unsigned long long seq = 0;
+    unsigned id = 0;
+    double ratio = 0;
+    intact = std::sscanf(line.c_str(), "worker=%u seq=%llu id=%X ratio=%lf", &worker, &seq, &id, &ratio) == 4 && worker < threads && seq == next[worker] &&
+             id == idFor(worker, seq);
+    if (intact) {
+      ++next[worker];
+    }
+  }
+  ::unlink(path);
+  return intact && std::all_of(next.begin(), next.end(), [&](uint64_t count) { return count == lines; });
+}
+
+bool edgeFieldsMatch() {
+  char path[] = "/tmp/context_bench_XXXXXX";
+  const int fd = ::mkstemp(path);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), "mkstemp");
+  }
+  ::unlink(path);
+  std::string expected = "-1" + std::string(63, '0') + "\n";
+  {
+    csc450::LineSink sink(fd);
+    csc450::FormatContext out(sink);
+    out.radix(2) << std::numeric_limits<long long>::min();
+    out.endLine();
+#if defined(__SIZEOF_INT128__)
+    if constexpr (std::is_integral_v<__int128>) {  // only with GNU extensions
+      out << -(static_cast<__int128>(1) << 126);
+      out.endLine();
+      out << ~static_cast<unsigned __int128>(0);
+      out.endLine();
+      expected += "-1" + std::string(126, '0') + "\n" + std::string(128, '1') + "\n";
+    }
+#endif
+    out.radix(10) << static_cast<signed char>('s') << static_cast<uint8_t>('u') << static_cast<short>(-7);
+    out.endLine();
+    expected += "su-7\n";
+  }
+  ::lseek(fd, 0, SEEK_SET);
+  const std::string text = csc450::io::readFile(fd);
+  ::close(fd);
+  return text == expected;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    uint64_t lines = 200000;
+    unsigned max_threads = std::max(1u, std::min(8u, std::thread::hardware_concurrency()));
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--lines" && i + 1 < argc) {
+        lines = std::strtoull(argv[++i], nullptr, 10);
+      } else if (arg == "--max-threads" && i + 1 < argc) {
+        max_threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--lines N] [--max-threads N]\n";
+        return EXIT_FAILURE;
+      }
+    }
+
+    const int null_fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (null_fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "open /dev/null");
+    }
+    const bool intact = linesIntact(max_threads, lines / 4);
+    const bool edge_fields = edgeFieldsMatch();
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "format_contexts");
+    json.field("lines_per_thread", lines);
+    json.field("lines_intact", intact);
+    json.field("edge_fields_match", edge_fields);
+    json.key("results").beginArray();
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+      const double total = static_cast<double>(lines) * threads;
+      const double shared_s = sharedOstream(threads, lines);
+      const double context_s = formatContexts(threads, lines, null_fd);
+      json.beginObject();
+      json.field("threads", threads);
+      json.field("shared_ostream_lines_per_sec", total / shared_s);
+      json.field("format_context_lines_per_sec", total / context_s);
+      json.field("speedup", shared_s / context_s);
+      json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    std::cout << '\n';
+    ::close(null_fd);
+    return intact && edge_fields ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "context_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,151 @@
+/**
+ * Floating-point output cost across precision levels
+ *
+ * For each requested precision (1, 6, 12, 17 and the post's 50) formats a
+ * fixed set of doubles of mixed magnitude with:
+ *   ostream      std::ostream << setprecision(p) (default float field)
+ *   snprintf     "%.*g"
+ *   significant  csc450::floatfmt::significant (clamped to 17 digits)
+ * and, per precision, the fixed-notation pair ostream << std::fixed vs
+ * floatfmt::fixed. The shortest round-trip path is timed once, and every
+ * shortest() output is parsed back with from_chars to confirm it is exact.
+ *
+ * Usage: float_bench [--min-time SECONDS]
+ */
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "float_format.h"
+
+namespace {
+
+class DiscardStreambuf : public std::streambuf {
+ protected:
+  int_type overflow(int_type c) override {
+    return traits_type::not_eof(c);
+  }
+  std::streamsize xsputn(const char*, std::streamsize count) override {
+    return count;
+  }
+};
+
+// Values from 1e-12 to 1e12 plus the post's 123.456789123456
+std::vector<double> makeValues(size_t count) {
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> mantissa(1.0, 10.0);
+  std::uniform_int_distribution<int> exponent(-12, 12);
+  std::vector<double> values;
+  values.reserve(count);
+  values.push_back(123.456789123456);
+  while (values.size() < count) {
+    const double sign = values.size() % 3 == 0 ? -1.0 : 1.0;
+    values.push_back(sign * mantissa(rng) * std::pow(10.0, exponent(rng)));
+  }
+  return values;
+}
+
+bool shortestRoundTrips(const std::vector<double>& values) {
+  for (const double value : values) {
+    const auto text = csc450::floatfmt::shortest(value);
+    double parsed = 0;
+    const auto result = std::from_chars(text.chars, text.chars + text.size, parsed);
+    if (result.ec != std::errc() || parsed != value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    double min_time = 0.05;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--min-time SECONDS]\n";
+        return EXIT_FAILURE;
+      }
+    }
+
+    const std::vector<double> values = makeValues(4096);
+    const double per_value = 1.0 / static_cast<double>(values.size());
+    DiscardStreambuf discard;
+    std::ostream stream(&discard);
+    const auto sink = [&](const char* data, size_t size) { discard.sputn(data, static_cast<std::streamsize>(size)); };
+
+    const auto timeAll = [&](auto&& format) {
+      return csc450::bench::nsPerOp([&] {
+        for (const double value : values) {
+          format(value);
+        }
+      }, min_time) * per_value;
+    };
+
+    const double shortest_ns = timeAll([&](double v) {
+      const auto text = csc450::floatfmt::shortest(v);
+      sink(text.chars, text.size);
+    });
+    const double ostream_17_ns = timeAll([&](double v) { stream << std::defaultfloat << std::setprecision(17) << v; });
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "float_output");
+    json.field("values", values.size());
+    json.field("shortest_round_trips", shortestRoundTrips(values));
+    json.key("shortest").beginObject();
+    json.field("floatfmt_ns_per_value", shortest_ns);
+    json.field("ostream_precision17_ns_per_value", ostream_17_ns);
+    json.endObject();
+    json.key("by_precision").beginArray();
+    for (const int precision : {1, 6, 12, 17, 50}) {
+      const double ostream_ns = timeAll([&](double v) { stream << std::defaultfloat << std::setprecision(precision) << v; });
+      const double snprintf_ns = timeAll([&](double v) {
+        char text[512];
+        const int size = std::snprintf(text, sizeof(text), "%.*g", precision, v);
+        sink(text, static_cast<size_t>(size));
+      });
+      const double significant_ns = timeAll([&](double v) {
+        char text[csc450::floatfmt::kBufferSize];
+        sink(text, csc450::floatfmt::writeSignificant(text, sizeof(text), v, precision));
+      });
+      const double ostream_fixed_ns = timeAll([&](double v) { stream << std::fixed << std::setprecision(precision) << v; });
+      const double fixed_ns = timeAll([&](double v) {
+        char text[csc450::floatfmt::kBufferSize];
+        sink(text, csc450::floatfmt::writeFixed(text, sizeof(text), v, precision));
+      });
+      json.beginObject();
+      json.field("requested_precision", precision);
+      json.field("effective_significant_digits", csc450::floatfmt::clampSignificant(precision));
+      json.field("ostream_ns_per_value", ostream_ns);
+      json.field("snprintf_ns_per_value", snprintf_ns);
+      json.field("floatfmt_significant_ns_per_value", significant_ns);
+      json.field("ostream_fixed_ns_per_value", ostream_fixed_ns);
+      json.field("floatfmt_fixed_ns_per_value", fixed_ns);
+      json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    std::cout << '\n';
+    return EXIT_SUCCESS;
+
+  } catch (const std::exception& e) {
+    std::cerr << "float_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
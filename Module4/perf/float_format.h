@@ -0,0 +1,112 @@
+/**
+ * Allocation-free floating-point output with clamped precision
+ *
+ * demonstrate_precision_vulnerability() prints a double with
+ * setprecision(50): everything past the 17th significant digit is just the
+ * binary expansion of the stored value, and the caller chose how much of it
+ * to reveal. demonstrate_safe_precision() clamps to 12 through iostream,
+ * paying for stream state on every call.
+ *
+ * These functions sit on std::to_chars (Ryu-based in libstdc++):
+ * - shortest():    fewest digits that parse back to the same double
+ * - significant(): %g-style, digits clamped to [1, kMaxSignificantDigits]
+ * - fixed():       digits after the point clamped to [0, kMaxFixedDecimals]
+ * - scientific():  digits after the point clamped likewise
+ * Requested precision is a runtime value here (compare format.h, where it
+ * is fixed at compile time), so the clamp is what keeps it safe.
+ *
+ * Results are returned in a Formatted value whose inline array is large
+ * enough for any double in any mode, so nothing allocates and nothing can
+ * be truncated. The write*() forms take a caller buffer instead.
+ */
+
+#ifndef CSC450_MODULE4_PERF_FLOAT_FORMAT_H_
+#define CSC450_MODULE4_PERF_FLOAT_FORMAT_H_
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <system_error>
+
+namespace csc450::floatfmt {
+
+// max_digits10: any more digits only expose representation noise
+inline constexpr int kMaxSignificantDigits = std::numeric_limits<double>::max_digits10;
+inline constexpr int kMaxFixedDecimals = kMaxSignificantDigits;
+
+// Fixed notation of -DBL_MAX: sign, 309 integer digits, point, decimals
+inline constexpr size_t kBufferSize = 1 + (std::numeric_limits<double>::max_exponent10 + 1) + 1 + kMaxFixedDecimals;
+
+inline constexpr int clampSignificant(int digits) noexcept {
+  return std::clamp(digits, 1, kMaxSignificantDigits);
+}
+
+inline constexpr int clampDecimals(int decimals) noexcept {
+  return std::clamp(decimals, 0, kMaxFixedDecimals);
+}
+
+/**
+ * Each returns the number of bytes written, or 0 if `capacity` is too
+ * small (kBufferSize always suffices). No terminator is written.
+ */
+inline size_t writeShortest(char* buffer, size_t capacity, double value) noexcept {
+  const auto result = std::to_chars(buffer, buffer + capacity, value);
+  return result.ec == std::errc() ? static_cast<size_t>(result.ptr - buffer) : 0;
+}
+
+inline size_t writeSignificant(char* buffer, size_t capacity, double value, int digits) noexcept {
+  const auto result = std::to_chars(buffer, buffer + capacity, value, std::chars_format::general, clampSignificant(digits));
+  return result.ec == std::errc() ? static_cast<size_t>(result.ptr - buffer) : 0;
+}
+
+inline size_t writeFixed(char* buffer, size_t capacity, double value, int decimals) noexcept {
+  const auto result = std::to_chars(buffer, buffer + capacity, value, std::chars_format::fixed, clampDecimals(decimals));
+  return result.ec == std::errc() ? static_cast<size_t>(result.ptr - buffer) : 0;
+}
+
+inline size_t writeScientific(char* buffer, size_t capacity, double value, int decimals) noexcept {
+  const auto result = std::to_chars(buffer, buffer + capacity, value, std::chars_format::scientific, clampDecimals(decimals));
+  return result.ec == std::errc() ? static_cast<size_t>(result.ptr - buffer) : 0;
+}
+
+/**
+ * Formatted text held by value
+ */
+struct Formatted {
+  char chars[kBufferSize];
+  size_t size = 0;
+
+  [[nodiscard]] std::string_view view() const noexcept {
+    return std::string_view(chars, size);
+  }
+};
+
+inline Formatted shortest(double value) noexcept {
+  Formatted out;
+  out.size = writeShortest(out.chars, sizeof(out.chars), value);
+  return out;
+}
+
+inline Formatted significant(double value, int digits) noexcept {
+  Formatted out;
+  out.size = writeSignificant(out.chars, sizeof(out.chars), value, digits);
+  return out;
+}
+
+inline Formatted fixed(double value, int decimals) noexcept {
+  Formatted out;
+  out.size = writeFixed(out.chars, sizeof(out.chars), value, decimals);
+  return out;
+}
+
+inline Formatted scientific(double value, int decimals) noexcept {
+  Formatted out;
+  out.size = writeScientific(out.chars, sizeof(out.chars), value, decimals);
+  return out;
+}
+
+}  // namespace csc450::floatfmt
+
+#endif  // CSC450_MODULE4_PERF_FLOAT_FORMAT_H_
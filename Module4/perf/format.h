@@ -0,0 +1,470 @@
+/**
+ * Stateless, compile-time checked formatting into caller buffers
+ *
+ * discussionpost.cpp shows the iostream hazard: std::hex / std::uppercase
+ * set in process_user_data() leak into display_account_info() because the
+ * formatting state lives in the shared std::cout object. Here every
+ * formatting decision is part of the format string, fixed at compile time:
+ *
+ *     char line[64];
+ *     auto r = csc450::fmt::formatTo<"Account: {:08X} ({:.2f})\n">(line, sizeof(line), id, balance);
+ *     std::cout.write(line, r.size);   // unformatted write, flags ignored
+ *
+ * The format string is a template argument, parsed by a consteval function
+ * with std::format-style syntax: {[:[[fill]align][sign][#][0][width][.precision][type]]}
+ * Field count, spec syntax and spec/argument type compatibility are checked
+ * at compile time, and width and precision are capped (kMaxWidth,
+ * kMaxPrecision) so neither can come from user input (FIO47-C, the
+ * setw(user_width) problem in the discussion post). Unsupported on purpose:
+ * explicit argument indexes, dynamic {} width/precision, locales.
+ *
+ * Output never exceeds the capacity given; Result reports bytes written and
+ * the size the full output would have needed. formatTo() never allocates;
+ * print() formats on the stack and falls back to one std::string only when
+ * a line needs more than 256 bytes.
+ */
+
+#ifndef CSC450_MODULE4_PERF_FORMAT_H_
+#define CSC450_MODULE4_PERF_FORMAT_H_
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace csc450::fmt {
+
+inline constexpr int kMaxWidth = 256;
+inline constexpr int kMaxPrecision = 32;
+
+/**
+ * Format string literal usable as a template argument
+ */
+template <size_t N>
+struct FixedString {
+  char chars[N]{};
+
+  constexpr FixedString(const char (&text)[N]) {  // NOLINT: implicit by design
+    for (size_t i = 0; i < N; ++i) {
+      chars[i] = text[i];
+    }
+  }
+
+  static constexpr size_t size() {
+    return N - 1;
+  }
+};
+
+struct Result {
+  size_t size = 0;      // bytes written to the buffer
+  size_t required = 0;  // bytes the complete output needs
+
+  [[nodiscard]] bool truncated() const noexcept {
+    return required > size;
+  }
+};
+
+namespace detail {
+
+// Deliberately not constexpr: reaching it during constant evaluation is a
+// compile error that quotes the message
+void formatStringError(const char* message);
+
+struct Spec {
+  char fill = ' ';
+  char align = '\0';  // '<', '>', '^' or '\0' for the type's default
+  char sign = '-';    // '-', '+' or ' '
+  bool alternate = false;
+  bool zero_pad = false;
+  int width = 0;
+  int precision = -1;
+  char type = '\0';
+};
+
+template <size_t N>
+struct Compiled {
+  char text[N]{};                 // literal text with {{ and }} unescaped
+  size_t literal_begin[N]{};      // literal i precedes field i; the last
+  size_t literal_length[N]{};     // one (index `fields`) is the tail
+  Spec specs[N]{};
+  size_t fields = 0;
+};
+
+enum class Category { kBool, kChar, kSigned, kUnsigned, kFloat, kString };
+
+template <typename T>
+consteval Category categoryOf() {
+  using U = std::remove_cv_t<std::remove_reference_t<T>>;
+  if constexpr (std::is_same_v<U, bool>) {
+    return Category::kBool;
+  } else if constexpr (std::is_same_v<U, char>) {
+    return Category::kChar;
+  } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+    return Category::kSigned;
+  } else if constexpr (std::is_integral_v<U>) {
+    return Category::kUnsigned;
+  } else if constexpr (std::is_floating_point_v<U>) {
+    return Category::kFloat;
+  } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+    return Category::kString;
+  } else {
+    formatStringError("argument type is not formattable");
+    return Category::kString;
+  }
+}
+
+consteval bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+consteval bool contains(const char* set, char c) {
+  for (; *set != '\0'; ++set) {
+    if (*set == c) {
+      return true;
+    }
+  }
+  return false;
+}
+
+consteval int parseNumber(const char* s, size_t& i, size_t n, int limit, const char* too_large) {
+  int value = 0;
+  while (i < n && isDigit(s[i])) {
+    value = value * 10 + (s[i] - '0');
+    if (value > limit) {
+      formatStringError(too_large);
+    }
+    ++i;
+  }
+  return value;
+}
+
+// s[i] is just past the opening '{'; returns the index just past '}'
+consteval size_t parseSpec(const char* s, size_t i, size_t n, Spec& spec) {
+  if (i < n && s[i] == '}') {
+    return i + 1;
+  }
+  if (i < n && isDigit(s[i])) {
+    formatStringError("explicit argument indexes are not supported");
+  }
+  if (i >= n || s[i] != ':') {
+    formatStringError("expected ':' or '}' in replacement field");
+  }
+  ++i;
+  if (i + 1 < n && contains("<>^", s[i + 1]) && s[i] != '{' && s[i] != '}') {
+    spec.fill = s[i];
+    spec.align = s[i + 1];
+    i += 2;
+  } else if (i < n && contains("<>^", s[i])) {
+    spec.align = s[i++];
+  }
+  if (i < n && contains("+- ", s[i])) {
+    spec.sign = s[i++];
+  }
+  if (i < n && s[i] == '#') {
+    spec.alternate = true;
+    ++i;
+  }
+  if (i < n && s[i] == '0') {
+    spec.zero_pad = spec.align == '\0';
+    ++i;
+  }
+  if (i < n && s[i] == '{') {
+    formatStringError("dynamic width is not supported: widths are compile-time constants");
+  }
+  spec.width = parseNumber(s, i, n, kMaxWidth, "width exceeds kMaxWidth");
+  if (i < n && s[i] == '.') {
+    ++i;
+    if (i < n && s[i] == '{') {
+      formatStringError("dynamic precision is not supported: precisions are compile-time constants");
+    }
+    if (i >= n || !isDigit(s[i])) {
+      formatStringError("missing precision after '.'");
+    }
+    spec.precision = parseNumber(s, i, n, kMaxPrecision, "precision exceeds kMaxPrecision");
+  }
+  if (i < n && s[i] != '}') {
+    if (!contains("bcdoxXsfFeEgG", s[i])) {
+      formatStringError("unknown presentation type");
+    }
+    spec.type = s[i++];
+  }
+  if (i >= n || s[i] != '}') {
+    formatStringError("missing '}' or invalid format spec");
+  }
+  return i + 1;
+}
+
+consteval void checkSpec(const Spec& spec, Category category) {
+  const bool integer_type = contains("bcdoxX", spec.type);
+  switch (category) {
+    case Category::kSigned:
+    case Category::kUnsigned:
+      if (spec.type != '\0' && !integer_type) {
+        formatStringError("invalid presentation type for an integer");
+      }
+      if (spec.precision >= 0) {
+        formatStringError("precision is not allowed for integers");
+      }
+      break;
+    case Category::kBool:
+    case Category::kChar:
+      if (spec.type != '\0' && spec.type != 's' && !integer_type) {
+        formatStringError("invalid presentation type for bool/char");
+      }
+      if (spec.precision >= 0) {
+        formatStringError("precision is not allowed for bool/char");
+      }
+      if ((spec.type == '\0' || spec.type == 's' || (category == Category::kChar && spec.type == 'c')) &&
+          (spec.sign != '-' || spec.alternate || spec.zero_pad)) {
+        formatStringError("sign, '#' and '0' need a numeric presentation");
+      }
+      break;
+    case Category::kFloat:
+      if (spec.type != '\0' && !contains("fFeEgG", spec.type)) {
+        formatStringError("invalid presentation type for a floating-point value");
+      }
+      if (spec.alternate) {
+        formatStringError("'#' is not supported for floating-point values");
+      }
+      break;
+    case Category::kString:
+      if (spec.type != '\0' && spec.type != 's') {
+        formatStringError("invalid presentation type for a string");
+      }
+      if (spec.sign != '-' || spec.alternate || spec.zero_pad) {
+        formatStringError("sign, '#' and '0' are not allowed for strings");
+      }
+      break;
+  }
+}
+
+template <FixedString F, Category... Categories>
+consteval auto compile() {
+  constexpr size_t kSize = sizeof(F.chars);
+  Compiled<kSize> out;
+  const char* s = F.chars;
+  const size_t n = F.size();
+  size_t text = 0;
+  size_t literal_start = 0;
+  size_t i = 0;
+  while (i < n) {
+    const char c = s[i];
+    if (c == '{' && i + 1 < n && s[i + 1] == '{') {
+      out.text[text++] = '{';
+      i += 2;
+    } else if (c == '{') {
+      if (out.fields == sizeof...(Categories)) {
+        formatStringError("more replacement fields than arguments");
+      }
+      out.literal_begin[out.fields] = literal_start;
+      out.literal_length[out.fields] = text - literal_start;
+      i = parseSpec(s, i + 1, n, out.specs[out.fields]);
+      ++out.fields;
+      literal_start = text;
+    } else if (c == '}' && i + 1 < n && s[i + 1] == '}') {
+      out.text[text++] = '}';
+      i += 2;
+    } else if (c == '}') {
+      formatStringError("unmatched '}' in format string");
+    } else {
+      out.text[text++] = c;
+      ++i;
+    }
+  }
+  out.literal_begin[out.fields] = literal_start;
+  out.literal_length[out.fields] = text - literal_start;
+  if (out.fields != sizeof...(Categories)) {
+    formatStringError("fewer replacement fields than arguments");
+  }
+  const Category categories[] = {Categories..., Category::kString};
+  for (size_t f = 0; f < out.fields; ++f) {
+    checkSpec(out.specs[f], categories[f]);
+  }
+  return out;
+}
+
+template <FixedString F, typename... Args>
+inline constexpr auto kCompiled = compile<F, categoryOf<Args>()...>();
+
+class Writer {
+ public:
+  Writer(char* buffer, size_t capacity) noexcept : begin_(buffer), pos_(buffer), end_(buffer + capacity) {}
+
+  void put(const char* data, size_t size) noexcept {
+    const size_t room = static_cast<size_t>(end_ - pos_);
+    const size_t copy = size < room ? size : room;
+    std::memcpy(pos_, data, copy);
+    pos_ += copy;
+    required_ += size;
+  }
+
+  void fill(char c, size_t count) noexcept {
+    const size_t room = static_cast<size_t>(end_ - pos_);
+    const size_t copy = count < room ? count : room;
+    std::memset(pos_, c, copy);
+    pos_ += copy;
+    required_ += count;
+  }
+
+  [[nodiscard]] Result result() const noexcept {
+    return Result{static_cast<size_t>(pos_ - begin_), required_};
+  }
+
+ private:
+  char* begin_;
+  char* pos_;
+  char* end_;
+  size_t required_ = 0;
+};
+
+// Writes prefix (sign / 0x) and body padded to the spec's width. Numbers
+// default to right alignment and may zero-pad; text defaults to the left.
+template <Spec S>
+void writePadded(Writer& out, const char* prefix, size_t prefix_size, const char* body, size_t body_size, bool number, bool zero_ok) {
+  const size_t total = prefix_size + body_size;
+  const size_t pad = static_cast<size_t>(S.width) > total ? static_cast<size_t>(S.width) - total : 0;
+  if (S.zero_pad && zero_ok) {
+    out.put(prefix, prefix_size);
+    out.fill('0', pad);
+    out.put(body, body_size);
+    return;
+  }
+  const char align = S.align != '\0' ? S.align : (number ? '>' : '<');
+  const size_t before = align == '>' ? pad : (align == '^' ? pad / 2 : 0);
+  out.fill(S.fill, before);
+  out.put(prefix, prefix_size);
+  out.put(body, body_size);
+  out.fill(S.fill, pad - before);
+}
+
+inline void toUpper(char* begin, char* end) noexcept {
+  for (; begin != end; ++begin) {
+    if (*begin >= 'a' && *begin <= 'z') {
+      *begin = static_cast<char>(*begin - 'a' + 'A');
+    }
+  }
+}
+
+template <Spec S>
+void writeInteger(Writer& out, bool negative, unsigned long long magnitude) {
+  char prefix[3];
+  size_t prefix_size = 0;
+  if (negative) {
+    prefix[prefix_size++] = '-';
+  } else if constexpr (S.sign == '+' || S.sign == ' ') {
+    prefix[prefix_size++] = S.sign;
+  }
+  constexpr int kBase = S.type == 'x' || S.type == 'X' ? 16 : S.type == 'b' ? 2 : S.type == 'o' ? 8 : 10;
+  if constexpr (S.alternate && kBase != 10) {
+    prefix[prefix_size++] = '0';
+    if constexpr (kBase != 8) {
+      prefix[prefix_size++] = S.type;
+    }
+  }
+  char digits[64];
+  char* end = std::to_chars(digits, digits + sizeof(digits), magnitude, kBase).ptr;
+  if constexpr (S.type == 'X') {
+    toUpper(digits, end);
+  }
+  writePadded<S>(out, prefix, prefix_size, digits, static_cast<size_t>(end - digits), true, true);
+}
+
+template <Spec S, typename T>
+void writeArg(Writer& out, const T& value) {
+  constexpr Category kCategory = categoryOf<T>();
+  if constexpr (kCategory == Category::kString) {
+    const std::string_view text(value);
+    const size_t size = S.precision >= 0 && text.size() > static_cast<size_t>(S.precision) ? static_cast<size_t>(S.precision) : text.size();
+    writePadded<S>(out, "", 0, text.data(), size, false, false);
+  } else if constexpr (kCategory == Category::kBool && (S.type == '\0' || S.type == 's')) {
+    writePadded<S>(out, "", 0, value ? "true" : "false", value ? 4 : 5, false, false);
+  } else if constexpr (S.type == 'c' || (kCategory == Category::kChar && S.type == '\0')) {
+    const char c = static_cast<char>(value);
+    writePadded<S>(out, "", 0, &c, 1, false, false);
+  } else if constexpr (kCategory == Category::kFloat) {
+    // Fixed notation of the type's largest value with kMaxPrecision digits
+    // (about 350 bytes for double, 5 KiB for x87 long double)
+    constexpr size_t kBodySize = std::numeric_limits<T>::max_exponent10 + kMaxPrecision + 8;
+    char body[kBodySize];
+    std::to_chars_result converted;
+    constexpr char kType = S.type | 0x20;  // lower-case
+    if constexpr (S.type == '\0' && S.precision < 0) {
+      converted = std::to_chars(body, body + sizeof(body), value);
+    } else {
+      constexpr auto kFormat = kType == 'f' ? std::chars_format::fixed : kType == 'e' ? std::chars_format::scientific : std::chars_format::general;
+      constexpr int kPrecision = S.precision >= 0 ? S.precision : 6;
+      converted = std::to_chars(body, body + sizeof(body), value, kFormat, kPrecision);
+    }
+    char* begin = body;
+    char* end = converted.ec == std::errc{} ? converted.ptr : body;  // never copy bytes to_chars did not write
+    if (begin == end) {
+      writePadded<S>(out, "", 0, "?", 1, false, false);
+      return;
+    }
+    if constexpr (S.type == 'F' || S.type == 'E' || S.type == 'G') {
+      toUpper(begin, end);
+    }
+    char prefix[1];
+    size_t prefix_size = 0;
+    if (*begin == '-') {
+      prefix[prefix_size++] = '-';
+      ++begin;
+    } else if constexpr (S.sign == '+' || S.sign == ' ') {
+      prefix[prefix_size++] = S.sign;
+    }
+    writePadded<S>(out, prefix, prefix_size, begin, static_cast<size_t>(end - begin), true, std::isfinite(value));
+  } else if constexpr (std::is_signed_v<T>) {
+    const auto wide = static_cast<long long>(value);
+    const bool negative = wide < 0;
+    const unsigned long long magnitude = negative ? 0ull - static_cast<unsigned long long>(wide) : static_cast<unsigned long long>(wide);
+    writeInteger<S>(out, negative, magnitude);
+  } else {
+    writeInteger<S>(out, false, static_cast<unsigned long long>(value));
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Formats args into buffer[0, capacity); never writes past capacity and
+ * does not NUL-terminate
+ */
+template <FixedString F, typename... Args>
+Result formatTo(char* buffer, size_t capacity, const Args&... args) {
+  constexpr const auto& kFormat = detail::kCompiled<F, Args...>;
+  detail::Writer out(buffer, capacity);
+  const auto values = std::forward_as_tuple(args...);
+  [&]<size_t... I>(std::index_sequence<I...>) {
+    ((out.put(kFormat.text + kFormat.literal_begin[I], kFormat.literal_length[I]), detail::writeArg<kFormat.specs[I]>(out, std::get<I>(values))), ...);
+  }(std::index_sequence_for<Args...>{});
+  out.put(kFormat.text + kFormat.literal_begin[sizeof...(Args)], kFormat.literal_length[sizeof...(Args)]);
+  return out.result();
+}
+
+/**
+ * Formats into a stack buffer and hands the bytes to os.write(), so the
+ * stream's flags, width and precision play no part in the output
+ */
+template <FixedString F, typename... Args>
+std::ostream& print(std::ostream& os, const Args&... args) {
+  char line[256];
+  const Result result = formatTo<F>(line, sizeof(line), args...);
+  if (!result.truncated()) {
+    return os.write(line, static_cast<std::streamsize>(result.size));
+  }
+  std::string longer(result.required, '\0');
+  formatTo<F>(longer.data(), longer.size(), args...);
+  return os.write(longer.data(), static_cast<std::streamsize>(longer.size()));
+}
+
+}  // namespace csc450::fmt
+
+#endif  // CSC450_MODULE4_PERF_FORMAT_H_
@@ -0,0 +1,141 @@
+/**
+ * Compile-time formatter vs iostream formatting
+ *
+ * Formats the same account line, "Account: <n> Balance: <x.xx> Id: 0X<hex>",
+ * per operation with:
+ *   cout_save_restore  std::cout << with std::fixed / setprecision / hex /
+ *                      uppercase, saving and restoring flags and precision
+ *                      around each line (the "safe" pattern in the post)
+ *   snprintf           C formatting into a stack buffer
+ *   fmt_format_to      csc450::fmt::formatTo into a stack buffer, then
+ *                      written to the same stream buffer
+ *   fmt_print          csc450::fmt::print(std::cout, ...)
+ *
+ * std::cout's buffer is swapped for a discarding one while timing, so the
+ * numbers are formatting cost only. The outputs are checked to be equal.
+ *
+ * Usage: format_bench [--min-time SECONDS]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+
+#include "bench_util.h"
+#include "format.h"
+
+namespace {
+
+class DiscardStreambuf : public std::streambuf {
+ protected:
+  int_type overflow(int_type c) override {
+    return traits_type::not_eof(c);
+  }
+  std::streamsize xsputn(const char*, std::streamsize count) override {
+    return count;
+  }
+};
+
+struct Account {
+  int number;
+  double balance;
+  unsigned id;
+};
+
+// Ids are never 0: showbase prints plain "0" there, std::format-style {:#X} prints "0X0"
+Account accountAt(uint64_t i) {
+  return Account{static_cast<int>(10000 + i % 90000), static_cast<double>(i % 1000003) * 1.37, static_cast<unsigned>(i * 2654435761u) | 0x100u};
+}
+
+void streamLine(std::ostream& os, const Account& account) {
+  const std::ios_base::fmtflags saved_flags = os.flags();
+  const std::streamsize saved_precision = os.precision();
+  os << "Account: " << account.number << " Balance: " << std::fixed << std::setprecision(2) << account.balance << " Id: " << std::showbase << std::hex
+     << std::uppercase << account.id << '\n';
+  os.flags(saved_flags);
+  os.precision(saved_precision);
+}
+
+csc450::fmt::Result formatLine(char* buffer, size_t capacity, const Account& account) {
+  return csc450::fmt::formatTo<"Account: {} Balance: {:.2f} Id: {:#X}\n">(buffer, capacity, account.number, account.balance, account.id);
+}
+
+// Formats the first `count` lines both ways and compares
+bool outputsMatch(uint64_t count) {
+  std::ostringstream expected;
+  std::string actual;
+  for (uint64_t i = 0; i < count; ++i) {
+    const Account account = accountAt(i);
+    streamLine(expected, account);
+    char line[128];
+    const auto result = formatLine(line, sizeof(line), account);
+    actual.append(line, result.size);
+  }
+  return expected.str() == actual;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    double min_time = 0.1;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--min-time SECONDS]\n";
+        return EXIT_FAILURE;
+      }
+    }
+
+    const bool match = outputsMatch(100000);
+
+    DiscardStreambuf discard;
+    std::streambuf* const original = std::cout.rdbuf(&discard);
+    uint64_t i = 0;
+    const double cout_ns = csc450::bench::nsPerOp([&] { streamLine(std::cout, accountAt(i++)); }, min_time);
+    const double snprintf_ns = csc450::bench::nsPerOp([&] {
+      const Account account = accountAt(i++);
+      char line[128];
+      const int size = std::snprintf(line, sizeof(line), "Account: %d Balance: %.2f Id: %#X\n", account.number, account.balance, account.id);
+      std::cout.rdbuf()->sputn(line, size);
+    }, min_time);
+    const double format_to_ns = csc450::bench::nsPerOp([&] {
+      char line[128];
+      const auto result = formatLine(line, sizeof(line), accountAt(i++));
+      std::cout.rdbuf()->sputn(line, static_cast<std::streamsize>(result.size));
+    }, min_time);
+    const double print_ns = csc450::bench::nsPerOp([&] {
+      const Account account = accountAt(i++);
+      csc450::fmt::print<"Account: {} Balance: {:.2f} Id: {:#X}\n">(std::cout, account.number, account.balance, account.id);
+    }, min_time);
+    std::cout.rdbuf(original);
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "compile_time_formatter");
+    json.field("outputs_match", match);
+    json.key("results").beginArray();
+    const auto row = [&](const char* method, double ns) {
+      json.beginObject().field("method", method).field("ns_per_line", ns).field("speedup_vs_cout", cout_ns / ns).endObject();
+    };
+    row("cout_save_restore", cout_ns);
+    row("snprintf", snprintf_ns);
+    row("fmt_format_to", format_to_ns);
+    row("fmt_print", print_ns);
+    json.endArray();
+    json.endObject();
+    std::cout << '\n';
+    return match ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "format_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,290 @@
+/**
+ * Per-thread formatting contexts feeding a shared line-atomic sink
+ *
+ * The Module 4 demos switch std::cout to hex/uppercase/setprecision and
+ * then restore it. That state belongs to one global object, so with more
+ * than one writer the save/restore pairs interleave and every formatted
+ * field has to hold a lock around the stream.
+ *
+ * FormatContext carries its own radix, case, precision, width and fill,
+ * and formats into a buffer owned by one thread, so formatting touches no
+ * shared state and takes no lock. Completed lines are handed to a LineSink
+ * in batches; the sink appends each batch under a short lock, so lines
+ * from different threads never interleave, and writes whole buffers to
+ * its file descriptor.
+ *
+ *     csc450::LineSink sink(STDOUT_FILENO);
+ *     // on each thread:
+ *     csc450::FormatContext out(sink);
+ *     out.radix(16).uppercase(true) << "id=" << id;
+ *     out.endLine();
+ *
+ * Width applies to the next field only, as with std::setw. Precision and
+ * width are clamped (floatfmt limits, kMaxFieldWidth) because a line is
+ * buffered whole before it is committed. Character types follow
+ * std::ostream: char, signed char and unsigned char (so also uint8_t)
+ * print as characters, and wchar_t, char8_t, char16_t and char32_t are
+ * rejected at compile time rather than printed as numbers.
+ */
+
+#ifndef CSC450_MODULE4_PERF_FORMAT_CONTEXT_H_
+#define CSC450_MODULE4_PERF_FORMAT_CONTEXT_H_
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include "float_format.h"
+#include "posix_io.h"
+
+namespace csc450 {
+
+/**
+ * Shared output; accepts only complete lines
+ */
+class LineSink {
+ public:
+  explicit LineSink(int fd, size_t buffer_size = 64 * 1024) : fd_(fd), capacity_(buffer_size) {
+    buffer_.reserve(capacity_);
+  }
+
+  ~LineSink() {
+    try {
+      flush();
+    } catch (...) {  // nothing sensible to report from a destructor
+    }
+  }
+
+  LineSink(const LineSink&) = delete;
+  LineSink& operator=(const LineSink&) = delete;
+
+  /**
+   * Appends one or more complete lines as a unit
+   */
+  void commit(std::string_view lines) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (buffer_.size() + lines.size() > capacity_) {
+      flushLocked();
+      if (lines.size() >= capacity_) {
+        writeAll(lines.data(), lines.size());
+        return;
+      }
+    }
+    buffer_.append(lines);
+  }
+
+  void flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flushLocked();
+  }
+
+ private:
+  void flushLocked() {
+    writeAll(buffer_.data(), buffer_.size());
+    buffer_.clear();
+  }
+
+  void writeAll(const char* data, size_t size) {
+    io::writeAllOrThrow(fd_, data, size);
+  }
+
+  int fd_;
+  size_t capacity_;
+  std::mutex mutex_;
+  std::string buffer_;  // guarded by mutex_
+};
+
+/**
+ * One thread's formatting state and pending lines; not shared
+ */
+class FormatContext {
+  template <typename T>
+  static constexpr bool kCharacter = std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char> ||
+                                     std::is_same_v<T, wchar_t> || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>
+#if defined(__cpp_char8_t)
+                                     || std::is_same_v<T, char8_t>
+#endif
+      ;
+
+ public:
+  static constexpr size_t kMaxFieldWidth = 64 * 1024;
+  static constexpr size_t kBatchBytes = 4096;
+
+  explicit FormatContext(LineSink& sink) : sink_(sink) {
+    pending_.reserve(kBatchBytes * 2);
+  }
+
+  ~FormatContext() {
+    try {
+      flush();
+    } catch (...) {  // nothing sensible to report from a destructor
+    }
+  }
+
+  FormatContext(const FormatContext&) = delete;
+  FormatContext& operator=(const FormatContext&) = delete;
+
+  // Integer radix, 2..36 (clamped)
+  FormatContext& radix(int base) noexcept {
+    radix_ = std::clamp(base, 2, 36);
+    return *this;
+  }
+  FormatContext& uppercase(bool on) noexcept {
+    uppercase_ = on;
+    return *this;
+  }
+  // Significant digits, or digits after the point when fixed(true)
+  FormatContext& precision(int digits) noexcept {
+    precision_ = digits;
+    return *this;
+  }
+  FormatContext& fixed(bool on) noexcept {
+    fixed_ = on;
+    return *this;
+  }
+  // Minimum width of the next field only
+  FormatContext& width(size_t columns) noexcept {
+    width_ = std::min(columns, kMaxFieldWidth);
+    return *this;
+  }
+  FormatContext& fill(char c) noexcept {
+    fill_ = c;
+    return *this;
+  }
+
+  FormatContext& operator<<(std::string_view text) {
+    field(text);
+    return *this;
+  }
+
+  FormatContext& operator<<(const char* text) {
+    return *this << std::string_view(text);
+  }
+
+  FormatContext& operator<<(char c) {
+    field(std::string_view(&c, 1));
+    return *this;
+  }
+  FormatContext& operator<<(signed char c) {
+    return *this << static_cast<char>(c);
+  }
+  FormatContext& operator<<(unsigned char c) {
+    return *this << static_cast<char>(c);
+  }
+  // Deleted for std::ostream in C++20 too
+  FormatContext& operator<<(wchar_t) = delete;
+  FormatContext& operator<<(char16_t) = delete;
+  FormatContext& operator<<(char32_t) = delete;
+#if defined(__cpp_char8_t)
+  FormatContext& operator<<(char8_t) = delete;
+#endif
+
+  template <typename T, std::enable_if_t<std::is_integral_v<T> && !kCharacter<T> && !std::is_same_v<T, bool>, int> = 0>
+  FormatContext& operator<<(T value) {
+    char digits[std::numeric_limits<T>::digits + 2];  // every bit in radix 2, plus a sign
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value, radix_);
+    char* end = result.ec == std::errc() ? result.ptr : digits;  // never copy bytes to_chars did not write
+    if (uppercase_) {
+      for (char* p = digits; p != end; ++p) {
+        if (*p >= 'a' && *p <= 'z') {
+          *p = static_cast<char>(*p - 'a' + 'A');
+        }
+      }
+    }
+    field(std::string_view(digits, static_cast<size_t>(end - digits)));
+    return *this;
+  }
+
+  FormatContext& operator<<(bool value) {
+    field(value ? "true" : "false");
+    return *this;
+  }
+
+  FormatContext& operator<<(double value) {
+    char text[floatfmt::kBufferSize];
+    const size_t size = fixed_ ? floatfmt::writeFixed(text, sizeof(text), value, precision_)
+                               : floatfmt::writeSignificant(text, sizeof(text), value, precision_);
+    floatField(text, size);
+    return *this;
+  }
+
+  // As std::ostream: without it, 1.0L is ambiguous between double and the integral overloads
+  FormatContext& operator<<(long double value) {
+    using limits = std::numeric_limits<long double>;
+    char text[1 + (limits::max_exponent10 + 1) + 1 + limits::max_digits10];  // fixed -LDBL_MAX
+    const auto format = fixed_ ? std::chars_format::fixed : std::chars_format::general;
+    const auto result = std::to_chars(text, text + sizeof(text), value, format, std::clamp(precision_, fixed_ ? 0 : 1, limits::max_digits10));
+    floatField(text, result.ec == std::errc() ? static_cast<size_t>(result.ptr - text) : 0);
+    return *this;
+  }
+
+  /**
+   * Completes the current line; it is committed with the next batch
+   */
+  void endLine() {
+    pending_.push_back('\n');
+    line_start_ = pending_.size();
+    if (line_start_ >= kBatchBytes) {
+      commitLines();
+    }
+  }
+
+  /**
+   * Commits every completed line now (a partial line stays pending)
+   */
+  void flush() {
+    commitLines();
+  }
+
+ private:
+  void field(std::string_view text) {
+    if (width_ > text.size()) {
+      pending_.append(width_ - text.size(), fill_);
+    }
+    pending_.append(text);
+    width_ = 0;
+  }
+
+  void floatField(char* text, size_t size) {
+    if (uppercase_) {
+      for (size_t i = 0; i < size; ++i) {
+        if (text[i] >= 'a' && text[i] <= 'z') {
+          text[i] = static_cast<char>(text[i] - 'a' + 'A');
+        }
+      }
+    }
+    field(std::string_view(text, size));
+  }
+
+  void commitLines() {
+    if (line_start_ == 0) {
+      return;
+    }
+    sink_.commit(std::string_view(pending_.data(), line_start_));
+    pending_.erase(0, line_start_);
+    line_start_ = 0;
+  }
+
+  LineSink& sink_;
+  std::string pending_;
+  size_t line_start_ = 0;  // end of the last completed line in pending_
+  int radix_ = 10;
+  bool uppercase_ = false;
+  bool fixed_ = false;
+  int precision_ = 6;
+  size_t width_ = 0;
+  char fill_ = ' ';
+};
+
+}  // namespace csc450
+
+#endif  // CSC450_MODULE4_PERF_FORMAT_CONTEXT_H_
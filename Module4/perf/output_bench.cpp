@@ -0,0 +1,453 @@
+/**
+ * Output formatting suite: iostream vs printf vs to_chars vs std::format
+ *
+ * Writes one line per operation for each workload
+ *   int                non-negative int, decimal
+ *   hex_int            the same values as unsigned hex
+ *   double_fixed_2     %.2f / std::fixed << setprecision(2)
+ *   double_general_6   %.6g / default float format, setprecision(6)
+ *   double_general_17  %.17g (round-trip precision)
+ *   padded_string_24   a short name right-aligned in 24 columns
+ * through each method
+ *   cout_sync          std::cout, synchronized with stdio (the default)
+ *   cout_unsync        std::cout after std::ios::sync_with_stdio(false)
+ *   printf             std::printf to stdout
+ *   to_chars           std::to_chars into a 64 KiB buffer written with write()
+ *   std_format         std::format_to_n into the same buffer (null when the
+ *                      standard library has no <format>)
+ *   csc450_fmt         csc450::fmt::formatTo into the same buffer
+ * with file descriptor 1 pointed at /dev/null and then at a temporary file,
+ * so every method pays for the same sink. Before timing, 1000 lines from
+ * each method are captured and compared with printf's output.
+ *
+ * The unsynchronized runs come last because sync_with_stdio(false) cannot be
+ * undone.
+ *
+ * Usage: output_bench [--min-time SECONDS]
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <version>
+
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+#include "bench_util.h"
+#include "format.h"
+#include "posix_io.h"
+
+namespace {
+
+enum Workload { kInt, kHex, kFixed2, kGeneral6, kGeneral17, kPadded, kWorkloads };
+enum Method { kCoutSync, kCoutUnsync, kPrintf, kToChars, kStdFormat, kCsc450Fmt, kMethods };
+enum SinkKind { kNullSink, kFileSink, kSinks };
+
+const char* const kWorkloadNames[kWorkloads] = {"int", "hex_int", "double_fixed_2", "double_general_6", "double_general_17", "padded_string_24"};
+const char* const kMethodNames[kMethods] = {"cout_sync", "cout_unsync", "printf", "to_chars", "std_format", "csc450_fmt"};
+const char* const kSinkNames[kSinks] = {"null", "file"};
+
+constexpr size_t kValues = 4096;  // power of two, indexed with kMask
+constexpr size_t kMask = kValues - 1;
+constexpr size_t kPadWidth = 24;
+constexpr size_t kCheckLines = 1000;
+
+struct Inputs {
+  std::vector<int> ints;
+  std::vector<double> doubles;
+  std::vector<const char*> names;
+};
+
+Inputs makeInputs() {
+  static const char* const kNames[] = {"Alice", "Bob", "Carol Ann", "Dmitri", "Eve", "Fatima Zahra", "Gus", "Hiroshi"};
+  Inputs in;
+  uint32_t state = 2463534242u;
+  for (size_t i = 0; i < kValues; ++i) {
+    state = state * 1664525u + 1013904223u;
+    // Spread magnitudes so digit counts vary the way real data does
+    in.ints.push_back(static_cast<int>(state >> (1 + state % 24)));
+    in.doubles.push_back(static_cast<double>(state % 100000000) / std::pow(10.0, static_cast<double>(state % 7)));
+    in.names.push_back(kNames[(state >> 16) % std::size(kNames)]);
+  }
+  return in;
+}
+
+/**
+ * Caller-managed output buffer for the buffer-based methods; drains to fd 1
+ */
+class FdBuffer {
+ public:
+  static constexpr size_t kCapacity = 64 * 1024;
+  static constexpr size_t kMaxLine = 128;
+
+  FdBuffer() : data_(std::make_unique<char[]>(kCapacity)) {}
+
+  // Returns room for at least kMaxLine bytes
+  char* claim() {
+    if (size_ + kMaxLine > kCapacity) {
+      flush();
+    }
+    return data_.get() + size_;
+  }
+
+  void commit(const char* end) {
+    size_ = static_cast<size_t>(end - data_.get());
+  }
+
+  void flush() {
+    csc450::io::writeAllOrThrow(STDOUT_FILENO, data_.get(), size_);
+    size_ = 0;
+  }
+
+ private:
+  std::unique_ptr<char[]> data_;
+  size_t size_ = 0;
+};
+
+/**
+ * Calls use(op) with a callable that writes the next line of workload w
+ * through method m; op never allocates per call except where the method does
+ */
+template <typename Use>
+void withOp(Method m, Workload w, const Inputs& in, FdBuffer& buffer, Use&& use) {
+  size_t i = 0;
+  const auto next = [&] { return i++ & kMask; };
+  switch (m) {
+    case kCoutSync:
+    case kCoutUnsync:
+      switch (w) {
+        case kInt:
+          return use([&] { std::cout << in.ints[next()] << '\n'; });
+        case kHex:
+          return use([&] { std::cout << std::hex << static_cast<unsigned>(in.ints[next()]) << std::dec << '\n'; });
+        case kFixed2:
+          return use([&] { std::cout << std::fixed << std::setprecision(2) << in.doubles[next()] << '\n'; });
+        case kGeneral6:
+          return use([&] { std::cout << std::defaultfloat << std::setprecision(6) << in.doubles[next()] << '\n'; });
+        case kGeneral17:
+          return use([&] { std::cout << std::defaultfloat << std::setprecision(17) << in.doubles[next()] << '\n'; });
+        case kPadded:
+          return use([&] { std::cout << std::setw(kPadWidth) << in.names[next()] << '\n'; });
+        default:
+          return;
+      }
+    case kPrintf:
+      switch (w) {
+        case kInt:
+          return use([&] { std::printf("%d\n", in.ints[next()]); });
+        case kHex:
+          return use([&] { std::printf("%x\n", static_cast<unsigned>(in.ints[next()])); });
+        case kFixed2:
+          return use([&] { std::printf("%.2f\n", in.doubles[next()]); });
+        case kGeneral6:
+          return use([&] { std::printf("%.6g\n", in.doubles[next()]); });
+        case kGeneral17:
+          return use([&] { std::printf("%.17g\n", in.doubles[next()]); });
+        case kPadded:
+          return use([&] { std::printf("%*s\n", static_cast<int>(kPadWidth), in.names[next()]); });
+        default:
+          return;
+      }
+    case kToChars: {
+      const auto line = [&](auto&& format) {
+        char* p = buffer.claim();
+        p = format(p, p + FdBuffer::kMaxLine - 1);
+        *p++ = '\n';
+        buffer.commit(p);
+      };
+      switch (w) {
+        case kInt:
+          return use([&] { line([&](char* p, char* end) { return std::to_chars(p, end, in.ints[next()]).ptr; }); });
+        case kHex:
+          return use([&] { line([&](char* p, char* end) { return std::to_chars(p, end, static_cast<unsigned>(in.ints[next()]), 16).ptr; }); });
+        case kFixed2:
+          return use([&] { line([&](char* p, char* end) { return std::to_chars(p, end, in.doubles[next()], std::chars_format::fixed, 2).ptr; }); });
+        case kGeneral6:
+          return use([&] { line([&](char* p, char* end) { return std::to_chars(p, end, in.doubles[next()], std::chars_format::general, 6).ptr; }); });
+        case kGeneral17:
+          return use([&] { line([&](char* p, char* end) { return std::to_chars(p, end, in.doubles[next()], std::chars_format::general, 17).ptr; }); });
+        case kPadded:
+          return use([&] {
+            line([&](char* p, char*) {
+              const char* name = in.names[next()];
+              const size_t size = std::strlen(name);
+              std::memset(p, ' ', kPadWidth - size);
+              std::memcpy(p + kPadWidth - size, name, size);
+              return p + kPadWidth;
+            });
+          });
+        default:
+          return;
+      }
+    }
+    case kStdFormat: {
+#if defined(__cpp_lib_format)
+      const auto line = [&](auto&& format) {
+        char* p = buffer.claim();
+        buffer.commit(format(p));
+      };
+      constexpr auto kMax = static_cast<std::ptrdiff_t>(FdBuffer::kMaxLine);
+      switch (w) {
+        case kInt:
+          return use([&] { line([&](char* p) { return std::format_to_n(p, kMax, "{}\n", in.ints[next()]).out; }); });
+        case kHex:
+          return use([&] { line([&](char* p) { return std::format_to_n(p, kMax, "{:x}\n", static_cast<unsigned>(in.ints[next()])).out; }); });
+        case kFixed2:
+          return use([&] { line([&](char* p) { return std::format_to_n(p, kMax, "{:.2f}\n", in.doubles[next()]).out; }); });
+        case kGeneral6:
+          return use([&] { line([&](char* p) { return std::format_to_n(p, kMax, "{:.6g}\n", in.doubles[next()]).out; }); });
+        case kGeneral17:
+          return use([&] { line([&](char* p) { return std::format_to_n(p, kMax, "{:.17g}\n", in.doubles[next()]).out; }); });
+        case kPadded:
+          return use([&] { line([&](char* p) { return std::format_to_n(p, kMax, "{:>24}\n", in.names[next()]).out; }); });
+        default:
+          return;
+      }
+#else
+      return;  // no <format> in this standard library; reported as null
+#endif
+    }
+    case kCsc450Fmt: {
+      const auto line = [&](auto&& format) {
+        char* p = buffer.claim();
+        buffer.commit(p + format(p).size);
+      };
+      constexpr size_t kMax = FdBuffer::kMaxLine;
+      switch (w) {
+        case kInt:
+          return use([&] { line([&](char* p) { return csc450::fmt::formatTo<"{}\n">(p, kMax, in.ints[next()]); }); });
+        case kHex:
+          return use([&] { line([&](char* p) { return csc450::fmt::formatTo<"{:x}\n">(p, kMax, static_cast<unsigned>(in.ints[next()])); }); });
+        case kFixed2:
+          return use([&] { line([&](char* p) { return csc450::fmt::formatTo<"{:.2f}\n">(p, kMax, in.doubles[next()]); }); });
+        case kGeneral6:
+          return use([&] { line([&](char* p) { return csc450::fmt::formatTo<"{:.6g}\n">(p, kMax, in.doubles[next()]); }); });
+        case kGeneral17:
+          return use([&] { line([&](char* p) { return csc450::fmt::formatTo<"{:.17g}\n">(p, kMax, in.doubles[next()]); }); });
+        case kPadded:
+          return use([&] { line([&](char* p) { return csc450::fmt::formatTo<"{:>24}\n">(p, kMax, in.names[next()]); }); });
+        default:
+          return;
+      }
+    }
+    default:
+      return;
+  }
+}
+
+/**
+ * A destination for fd 1: /dev/null or a temporary file that is truncated
+ * between runs so it never grows past one measurement
+ */
+class Sink {
+ public:
+  explicit Sink(SinkKind kind) : kind_(kind) {
+    if (kind == kNullSink) {
+      fd_ = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    } else {
+      char path[] = "/tmp/output_bench_XXXXXX";
+      fd_ = ::mkstemp(path);
+      if (fd_ >= 0) {
+        ::unlink(path);
+      }
+    }
+    if (fd_ < 0) {
+      throw std::system_error(errno, std::generic_category(), "open sink");
+    }
+  }
+  ~Sink() {
+    ::close(fd_);
+  }
+  Sink(const Sink&) = delete;
+  Sink& operator=(const Sink&) = delete;
+
+  void reset() const {
+    if (kind_ == kFileSink && (::ftruncate(fd_, 0) != 0 || ::lseek(fd_, 0, SEEK_SET) != 0)) {
+      throw std::system_error(errno, std::generic_category(), "reset sink");
+    }
+  }
+
+  // File contents written so far (file sink only)
+  std::string contents() const {
+    std::string text(static_cast<size_t>(::lseek(fd_, 0, SEEK_CUR)), '\0');
+    if (::pread(fd_, text.data(), text.size(), 0) != static_cast<ssize_t>(text.size())) {
+      throw std::system_error(errno, std::generic_category(), "read sink");
+    }
+    return text;
+  }
+
+  [[nodiscard]] int fd() const noexcept {
+    return fd_;
+  }
+
+ private:
+  SinkKind kind_;
+  int fd_ = -1;
+};
+
+void flushAll(FdBuffer& buffer) {
+  std::cout.flush();
+  std::fflush(stdout);
+  buffer.flush();
+}
+
+/**
+ * Points fd 1 at a sink for the lifetime of the object
+ */
+class StdoutRedirect {
+ public:
+  StdoutRedirect(const Sink& sink, FdBuffer& buffer) : buffer_(buffer), saved_(::dup(STDOUT_FILENO)) {
+    flushAll(buffer_);
+    if (saved_ < 0 || ::dup2(sink.fd(), STDOUT_FILENO) < 0) {
+      throw std::system_error(errno, std::generic_category(), "redirect stdout");
+    }
+  }
+  ~StdoutRedirect() {
+    try {
+      flushAll(buffer_);
+    } catch (...) {  // nothing sensible to report from a destructor
+    }
+    ::dup2(saved_, STDOUT_FILENO);
+    ::close(saved_);
+  }
+  StdoutRedirect(const StdoutRedirect&) = delete;
+  StdoutRedirect& operator=(const StdoutRedirect&) = delete;
+
+ private:
+  FdBuffer& buffer_;
+  int saved_;
+};
+
+struct Results {
+  double ns[kSinks][kWorkloads][kMethods];
+  std::string output[kWorkloads][kMethods];  // first kCheckLines lines
+};
+
+void runMethod(Method m, const Inputs& in, const Sink (&sinks)[kSinks], double min_time, Results& results) {
+  FdBuffer buffer;
+  const std::ios_base::fmtflags saved_flags = std::cout.flags();
+  const std::streamsize saved_precision = std::cout.precision();
+  for (int w = 0; w < kWorkloads; ++w) {
+    const auto workload = static_cast<Workload>(w);
+    {
+      sinks[kFileSink].reset();
+      StdoutRedirect redirect(sinks[kFileSink], buffer);
+      withOp(m, workload, in, buffer, [](auto&& op) {
+        for (size_t n = 0; n < kCheckLines; ++n) {
+          op();
+        }
+      });
+    }
+    results.output[w][m] = sinks[kFileSink].contents();
+    for (int s = 0; s < kSinks; ++s) {
+      sinks[s].reset();
+      StdoutRedirect redirect(sinks[s], buffer);
+      withOp(m, workload, in, buffer, [&](auto&& op) { results.ns[s][w][m] = csc450::bench::nsPerOp(op, min_time); });
+    }
+    std::cout.flags(saved_flags);
+    std::cout.precision(saved_precision);
+  }
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    double min_time = 0.05;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--min-time SECONDS]\n";
+        return EXIT_FAILURE;
+      }
+    }
+
+    const Inputs in = makeInputs();
+    const Sink sinks[kSinks] = {Sink(kNullSink), Sink(kFileSink)};
+    auto results = std::make_unique<Results>();
+    for (auto& per_sink : results->ns) {
+      for (auto& per_workload : per_sink) {
+        std::fill(std::begin(per_workload), std::end(per_workload), std::numeric_limits<double>::quiet_NaN());
+      }
+    }
+
+    for (const Method m : {kPrintf, kCoutSync, kToChars, kStdFormat, kCsc450Fmt}) {
+      runMethod(m, in, sinks, min_time, *results);
+    }
+    std::ios::sync_with_stdio(false);
+    runMethod(kCoutUnsync, in, sinks, min_time, *results);
+
+    bool all_match = true;
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "output_formatting");
+    json.field("unit", "ns_per_line");
+    json.key("outputs_match").beginObject();
+    for (int w = 0; w < kWorkloads; ++w) {
+      json.key(kWorkloadNames[w]).beginObject();
+      for (int m = 0; m < kMethods; ++m) {
+        json.key(kMethodNames[m]);
+        if (results->output[w][m].empty()) {
+          json.null();
+        } else {
+          const bool match = results->output[w][m] == results->output[w][kPrintf];
+          all_match = all_match && match;
+          json.value(match);
+        }
+      }
+      json.endObject();
+    }
+    json.endObject();
+    json.key("results").beginArray();
+    for (int s = 0; s < kSinks; ++s) {
+      json.beginObject();
+      json.field("sink", kSinkNames[s]);
+      json.key("workloads").beginArray();
+      for (int w = 0; w < kWorkloads; ++w) {
+        json.beginObject();
+        json.field("workload", kWorkloadNames[w]);
+        for (int m = 0; m < kMethods; ++m) {
+          json.key(kMethodNames[m]);
+          const double ns = results->ns[s][w][m];
+          if (std::isnan(ns)) {
+            json.null();
+          } else {
+            json.value(ns);
+          }
+        }
+        json.endObject();
+      }
+      json.endArray();
+      json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    std::cout << '\n';
+    return all_match ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "output_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
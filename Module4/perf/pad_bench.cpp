@@ -0,0 +1,154 @@
+/**
+ * Padded output cost as a function of width
+ *
+ * Writes "test" right-aligned in fields from 16 B to 16 MiB with:
+ *   ostream_setw_string  stream << std::setw(w) << "test"
+ *   ostream_setw_int     stream << std::setw(w) << 42 (libstdc++ pads this
+ *                        through alloca(w), so it stops at 1 MiB)
+ *   temp_string          std::string of the padded field, then write()
+ *   pad_writev           csc450::pad::writePadded(fd, ...)
+ *   pad_ostream          csc450::pad::writePadded(stream, ...)
+ *   pad_into             csc450::pad::padInto into a preallocated buffer
+ * Stream methods write to a discarding streambuf and fd methods to
+ * /dev/null, so the numbers are the padding cost itself. A final 1 GiB
+ * field through pad_writev reports peak RSS growth.
+ *
+ * Usage: pad_bench [--min-time SECONDS]
+ */
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "bench_util.h"
+#include "padding.h"
+
+namespace {
+
+class DiscardStreambuf : public std::streambuf {
+ protected:
+  int_type overflow(int_type c) override {
+    return traits_type::not_eof(c);
+  }
+  std::streamsize xsputn(const char*, std::streamsize count) override {
+    return count;
+  }
+};
+
+long peakRssKb() {
+  rusage usage{};
+  ::getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+class NullFd {
+ public:
+  NullFd() : fd_(::open("/dev/null", O_WRONLY | O_CLOEXEC)) {
+    if (fd_ < 0) {
+      throw std::system_error(errno, std::generic_category(), "open /dev/null");
+    }
+  }
+  ~NullFd() {
+    ::close(fd_);
+  }
+  NullFd(const NullFd&) = delete;
+  NullFd& operator=(const NullFd&) = delete;
+
+  [[nodiscard]] int get() const noexcept {
+    return fd_;
+  }
+
+ private:
+  int fd_;
+};
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    double min_time = 0.05;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--min-time" && i + 1 < argc) {
+        min_time = std::strtod(argv[++i], nullptr);
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--min-time SECONDS]\n";
+        return EXIT_FAILURE;
+      }
+    }
+
+    const NullFd null_fd;
+    DiscardStreambuf discard;
+    std::ostream stream(&discard);
+    const std::vector<size_t> widths = {16, 256, 4096, 65536, size_t{1} << 20, size_t{16} << 20};
+    auto into_buffer = std::make_unique<char[]>(widths.back());
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "padding");
+    json.key("results").beginArray();
+    for (const size_t width : widths) {
+      const auto w = static_cast<std::streamsize>(width);
+      const auto row = [&](const char* method, double ns) {
+        json.beginObject();
+        json.field("method", method);
+        json.field("ns_per_call", ns);
+        json.field("ns_per_byte", ns / static_cast<double>(width));
+        json.endObject();
+      };
+
+      json.beginObject();
+      json.field("width", width);
+      json.key("methods").beginArray();
+      row("ostream_setw_string", csc450::bench::nsPerOp([&] { stream << std::setw(w) << "test"; }, min_time));
+      if (width <= (size_t{1} << 20)) {
+        row("ostream_setw_int", csc450::bench::nsPerOp([&] { stream << std::setw(w) << 42; }, min_time));
+      }
+      row("temp_string", csc450::bench::nsPerOp([&] {
+        std::string field(width - 4, ' ');
+        field += "test";
+        csc450::bench::doNotOptimize(::write(null_fd.get(), field.data(), field.size()));
+      }, min_time));
+      row("pad_writev", csc450::bench::nsPerOp([&] { csc450::pad::writePadded(null_fd.get(), "test", width); }, min_time));
+      row("pad_ostream", csc450::bench::nsPerOp([&] { csc450::pad::writePadded(stream, "test", width); }, min_time));
+      row("pad_into", csc450::bench::nsPerOp([&] {
+        csc450::pad::padInto(into_buffer.get(), width, "test", width);
+        csc450::bench::clobberMemory();
+      }, min_time));
+      json.endArray();
+      json.endObject();
+    }
+    json.endArray();
+
+    const size_t huge = csc450::pad::kMaxWidth;
+    const long before = peakRssKb();
+    const auto start = csc450::bench::Clock::now();
+    const size_t written = csc450::pad::writePadded(null_fd.get(), "test", huge);
+    const double seconds = csc450::bench::secondsSince(start);
+    json.key("max_width").beginObject();
+    json.field("width", huge);
+    json.field("bytes_written", written);
+    json.field("seconds", seconds);
+    json.field("peak_rss_growth_kb", static_cast<int64_t>(peakRssKb() - before));
+    json.endObject();
+    json.endObject();
+    std::cout << '\n';
+    return written == huge ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  } catch (const std::exception& e) {
+    std::cerr << "pad_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
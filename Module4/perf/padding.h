@@ -0,0 +1,228 @@
+/**
+ * Padded output at any width without width-sized temporaries
+ *
+ * The Module 4 code comments out std::setw(10000) as a memory/performance
+ * problem, and demonstrate_safe_precision() caps the width at 50. The cost
+ * is real: libstdc++ pads numbers through an alloca() of `width` bytes and
+ * pads strings one sputc() at a time, and the usual workaround of
+ * std::string(width, ' ') allocates the whole run.
+ *
+ * Here fill runs are never materialised. They are emitted as repeated
+ * slices of one 4 KiB page already holding the fill character (a constexpr
+ * page for ' ' and '0', a per-thread page for anything else):
+ * - to a file descriptor, as iovec entries gathered into writev() calls
+ * - to a std::ostream, as sputn() of page-sized slices
+ * - into a caller buffer, with memset
+ * Memory use is constant in the width, so user-supplied widths only need
+ * the generous kMaxWidth sanity cap rather than a low limit.
+ */
+
+#ifndef CSC450_MODULE4_PERF_PADDING_H_
+#define CSC450_MODULE4_PERF_PADDING_H_
+
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string_view>
+#include <system_error>
+
+namespace csc450::pad {
+
+enum class Align { kLeft, kRight, kCenter };
+
+inline constexpr size_t kPageSize = 4096;
+inline constexpr size_t kMaxWidth = size_t{1} << 30;
+
+namespace detail {
+
+template <char Fill>
+inline constexpr std::array<char, kPageSize> kStaticPage = [] {
+  std::array<char, kPageSize> page{};
+  for (char& c : page) {
+    c = Fill;
+  }
+  return page;
+}();
+
+/**
+ * A page of `fill` characters
+ */
+inline const char* fillPage(char fill) noexcept {
+  if (fill == ' ') {
+    return kStaticPage<' '>.data();
+  }
+  if (fill == '0') {
+    return kStaticPage<'0'>.data();
+  }
+  thread_local std::array<char, kPageSize> page;
+  thread_local char current = '\0';
+  thread_local bool ready = false;
+  if (!ready || current != fill) {
+    std::memset(page.data(), fill, page.size());
+    current = fill;
+    ready = true;
+  }
+  return page.data();
+}
+
+struct Split {
+  size_t left = 0;
+  size_t right = 0;
+};
+
+inline Split split(size_t text_size, size_t width, Align align) noexcept {
+  width = std::min(width, kMaxWidth);
+  const size_t pad = width > text_size ? width - text_size : 0;
+  switch (align) {
+    case Align::kLeft:
+      return Split{0, pad};
+    case Align::kCenter:
+      return Split{pad / 2, pad - pad / 2};
+    case Align::kRight:
+    default:
+      return Split{pad, 0};
+  }
+}
+
+/**
+ * Gathers slices into iovec batches and writes them with writev(),
+ * resuming after partial writes
+ */
+class GatherWriter {
+ public:
+  explicit GatherWriter(int fd) noexcept : fd_(fd) {}
+
+  void add(const char* data, size_t size) {
+    if (size == 0) {
+      return;
+    }
+    if (count_ == kBatch) {
+      flush();
+    }
+    iov_[count_++] = iovec{const_cast<char*>(data), size};
+  }
+
+  void addFill(const char* page, size_t size) {
+    while (size > 0) {
+      const size_t chunk = std::min(size, kPageSize);
+      add(page, chunk);
+      size -= chunk;
+    }
+  }
+
+  void flush() {
+    int first = 0;
+    while (first < count_) {
+      const ssize_t wrote = ::writev(fd_, iov_ + first, count_ - first);
+      if (wrote < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::system_error(errno, std::generic_category(), "writev");
+      }
+      written_ += static_cast<size_t>(wrote);
+      size_t left = static_cast<size_t>(wrote);
+      while (first < count_ && left >= iov_[first].iov_len) {
+        left -= iov_[first].iov_len;
+        ++first;
+      }
+      if (first < count_) {
+        iov_[first].iov_base = static_cast<char*>(iov_[first].iov_base) + left;
+        iov_[first].iov_len -= left;
+      }
+    }
+    count_ = 0;
+  }
+
+  [[nodiscard]] size_t written() const noexcept {
+    return written_;
+  }
+
+ private:
+  static constexpr int kBatch = 128;  // 512 KiB of fill per writev (IOV_MAX is 1024)
+  int fd_;
+  iovec iov_[kBatch];
+  int count_ = 0;
+  size_t written_ = 0;
+};
+
+}  // namespace detail
+
+/**
+ * Writes text padded to `width` to a file descriptor; returns the bytes
+ * written. Throws std::system_error on write failure.
+ */
+inline size_t writePadded(int fd, std::string_view text, size_t width, Align align = Align::kRight, char fill = ' ') {
+  const detail::Split pad = detail::split(text.size(), width, align);
+  const char* page = detail::fillPage(fill);
+  detail::GatherWriter out(fd);
+  out.addFill(page, pad.left);
+  out.add(text.data(), text.size());
+  out.addFill(page, pad.right);
+  out.flush();
+  return out.written();
+}
+
+/**
+ * Writes text padded to `width` to a stream's buffer. The stream's own
+ * width, fill and flags are neither used nor changed.
+ */
+inline std::ostream& writePadded(std::ostream& os, std::string_view text, size_t width, Align align = Align::kRight, char fill = ' ') {
+  const std::ostream::sentry ok(os);
+  if (!ok) {
+    return os;
+  }
+  const detail::Split pad = detail::split(text.size(), width, align);
+  const char* page = detail::fillPage(fill);
+  std::streambuf* buf = os.rdbuf();
+  bool good = true;
+  const auto putFill = [&](size_t size) {
+    while (good && size > 0) {
+      const size_t chunk = std::min(size, kPageSize);
+      good = buf->sputn(page, static_cast<std::streamsize>(chunk)) == static_cast<std::streamsize>(chunk);
+      size -= chunk;
+    }
+  };
+  putFill(pad.left);
+  good = good && buf->sputn(text.data(), static_cast<std::streamsize>(text.size())) == static_cast<std::streamsize>(text.size());
+  putFill(pad.right);
+  if (!good) {
+    os.setstate(std::ios_base::badbit);
+  }
+  return os;
+}
+
+/**
+ * Writes text padded to `width` into buffer[0, capacity); returns the size
+ * the padded text needs (output is cut at capacity)
+ */
+inline size_t padInto(char* buffer, size_t capacity, std::string_view text, size_t width, Align align = Align::kRight, char fill = ' ') noexcept {
+  const detail::Split pad = detail::split(text.size(), width, align);
+  const size_t required = pad.left + text.size() + pad.right;
+  size_t pos = 0;
+  const auto emit = [&](const char* data, size_t size, bool is_fill) {
+    const size_t copy = std::min(size, capacity - pos);
+    if (copy == 0) {
+      return;
+    }
+    if (is_fill) {
+      std::memset(buffer + pos, fill, copy);
+    } else {
+      std::memcpy(buffer + pos, data, copy);
+    }
+    pos += copy;
+  };
+  emit(nullptr, pad.left, true);
+  emit(text.data(), text.size(), false);
+  emit(nullptr, pad.right, true);
+  return required;
+}
+
+}  // namespace csc450::pad
+
+#endif  // CSC450_MODULE4_PERF_PADDING_H_
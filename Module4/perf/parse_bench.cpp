@@ -0,0 +1,172 @@
+/**
+ * Validated age parsing throughput over scripted input
+ *
+ * Builds a script of --lines age entries (mostly valid, plus negative,
+ * out-of-range, overflowing, non-numeric and "25abc"-style trailing
+ * garbage) and parses every line with:
+ *   istream_extract  std::istringstream >> int, then range check, with
+ *                    clear()/ignore() recovery as in the Module 4 demo
+ *   stoi             std::getline + std::stoi in try/catch
+ *   strtol           strtol with end-pointer and errno checks
+ *   bounded          csc450::parse::eachLine<0, 200> (bulk mode)
+ * reporting lines/sec and how many lines each accepted. istream_extract
+ * and stoi accept "25abc" as 25, so their counts are higher.
+ *
+ * Usage: parse_bench [--lines N]
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "bench_util.h"
+#include "parse_number.h"
+
+namespace {
+
+std::string makeScript(size_t lines) {
+  static const char* const kOdd[] = {"-5", "300", "99999999999", "abc", "25abc", "", "  42  ", "+17", "4 2", "0x1F"};
+  std::string script;
+  uint32_t state = 12345;
+  for (size_t i = 0; i < lines; ++i) {
+    state = state * 1664525u + 1013904223u;
+    if ((state >> 24) % 8 == 0) {
+      script += kOdd[(state >> 8) % std::size(kOdd)];
+    } else {
+      script += std::to_string((state >> 8) % 121);
+    }
+    script += '\n';
+  }
+  return script;
+}
+
+struct Timed {
+  double seconds = 0;
+  size_t accepted = 0;
+};
+
+template <typename Run>
+Timed timeBest(Run&& run, int repetitions = 3) {
+  Timed best;
+  for (int r = 0; r < repetitions; ++r) {
+    const auto start = csc450::bench::Clock::now();
+    const size_t accepted = run();
+    const double seconds = csc450::bench::secondsSince(start);
+    if (r == 0 || seconds < best.seconds) {
+      best = Timed{seconds, accepted};
+    }
+  }
+  return best;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    size_t lines = 2000000;
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--lines" && i + 1 < argc) {
+        lines = std::strtoull(argv[++i], nullptr, 10);
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--lines N]\n";
+        return EXIT_FAILURE;
+      }
+    }
+    const std::string script = makeScript(lines);
+
+    const Timed extract = timeBest([&] {
+      std::istringstream in(script);
+      size_t accepted = 0;
+      while (in.peek() != std::char_traits<char>::eof()) {
+        int age;
+        if (in >> age) {
+          accepted += age >= 0 && age <= 200 ? 1 : 0;
+        } else {
+          in.clear();
+        }
+        in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+      }
+      return accepted;
+    });
+
+    const Timed stoi = timeBest([&] {
+      std::istringstream in(script);
+      std::string line;
+      size_t accepted = 0;
+      while (std::getline(in, line)) {
+        try {
+          const int age = std::stoi(line);
+          accepted += age >= 0 && age <= 200 ? 1 : 0;
+        } catch (const std::logic_error&) {  // invalid_argument, out_of_range
+        }
+      }
+      return accepted;
+    });
+
+    const Timed strtol = timeBest([&] {
+      size_t accepted = 0;
+      const char* pos = script.c_str();
+      while (*pos != '\0') {
+        const char* line_end = std::strchr(pos, '\n');
+        char* end = nullptr;
+        errno = 0;
+        const long value = std::strtol(pos, &end, 10);
+        while (end < line_end && (*end == ' ' || *end == '\t')) {
+          ++end;
+        }
+        accepted += end != pos && end == line_end && errno == 0 && value >= 0 && value <= 200 ? 1 : 0;
+        pos = line_end + 1;
+      }
+      return accepted;
+    });
+
+    csc450::parse::BulkStats stats;
+    const Timed bounded = timeBest([&] {
+      int sum = 0;
+      stats = csc450::parse::eachLine<0, 200>(script, [&](const csc450::parse::Parsed<int>& age, size_t) { sum += age.value; });
+      csc450::bench::doNotOptimize(sum);
+      return stats.valid;
+    });
+
+    const auto row = [&](csc450::bench::JsonWriter& json, const char* method, const Timed& timed) {
+      json.beginObject();
+      json.field("method", method);
+      json.field("lines_per_sec", static_cast<double>(lines) / timed.seconds);
+      json.field("mb_per_sec", static_cast<double>(script.size()) / timed.seconds / 1e6);
+      json.field("accepted", timed.accepted);
+      json.endObject();
+    };
+
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "validated_parse");
+    json.field("lines", lines);
+    json.field("script_bytes", script.size());
+    json.key("results").beginArray();
+    row(json, "istream_extract", extract);
+    row(json, "stoi", stoi);
+    row(json, "strtol", strtol);
+    row(json, "bounded", bounded);
+    json.endArray();
+    json.key("bounded_errors").beginObject();
+    for (size_t e = 0; e < csc450::parse::kErrorKinds; ++e) {
+      json.field(csc450::parse::describe(static_cast<csc450::parse::Error>(e)), stats.by_error[e]);
+    }
+    json.endObject();
+    json.endObject();
+    std::cout << '\n';
+    return EXIT_SUCCESS;
+
+  } catch (const std::exception& e) {
+    std::cerr << "parse_bench failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,163 @@
+/**
+ * Validated integer parsing with compile-time range constraints
+ *
+ * run_vulnerability_tests() and demonstrate_input_validation_issues() read
+ * numbers with std::cin >> int: locale-aware stream extraction, "25abc"
+ * accepted as 25, range checks written by hand afterwards, and clear() /
+ * ignore() to recover. Here the accepted range is part of the type:
+ *
+ *     auto age = csc450::parse::bounded<0, 200>(line);   // Parsed<int>
+ *     if (!age) { report(csc450::parse::describe(age.error)); }
+ *
+ * A field is accepted only if, after trimming ASCII blanks, it is an
+ * optional sign followed by decimal digits that std::from_chars consumes
+ * completely and whose value lies in [Min, Max] (INT31-C, ERR62-CPP).
+ * No locale, no allocation, no exceptions.
+ *
+ * eachLine() is the bulk mode for scripted input: it parses every line of
+ * a buffer and passes each result to a callback.
+ */
+
+#ifndef CSC450_MODULE4_PERF_PARSE_NUMBER_H_
+#define CSC450_MODULE4_PERF_PARSE_NUMBER_H_
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace csc450::parse {
+
+enum class Error : uint8_t { kNone, kEmpty, kNotANumber, kTrailingCharacters, kOutOfRange, kBelowMinimum, kAboveMaximum };
+
+inline constexpr size_t kErrorKinds = 7;
+
+inline const char* describe(Error error) noexcept {
+  switch (error) {
+    case Error::kNone:
+      return "ok";
+    case Error::kEmpty:
+      return "no input";
+    case Error::kNotANumber:
+      return "not a number";
+    case Error::kTrailingCharacters:
+      return "unexpected characters after the number";
+    case Error::kOutOfRange:
+      return "number does not fit the type";
+    case Error::kBelowMinimum:
+      return "number below the allowed minimum";
+    case Error::kAboveMaximum:
+      return "number above the allowed maximum";
+  }
+  return "unknown error";
+}
+
+template <typename T>
+struct Parsed {
+  T value{};
+  Error error = Error::kEmpty;
+
+  explicit operator bool() const noexcept {
+    return error == Error::kNone;
+  }
+};
+
+namespace detail {
+
+constexpr bool isBlank(char c) noexcept {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+constexpr std::string_view trim(std::string_view text) noexcept {
+  size_t begin = 0;
+  size_t end = text.size();
+  while (begin < end && isBlank(text[begin])) {
+    ++begin;
+  }
+  while (end > begin && isBlank(text[end - 1])) {
+    --end;
+  }
+  return text.substr(begin, end - begin);
+}
+
+}  // namespace detail
+
+/**
+ * Parses text as a T in [Min, Max]; T defaults to the type of Min
+ */
+template <auto Min, auto Max, typename T = decltype(Min)>
+Parsed<T> bounded(std::string_view text) noexcept {
+  static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "bounded<> parses integers");
+  static_assert(Min <= Max, "empty range");
+  Parsed<T> result;
+  text = detail::trim(text);
+  if (text.empty()) {
+    return result;
+  }
+  // from_chars takes '-' but not '+'; accept the explicit sign people type
+  if (text.size() > 1 && text[0] == '+' && text[1] != '-') {
+    text.remove_prefix(1);
+  }
+  const char* end = text.data() + text.size();
+  const auto [ptr, ec] = std::from_chars(text.data(), end, result.value, 10);
+  if (ec == std::errc::invalid_argument) {
+    result.error = Error::kNotANumber;
+  } else if (ec == std::errc::result_out_of_range) {
+    result.error = Error::kOutOfRange;
+  } else if (ptr != end) {
+    result.error = Error::kTrailingCharacters;
+  } else if (result.value < static_cast<T>(Min)) {
+    result.error = Error::kBelowMinimum;
+  } else if (result.value > static_cast<T>(Max)) {
+    result.error = Error::kAboveMaximum;
+  } else {
+    result.error = Error::kNone;
+  }
+  return result;
+}
+
+/**
+ * Common constraints from the demos
+ */
+inline Parsed<int> age(std::string_view text) noexcept {
+  return bounded<0, 200>(text);
+}
+
+inline Parsed<int> menuChoice(std::string_view text) noexcept {
+  return bounded<0, 5>(text);
+}
+
+struct BulkStats {
+  size_t lines = 0;
+  size_t valid = 0;
+  size_t by_error[kErrorKinds] = {};
+};
+
+/**
+ * Bulk mode: parses every '\n'-terminated line of input (a final line
+ * without a newline counts too) and calls on_result(Parsed<T>, index)
+ */
+template <auto Min, auto Max, typename T = decltype(Min), typename Callback>
+BulkStats eachLine(std::string_view input, Callback&& on_result) {
+  BulkStats stats;
+  const char* pos = input.data();
+  const char* const end = pos + input.size();
+  while (pos < end) {
+    const void* hit = std::memchr(pos, '\n', static_cast<size_t>(end - pos));
+    const char* line_end = hit != nullptr ? static_cast<const char*>(hit) : end;
+    const Parsed<T> parsed = bounded<Min, Max, T>(std::string_view(pos, static_cast<size_t>(line_end - pos)));
+    ++stats.by_error[static_cast<size_t>(parsed.error)];
+    stats.valid += parsed ? 1 : 0;
+    on_result(parsed, stats.lines);
+    ++stats.lines;
+    pos = line_end + 1;
+  }
+  return stats;
+}
+
+}  // namespace csc450::parse
+
+#endif  // CSC450_MODULE4_PERF_PARSE_NUMBER_H_
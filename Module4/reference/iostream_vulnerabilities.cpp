@@ -57,29 +57,35 @@ void demonstrate_precision_vulnerabilities() {
 }
 
 // Vulnerability 4: Input Validation Issues
-void demonstrate_input_validation_issues() {
-  std::cout << "\n=== VULNERABILITY 4: Input Validation ===\n";
+// Takes its streams as parameters so it can also be driven without a
+// terminal (see ../../Module2/perf/fuzz_input_validation.cpp)
+void demonstrate_input_validation_issues(std::istream &in, std::ostream &out) {
+  out << "\n=== VULNERABILITY 4: Input Validation ===\n";
 
   int age;
-  std::cout << "Enter your age: ";
+  out << "Enter your age: ";
 
   // VULNERABLE: No validation of input type or range
-  if (std::cin >> age) {
-    std::cout << "Age entered: " << age << "\n";
+  if (in >> age) {
+    out << "Age entered: " << age << "\n";
 
     // This could be problematic with negative or extremely large values
     if (age < 0) {
-      std::cout << "🚨 Negative age detected!\n";
+      out << "🚨 Negative age detected!\n";
     } else if (age > 200) {
-      std::cout << "🚨 Unrealistic age detected!\n";
+      out << "🚨 Unrealistic age detected!\n";
     }
   } else {
-    std::cout << "🚨 Invalid input - not a number!\n";
-    std::cin.clear();
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    out << "🚨 Invalid input - not a number!\n";
+    in.clear();
+    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
   }
 }
 
+void demonstrate_input_validation_issues() {
+  demonstrate_input_validation_issues(std::cin, std::cout);
+}
+
 // SECURE ALTERNATIVE: Safe input handling
 void demonstrate_secure_practices() {
   std::cout << "\n=== SECURE ALTERNATIVES ===\n";
@@ -166,7 +172,9 @@ void run_vulnerability_tests() {
   } while (choice != 0);
 }
 
+#ifndef CSC450_FUZZING // fuzz builds supply their own entry point
 int main() {
   run_vulnerability_tests();
   return 0;
 }
+#endif // CSC450_FUZZING
@@ -0,0 +1,229 @@
+/**
+ * Shared micro-benchmark helpers for the module performance tools
+ *
+ * Kept deliberately small: an optimisation barrier, an adaptive timing loop
+ * that reports nanoseconds per operation, and a streaming JSON writer so
+ * every benchmark emits results in the same machine-readable shape.
+ */
+
+#ifndef CSC450_PERF_COMMON_BENCH_UTIL_H_
+#define CSC450_PERF_COMMON_BENCH_UTIL_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace csc450::bench {
+
+/**
+ * Prevents the compiler from discarding a computed value
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+/**
+ * Forces pending memory writes to be treated as observable
+ */
+inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : : "memory");
+#endif
+}
+
+using Clock = std::chrono::steady_clock;
+
+inline double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * Runs op() in growing batches until one batch lasts at least min_seconds,
+ * then repeats that batch `repetitions` times and returns the best ns/op.
+ * Taking the minimum filters out scheduler noise on a shared machine.
+ */
+template <typename Op>
+double nsPerOp(Op&& op, double min_seconds = 0.05, int repetitions = 3) {
+  uint64_t batch = 1;
+  for (;;) {
+    const auto start = Clock::now();
+    for (uint64_t i = 0; i < batch; ++i) {
+      op();
+    }
+    const double elapsed = secondsSince(start);
+    if (elapsed >= min_seconds || batch >= (uint64_t{1} << 40)) {
+      break;
+    }
+    // Aim straight for the target with some headroom instead of doubling
+    const double scale = elapsed > 0 ? (min_seconds * 1.2) / elapsed : 10.0;
+    batch = static_cast<uint64_t>(static_cast<double>(batch) * std::clamp(scale, 2.0, 100.0));
+  }
+
+  double best = 0;
+  for (int r = 0; r < repetitions; ++r) {
+    const auto start = Clock::now();
+    for (uint64_t i = 0; i < batch; ++i) {
+      op();
+    }
+    const double ns = secondsSince(start) * 1e9 / static_cast<double>(batch);
+    best = (r == 0) ? ns : std::min(best, ns);
+  }
+  return best;
+}
+
+/**
+ * Minimal streaming JSON writer
+ * Handles comma placement and string escaping; nesting is the caller's job.
+ */
+class JsonWriter {
+ public:
+  explicit JsonWriter(std::ostream& out) : out_(out) {}
+
+  JsonWriter& beginObject() {
+    separator();
+    out_ << '{';
+    first_.push_back(true);
+    return *this;
+  }
+
+  JsonWriter& endObject() {
+    first_.pop_back();
+    out_ << '}';
+    return *this;
+  }
+
+  JsonWriter& beginArray() {
+    separator();
+    out_ << '[';
+    first_.push_back(true);
+    return *this;
+  }
+
+  JsonWriter& endArray() {
+    first_.pop_back();
+    out_ << ']';
+    return *this;
+  }
+
+  JsonWriter& key(std::string_view name) {
+    separator();
+    writeString(name);
+    out_ << ':';
+    after_key_ = true;
+    return *this;
+  }
+
+  JsonWriter& value(std::string_view text) {
+    separator();
+    writeString(text);
+    return *this;
+  }
+
+  JsonWriter& value(const char* text) {
+    return value(std::string_view(text));
+  }
+
+  JsonWriter& value(bool flag) {
+    separator();
+    out_ << (flag ? "true" : "false");
+    return *this;
+  }
+
+  // JSON has no nan/inf, so non-finite numbers (a ratio over a section that
+  // timed as zero) are written as null
+  JsonWriter& value(double number) {
+    separator();
+    if (!std::isfinite(number)) {
+      out_ << "null";
+      return *this;
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.4g", number);
+    out_ << buffer;
+    return *this;
+  }
+
+  template <typename Int, typename = std::enable_if_t<std::is_integral_v<Int> && !std::is_same_v<Int, bool>>>
+  JsonWriter& value(Int number) {
+    separator();
+    out_ << +number;
+    return *this;
+  }
+
+  JsonWriter& null() {
+    separator();
+    out_ << "null";
+    return *this;
+  }
+
+  template <typename T>
+  JsonWriter& field(std::string_view name, const T& v) {
+    key(name);
+    return value(v);
+  }
+
+ private:
+  void separator() {
+    if (after_key_) {
+      after_key_ = false;
+      return;
+    }
+    if (!first_.empty()) {
+      if (!first_.back()) {
+        out_ << ',';
+      }
+      first_.back() = false;
+    }
+  }
+
+  void writeString(std::string_view text) {
+    out_ << '"';
+    for (const char c : text) {
+      switch (c) {
+        case '"':
+          out_ << "\\\"";
+          break;
+        case '\\':
+          out_ << "\\\\";
+          break;
+        case '\n':
+          out_ << "\\n";
+          break;
+        case '\t':
+          out_ << "\\t";
+          break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            out_ << escaped;
+          } else {
+            out_ << c;
+          }
+      }
+    }
+    out_ << '"';
+  }
+
+  std::ostream& out_;
+  std::vector<bool> first_;
+  bool after_key_ = false;
+};
+
+}  // namespace csc450::bench
+
+#endif  // CSC450_PERF_COMMON_BENCH_UTIL_H_
@@ -0,0 +1,158 @@
+/**
+ * POSIX descriptor helpers shared by the module performance tools
+ *
+ * Fd owns one file descriptor and closes it exactly once, so a tool that
+ * throws between open() and the end of its work does not leak it (FIO42-C:
+ * close files when they are no longer needed).
+ *
+ * writeAll() is the one write loop every tool uses: interrupted writes are
+ * retried and short writes resumed. It is noexcept and reports failure by
+ * returning false with errno set (ERR33-C: detect and handle standard
+ * library errors), so the lean start-up programs, built without
+ * exceptions, can use it too. Code that reports errors by exception calls
+ * writeAllOrThrow() instead; it and readFile() are only declared when
+ * exceptions are enabled.
+ */
+
+#ifndef CSC450_PERF_COMMON_POSIX_IO_H_
+#define CSC450_PERF_COMMON_POSIX_IO_H_
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace csc450::io {
+
+/**
+ * Owns a file descriptor; closes it once
+ */
+class Fd {
+ public:
+  Fd() = default;
+  explicit Fd(int fd) noexcept : fd_(fd) {}
+  ~Fd() {
+    reset();
+  }
+  Fd(const Fd&) = delete;
+  Fd& operator=(const Fd&) = delete;
+  Fd(Fd&& other) noexcept : fd_(other.release()) {}
+  Fd& operator=(Fd&& other) noexcept {
+    if (this != &other) {
+      reset(other.release());
+    }
+    return *this;
+  }
+
+  void reset(int fd = -1) noexcept {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+    fd_ = fd;
+  }
+
+  // Gives up ownership without closing
+  [[nodiscard]] int release() noexcept {
+    const int fd = fd_;
+    fd_ = -1;
+    return fd;
+  }
+
+  [[nodiscard]] int get() const noexcept {
+    return fd_;
+  }
+
+ private:
+  int fd_ = -1;
+};
+
+/**
+ * Writes every byte to fd; false (errno set) on the first failed write
+ */
+inline bool writeAll(int fd, const void* data, size_t size) noexcept {
+  const char* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    const ssize_t written = ::write(fd, bytes, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    bytes += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+inline bool writeAll(int fd, std::string_view text) noexcept {
+  return writeAll(fd, text.data(), text.size());
+}
+
+#if defined(__cpp_exceptions)
+
+/**
+ * writeAll, throwing std::system_error (with `what`) on failure
+ */
+inline void writeAllOrThrow(int fd, const void* data, size_t size, const char* what = "write") {
+  if (!writeAll(fd, data, size)) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+}
+
+inline void writeAllOrThrow(int fd, std::string_view text, const char* what = "write") {
+  writeAllOrThrow(fd, text.data(), text.size(), what);
+}
+
+/**
+ * Everything from fd's current position to end of input (pipes included)
+ */
+inline std::string readFile(int fd) {
+  // Sized from fstat for regular files (one read to confirm the end),
+  // doubled as needed for pipes or files that grow meanwhile
+  struct stat info{};
+  const bool regular = ::fstat(fd, &info) == 0 && S_ISREG(info.st_mode);
+  const off_t position = regular ? ::lseek(fd, 0, SEEK_CUR) : -1;
+  std::string text(position >= 0 && info.st_size > position ? static_cast<size_t>(info.st_size - position) + 1 : 64 * 1024, '\0');
+  size_t used = 0;
+  for (;;) {
+    if (used == text.size()) {
+      text.resize(text.size() * 2);
+    }
+    const ssize_t got = ::read(fd, text.data() + used, text.size() - used);
+    if (got < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "read");
+    }
+    if (got == 0) {
+      break;
+    }
+    used += static_cast<size_t>(got);
+  }
+  text.resize(used);
+  return text;
+}
+
+/**
+ * The whole file at path
+ */
+inline std::string readFile(const std::string& path) {
+  const Fd fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+  if (fd.get() < 0) {
+    throw std::system_error(errno, std::generic_category(), "open " + path);
+  }
+  return readFile(fd.get());
+}
+
+#endif  // __cpp_exceptions
+
+}  // namespace csc450::io
+
+#endif  // CSC450_PERF_COMMON_POSIX_IO_H_
@@ -0,0 +1,490 @@
+/**
+ * Scripted-input replay driver for the interactive course programs
+ *
+ * Nearly every program in the repository blocks on std::cin, so timing one
+ * by hand measures the person typing. This driver starts a program, feeds
+ * it a recorded input script at full speed through a pipe or a
+ * pseudo-terminal, captures everything it writes to stdout and stderr, and
+ * repeats that --runs times. For each program it reports end-to-end
+ * latency percentiles (fork to exit), time to first output, runs/sec,
+ * output throughput, and how many distinct outputs it saw. A deterministic
+ * program gives one distinct output; a program that prints addresses gives
+ * one per run.
+ *
+ *   pipe  stdin is a pipe and stdout/stderr share a second pipe, so the
+ *         program sees a non-interactive stream and fully buffers stdout
+ *   pty   the program gets a pseudo-terminal as its controlling terminal,
+ *         as in an interactive session: canonical line input, line-buffered
+ *         stdout. Echo and output newline translation are switched off so
+ *         transcripts match pipe mode. End of input is sent as VEOF
+ *         (Ctrl-D). Lines longer than the terminal's 4 KiB canonical
+ *         buffer are cut there
+ *
+ * Input and output are multiplexed with poll(), so a program that writes
+ * while input is still being fed cannot deadlock the driver. A run that
+ * outlives --timeout is killed and counted. Programs that change files
+ * (FileProcessor appends to its data file) can be given a reset directory
+ * whose files are copied into the working directory before every run,
+ * outside the timed region.
+ *
+ * Usage:
+ *   replay --manifest FILE [options]
+ *   replay --script FILE [--cwd DIR] [--reset DIR] [--expect FILE] [options] -- PROGRAM [ARGS...]
+ * Options: --runs N (default 1000), --mode pipe|pty, --timeout SECONDS,
+ *          --only NAME (manifest entry), --transcripts DIR (writes the first
+ *          run's output to DIR/<name>.out)
+ *
+ * Manifest lines are tab-separated: name, script, working directory ("-"
+ * for the current one), reset directory ("-" for none), program, arguments. Blank lines and lines starting
+ * with '#' are ignored. The build generates one covering every interactive
+ * program (see CMakeLists.txt).
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "bench_util.h"
+#include "posix_io.h"
+
+namespace {
+
+enum class Mode { kPipe, kPty };
+
+struct Program {
+  std::string name;
+  std::string script_path;
+  std::string cwd;    // empty: inherit
+  std::string reset;  // empty: nothing restored between runs
+  std::vector<std::string> argv;
+  std::string expect_path;  // empty: no comparison
+};
+
+struct RunResult {
+  double seconds = 0;
+  double first_output_seconds = -1;  // -1 if nothing was written
+  int status = 0;                    // waitpid status
+  bool timed_out = false;
+  size_t output_bytes = 0;
+  uint64_t output_hash = 0;
+};
+
+[[noreturn]] void fail(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+
+uint64_t fnv1a(uint64_t hash, const char* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+  }
+  return hash;
+}
+
+void setNonBlocking(int fd) {
+  const int flags = ::fcntl(fd, F_GETFL);
+  if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+    fail("fcntl");
+  }
+}
+
+using csc450::io::Fd;
+using csc450::io::readFile;
+
+/**
+ * The parent's ends of the child's standard streams. In pty mode input and
+ * output are the same master descriptor.
+ */
+struct Channel {
+  Fd input;   // parent writes the script here (unused in pty mode)
+  Fd output;  // parent reads the transcript here
+  Fd child_in;
+  Fd child_out;
+};
+
+void openPipes(Channel& channel) {
+  int in_fds[2];
+  int out_fds[2];
+  if (::pipe2(in_fds, O_CLOEXEC) != 0) {
+    fail("pipe2");
+  }
+  channel.child_in.reset(in_fds[0]);
+  channel.input.reset(in_fds[1]);
+  if (::pipe2(out_fds, O_CLOEXEC) != 0) {
+    fail("pipe2");
+  }
+  channel.output.reset(out_fds[0]);
+  channel.child_out.reset(out_fds[1]);
+  setNonBlocking(channel.input.get());
+  setNonBlocking(channel.output.get());
+}
+
+void openPty(Channel& channel) {
+  channel.output.reset(::posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC));
+  if (channel.output.get() < 0 || ::grantpt(channel.output.get()) != 0 || ::unlockpt(channel.output.get()) != 0) {
+    fail("posix_openpt");
+  }
+  char path[128];
+  if (::ptsname_r(channel.output.get(), path, sizeof(path)) != 0) {
+    fail("ptsname_r");
+  }
+  channel.child_in.reset(::open(path, O_RDWR | O_NOCTTY | O_CLOEXEC));
+  if (channel.child_in.get() < 0) {
+    fail("open pty slave");
+  }
+  termios attrs{};
+  if (::tcgetattr(channel.child_in.get(), &attrs) != 0) {
+    fail("tcgetattr");
+  }
+  attrs.c_lflag &= ~static_cast<tcflag_t>(ECHO | ECHOE | ECHOK | ECHONL);
+  attrs.c_oflag &= ~static_cast<tcflag_t>(ONLCR);
+  if (::tcsetattr(channel.child_in.get(), TCSANOW, &attrs) != 0) {
+    fail("tcsetattr");
+  }
+  setNonBlocking(channel.output.get());
+}
+
+/**
+ * Child side of fork(): only async-signal-safe calls until exec
+ */
+[[noreturn]] void execChild(const Channel& channel, Mode mode, const char* cwd, char* const* argv) {
+  const int in = channel.child_in.get();
+  const int out = mode == Mode::kPty ? in : channel.child_out.get();
+  if (mode == Mode::kPty) {
+    ::setsid();
+    ::ioctl(in, TIOCSCTTY, 0);
+  }
+  if (::dup2(in, STDIN_FILENO) < 0 || ::dup2(out, STDOUT_FILENO) < 0 || ::dup2(out, STDERR_FILENO) < 0) {
+    ::_exit(126);
+  }
+  ::signal(SIGPIPE, SIG_DFL);  // the driver ignores it; exec would inherit that
+  if (cwd != nullptr && ::chdir(cwd) != 0) {
+    ::_exit(126);
+  }
+  ::execvp(argv[0], argv);
+  ::_exit(127);
+}
+
+/**
+ * Runs the program once with the script as its input
+ */
+RunResult runOnce(const Program& program, const std::vector<char*>& argv, const std::string& input, Mode mode, double timeout, std::string* transcript) {
+  RunResult result;
+  result.output_hash = kFnvOffset;
+  Channel channel;
+  if (mode == Mode::kPty) {
+    openPty(channel);
+  } else {
+    openPipes(channel);
+  }
+
+  const auto start = csc450::bench::Clock::now();
+  const pid_t pid = ::fork();
+  if (pid < 0) {
+    fail("fork");
+  }
+  if (pid == 0) {
+    execChild(channel, mode, program.cwd.empty() ? nullptr : program.cwd.c_str(), argv.data());
+  }
+  channel.child_in.reset();
+  channel.child_out.reset();
+  if (mode == Mode::kPipe && input.empty()) {
+    channel.input.reset();
+  }
+
+  const int write_fd = mode == Mode::kPty ? channel.output.get() : channel.input.get();
+  size_t written = 0;
+  bool input_open = true;
+  char buffer[64 * 1024];
+  for (;;) {
+    const double remaining = timeout - csc450::bench::secondsSince(start);
+    if (remaining <= 0) {
+      ::kill(pid, SIGKILL);
+      result.timed_out = true;
+      break;
+    }
+    const bool want_write = input_open && written < input.size();
+    pollfd fds[2] = {{channel.output.get(), POLLIN, 0}, {write_fd, POLLOUT, 0}};
+    nfds_t count = 1;
+    if (want_write && write_fd == channel.output.get()) {
+      fds[0].events |= POLLOUT;
+    } else if (want_write) {
+      count = 2;
+    }
+    const int ready = ::poll(fds, count, static_cast<int>(remaining * 1000) + 1);
+    if (ready < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fail("poll");
+    }
+
+    bool done = false;
+    if ((fds[0].revents & (POLLIN | POLLHUP | POLLERR)) != 0) {
+      const ssize_t got = ::read(channel.output.get(), buffer, sizeof(buffer));
+      if (got > 0) {
+        if (result.first_output_seconds < 0) {
+          result.first_output_seconds = csc450::bench::secondsSince(start);
+        }
+        result.output_bytes += static_cast<size_t>(got);
+        result.output_hash = fnv1a(result.output_hash, buffer, static_cast<size_t>(got));
+        if (transcript != nullptr) {
+          transcript->append(buffer, static_cast<size_t>(got));
+        }
+      } else if (got == 0 || errno == EIO) {  // pipe EOF, or pty slave closed
+        done = true;
+      } else if (errno != EAGAIN && errno != EINTR) {
+        fail("read");
+      }
+    }
+    const short write_events = count == 2 ? fds[1].revents : fds[0].revents;
+    if (want_write && (write_events & (POLLOUT | POLLERR)) != 0) {
+      const ssize_t put = ::write(write_fd, input.data() + written, input.size() - written);
+      if (put > 0) {
+        written += static_cast<size_t>(put);
+      } else if (put < 0 && errno != EAGAIN && errno != EINTR) {
+        input_open = false;  // EPIPE / EIO: the program stopped reading
+      }
+      if (mode == Mode::kPipe && (written == input.size() || !input_open)) {
+        channel.input.reset();  // end of input
+        input_open = false;
+      }
+    }
+    if (done) {
+      break;
+    }
+  }
+
+  while (::waitpid(pid, &result.status, 0) < 0) {
+    if (errno != EINTR) {
+      fail("waitpid");
+    }
+  }
+  result.seconds = csc450::bench::secondsSince(start);
+  return result;
+}
+
+double percentile(std::vector<double> values, double p) {
+  if (values.empty()) {
+    return 0;
+  }
+  const auto rank = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+  std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(rank), values.end());
+  return values[rank];
+}
+
+void replay(const Program& program, Mode mode, int runs, double timeout, const std::string& transcripts, csc450::bench::JsonWriter& json) {
+  std::string input = readFile(program.script_path);
+  if (mode == Mode::kPty) {
+    // A partial last line needs one VEOF to be delivered, then one more for EOF
+    if (!input.empty() && input.back() != '\n') {
+      input += '\x04';
+    }
+    input += '\x04';
+  }
+  std::vector<char*> argv;
+  for (const auto& arg : program.argv) {
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  }
+  argv.push_back(nullptr);
+
+  std::vector<double> latency_ms;
+  std::vector<double> first_output_ms;
+  std::vector<uint64_t> hashes;
+  std::string transcript;
+  size_t output_bytes = 0;
+  int failures = 0;
+  int timeouts = 0;
+  const auto start = csc450::bench::Clock::now();
+  double reset_seconds = 0;
+  for (int run = 0; run < runs; ++run) {
+    if (!program.reset.empty()) {
+      const auto reset_start = csc450::bench::Clock::now();
+      std::filesystem::copy(program.reset, program.cwd.empty() ? "." : program.cwd, std::filesystem::copy_options::overwrite_existing | std::filesystem::copy_options::recursive);
+      reset_seconds += csc450::bench::secondsSince(reset_start);
+    }
+    const RunResult result = runOnce(program, argv, input, mode, timeout, run == 0 ? &transcript : nullptr);
+    latency_ms.push_back(result.seconds * 1e3);
+    if (result.first_output_seconds >= 0) {
+      first_output_ms.push_back(result.first_output_seconds * 1e3);
+    }
+    output_bytes += result.output_bytes;
+    hashes.push_back(result.output_hash);
+    timeouts += result.timed_out ? 1 : 0;
+    failures += !result.timed_out && !(WIFEXITED(result.status) && WEXITSTATUS(result.status) == 0) ? 1 : 0;
+  }
+  const double seconds = csc450::bench::secondsSince(start) - reset_seconds;
+  std::sort(hashes.begin(), hashes.end());
+  const auto distinct = static_cast<size_t>(std::unique(hashes.begin(), hashes.end()) - hashes.begin());
+
+  if (!transcripts.empty()) {
+    std::ofstream out(transcripts + "/" + program.name + ".out", std::ios::binary);
+    out.write(transcript.data(), static_cast<std::streamsize>(transcript.size()));
+    if (!out) {
+      throw std::runtime_error("cannot write transcript for " + program.name);
+    }
+  }
+
+  json.beginObject();
+  json.field("name", program.name);
+  json.field("runs", runs);
+  json.field("failures", failures);
+  json.field("timeouts", timeouts);
+  json.field("distinct_outputs", distinct);
+  json.key("matches_expected");
+  if (program.expect_path.empty()) {
+    json.null();
+  } else {
+    json.value(transcript == readFile(program.expect_path));
+  }
+  json.field("input_bytes", input.size());
+  json.field("output_bytes_per_run", output_bytes / static_cast<size_t>(std::max(runs, 1)));
+  json.key("latency_ms").beginObject();
+  json.field("p50", percentile(latency_ms, 0.50));
+  json.field("p90", percentile(latency_ms, 0.90));
+  json.field("p99", percentile(latency_ms, 0.99));
+  json.field("max", latency_ms.empty() ? 0.0 : *std::max_element(latency_ms.begin(), latency_ms.end()));
+  json.endObject();
+  json.field("first_output_ms_p50", percentile(first_output_ms, 0.50));
+  json.field("runs_per_sec", static_cast<double>(runs) / seconds);
+  json.field("output_mb_per_sec", static_cast<double>(output_bytes) / seconds / 1e6);
+  json.endObject();
+}
+
+std::vector<Program> readManifest(const std::string& path) {
+  std::istringstream lines(readFile(path));
+  std::vector<Program> programs;
+  std::string line;
+  while (std::getline(lines, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::vector<std::string> columns;
+    std::istringstream fields(line);
+    for (std::string field; std::getline(fields, field, '\t');) {
+      columns.push_back(field);
+    }
+    if (columns.size() < 5) {
+      throw std::runtime_error("malformed manifest line: " + line);
+    }
+    Program program;
+    program.name = columns[0];
+    program.script_path = columns[1];
+    program.cwd = columns[2] == "-" ? std::string() : columns[2];
+    program.reset = columns[3] == "-" ? std::string() : columns[3];
+    program.argv.assign(columns.begin() + 4, columns.end());
+    programs.push_back(std::move(program));
+  }
+  return programs;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    int runs = 1000;
+    double timeout = 5.0;
+    Mode mode = Mode::kPipe;
+    std::string manifest;
+    std::string only;
+    std::string transcripts;
+    Program single;
+    bool usage_error = false;
+    int i = 1;
+    for (; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (arg == "--") {
+        ++i;
+        break;
+      }
+      if (i + 1 >= argc) {
+        usage_error = true;
+        break;
+      }
+      const std::string value = argv[++i];
+      if (arg == "--runs") {
+        runs = std::max(1, std::atoi(value.c_str()));
+      } else if (arg == "--timeout") {
+        timeout = std::strtod(value.c_str(), nullptr);
+      } else if (arg == "--mode" && (value == "pipe" || value == "pty")) {
+        mode = value == "pty" ? Mode::kPty : Mode::kPipe;
+      } else if (arg == "--manifest") {
+        manifest = value;
+      } else if (arg == "--only") {
+        only = value;
+      } else if (arg == "--transcripts") {
+        transcripts = value;
+      } else if (arg == "--script") {
+        single.script_path = value;
+      } else if (arg == "--cwd") {
+        single.cwd = value;
+      } else if (arg == "--reset") {
+        single.reset = value;
+      } else if (arg == "--expect") {
+        single.expect_path = value;
+      } else {
+        usage_error = true;
+        break;
+      }
+    }
+    std::vector<Program> programs;
+    if (!usage_error && !manifest.empty() && i >= argc) {
+      programs = readManifest(manifest);
+      if (!only.empty()) {
+        programs.erase(std::remove_if(programs.begin(), programs.end(), [&](const Program& p) { return p.name != only; }), programs.end());
+      }
+    } else if (!usage_error && manifest.empty() && !single.script_path.empty() && i < argc) {
+      single.argv.assign(argv + i, argv + argc);
+      const size_t slash = single.argv[0].find_last_of('/');
+      single.name = slash == std::string::npos ? single.argv[0] : single.argv[0].substr(slash + 1);
+      programs.push_back(std::move(single));
+    } else {
+      usage_error = true;
+    }
+    if (usage_error || programs.empty()) {
+      std::cerr << "Usage: " << argv[0] << " --manifest FILE [--only NAME] [options]\n"
+                << "       " << argv[0] << " --script FILE [--cwd DIR] [--reset DIR] [--expect FILE] [options] -- PROGRAM [ARGS...]\n"
+                << "Options: --runs N  --mode pipe|pty  --timeout SECONDS  --transcripts DIR\n";
+      return EXIT_FAILURE;
+    }
+
+    ::signal(SIGPIPE, SIG_IGN);  // a program that exits early must not kill the driver
+    csc450::bench::JsonWriter json(std::cout);
+    json.beginObject();
+    json.field("benchmark", "scripted_replay");
+    json.field("mode", mode == Mode::kPty ? "pty" : "pipe");
+    json.key("programs").beginArray();
+    for (const Program& program : programs) {
+      replay(program, mode, runs, timeout, transcripts, json);
+      std::cout.flush();
+    }
+    json.endArray();
+    json.endObject();
+    std::cout << '\n';
+    return EXIT_SUCCESS;
+
+  } catch (const std::exception& e) {
+    std::cerr << "replay failed: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}